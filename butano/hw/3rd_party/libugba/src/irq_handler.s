@@ -3,6 +3,7 @@
 // Copyright (c) 2020-2022 Antonio Niño Díaz
 
 #include "../../../../include/bn_config_hdma.h"
+#include "../../../../include/bn_config_hbes.h"
 
     .section .iwram, "ax", %progbits
     .code 32
@@ -51,13 +52,18 @@ IRQ_GlobalInterruptHandler:
     tst     r1, r2
     bne     interrupt_found
 
-    # add     r3, r3, #4
-    # mov     r2, #(1 << 2) // VCOUNT
-    # tst     r1, r2
-    # bne     interrupt_found
+    // VCOUNT is only used by sparse H-Blank effects schedules:
+    #if BN_CFG_HBES_MAX_SPARSE_LINES != 0
+        add     r3, r3, #4
+        mov     r2, #(1 << 2) // VCOUNT
+        tst     r1, r2
+        bne     interrupt_found
+
+        sub     r3, r3, #8
+    #else
+        sub     r3, r3, #4
+    #endif
 
-    # sub     r3, r3, #8
-    sub     r3, r3, #4
     mov     r2, #(1 << 0) // VBLANK
     tst     r1, r2
     bne     interrupt_found
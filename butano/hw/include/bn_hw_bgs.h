@@ -12,6 +12,7 @@
 #include "bn_hw_bfn.h"
 #include "bn_hw_dma.h"
 #include "bn_hw_memory.h"
+#include "bn_hw_pipelined_commit.h"
 
 namespace bn::hw::bgs
 {
@@ -163,7 +164,7 @@ namespace bn::hw::bgs
 
     inline void commit(const commit_data& data, bool use_dma)
     {
-        auto destination = reinterpret_cast<void*>(REG_BASE + 0x0008);
+        auto destination = reinterpret_cast<void*>(pipelined_commit::io_registers() + 0x0008);
 
         if(use_dma)
         {
@@ -177,7 +178,13 @@ namespace bn::hw::bgs
 
     inline void stop()
     {
-        REG_BG_AFFINE[2] = affine_attributes();
+        affine_attributes attributes;
+        REG_BG_AFFINE[2] = attributes;
+
+        #if BN_CFG_CORE_PIPELINED_COMMIT
+            // Mirror the write to the shadow registers, so the next staged commit doesn't undo it:
+            reinterpret_cast<BG_AFFINE*>(pipelined_commit::io_registers())[2] = attributes;
+        #endif
     }
 
     [[nodiscard]] inline uint16_t* regular_horizontal_position_register(int id)
@@ -28,14 +28,11 @@ namespace bn::hw::core
         }
     }
 
-    inline void wait_for_vblank(volatile bool& flag)
+    // Waits until the V-Blank interrupt resets the given flag:
+    inline void wait_for_vblank_reset(volatile bool& flag)
     {
         constexpr int unsafe_scanlines = 10;
 
-        BN_BARRIER;
-        flag = true;
-        BN_BARRIER;
-
         while(flag)
         {
             unsigned vcount = REG_VCOUNT;
@@ -62,6 +59,15 @@ namespace bn::hw::core
         }
     }
 
+    inline void wait_for_vblank(volatile bool& flag)
+    {
+        BN_BARRIER;
+        flag = true;
+        BN_BARRIER;
+
+        wait_for_vblank_reset(flag);
+    }
+
     inline void sleep()
     {
         Stop();
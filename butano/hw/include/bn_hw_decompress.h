@@ -9,6 +9,11 @@
 #include "bn_hw_tonc.h"
 #include "../3rd_party/cult-of-gba-bios/include/cult-of-gba-bios.h"
 
+extern "C"
+{
+    BN_CODE_IWRAM void bn_hw_decompress_huff(const void* src, void* dst);
+}
+
 namespace bn::hw::decompress
 {
     inline void lz77(const void* src, void* dst)
@@ -27,9 +32,75 @@ namespace bn::hw::decompress
     }
 
     inline void huff(const void* src, void* dst)
+    {
+        bn_hw_decompress_huff(src, dst);
+    }
+
+    inline void huff_bios(const void* src, void* dst)
     {
         HuffUnComp(src, dst);
     }
+
+    BN_CODE_IWRAM void lz4(const void* src, void* dst);
+
+    BN_CODE_IWRAM void rans(const void* src, void* dst);
+
+    // Software decompressor which can be paused and resumed (GBA BIOS LZ77, run-length and Huffman formats).
+    // Output is written with 16-bit stores, so it can be used with VRAM destinations.
+    class stream
+    {
+
+    public:
+        void init(const void* src, void* dst);
+
+        [[nodiscard]] int decompressed_bytes() const
+        {
+            return _dst_index;
+        }
+
+        [[nodiscard]] int total_bytes() const
+        {
+            return _dst_size;
+        }
+
+        [[nodiscard]] bool done() const
+        {
+            return _dst_index >= _dst_size;
+        }
+
+        // Returns the number of decompressed bytes:
+        int decompress(int max_bytes);
+
+    private:
+        const uint8_t* _src = nullptr;
+        const uint8_t* _huff_tree = nullptr;
+        uint16_t* _dst = nullptr;
+        int _dst_size = 0;
+        int _dst_index = 0;
+        int _run_count = 0;
+        int _run_distance = 0;
+        unsigned _huff_bits = 0;
+        int _huff_bits_count = 0;
+        uint8_t _type = 0;
+        uint8_t _pending_byte = 0;
+        uint8_t _flags = 0;
+        uint8_t _flags_count = 0;
+        uint8_t _run_byte = 0;
+        uint8_t _huff_symbol_bits = 0;
+        uint8_t _huff_nibble = 0;
+        bool _run_copy = false;
+        bool _huff_nibble_pending = false;
+
+        void _write(unsigned value);
+
+        [[nodiscard]] unsigned _read_back(int index) const;
+
+        void _lz77(int limit);
+
+        void _rl(int limit);
+
+        void _huff(int limit);
+    };
 }
 
 #endif
@@ -8,6 +8,7 @@
 
 #include "bn_point.h"
 #include "bn_hw_bgs.h"
+#include "bn_hw_pipelined_commit.h"
 
 #define REG_DISPCNT_U16     *(u16*)(REG_BASE+0x0000)
 #define REG_DISPCNT_U16_2   *(u16*)(REG_BASE+0x0002)
@@ -41,6 +42,11 @@ namespace bn::hw::display
         return 2;
     }
 
+    [[nodiscard]] inline uint16_t& commit_register(int offset)
+    {
+        return *reinterpret_cast<uint16_t*>(pipelined_commit::io_registers() + unsigned(offset));
+    }
+
     inline void set_display(int mode, bool bitmap_page_flipped, bool show_sprites, const bool* enabled_bgs,
                             const bool* enabled_inside_windows, uint16_t& display_cnt)
     {
@@ -77,14 +83,14 @@ namespace bn::hw::display
 
     inline void commit_display(uint16_t display_cnt)
     {
-        REG_DISPCNT_U16 = display_cnt;
+        commit_register(0x0000) = display_cnt;
     }
 
     [[nodiscard]] inline uint16_t* hidden_bitmap_page()
     {
         uint16_t* result = reinterpret_cast<uint16_t*>(MEM_VRAM);
 
-        if(! (REG_DISPCNT_U16 & DCNT_PAGE))
+        if(! (commit_register(0x0000) & DCNT_PAGE))
         {
             result = reinterpret_cast<uint16_t*>(uint32_t(result) ^ VRAM_PAGE_SIZE);
         }
@@ -94,7 +100,7 @@ namespace bn::hw::display
 
     inline void flip_bitmap_page()
     {
-        REG_DISPCNT_U16 ^= DCNT_PAGE;
+        commit_register(0x0000) ^= DCNT_PAGE;
     }
 
     inline void set_mosaic(int sprites_horizontal_stretch, int sprites_vertical_stretch,
@@ -106,7 +112,7 @@ namespace bn::hw::display
 
     inline void commit_mosaic(uint16_t mosaic_cnt)
     {
-        REG_MOSAIC_U16 = mosaic_cnt;
+        commit_register(0x004C) = mosaic_cnt;
     }
 
     [[nodiscard]] inline uint16_t* mosaic_register()
@@ -154,7 +160,7 @@ namespace bn::hw::display
 
     inline void commit_blending_cnt(uint16_t blending_cnt)
     {
-        REG_BLDCNT = blending_cnt;
+        commit_register(0x0050) = blending_cnt;
     }
 
     inline void set_blending_transparency(int top_weight, int bottom_weight, uint16_t& blending_transparency_cnt)
@@ -164,7 +170,7 @@ namespace bn::hw::display
 
     inline void commit_blending_transparency(uint16_t blending_transparency_cnt)
     {
-        REG_BLDALPHA = blending_transparency_cnt;
+        commit_register(0x0052) = blending_transparency_cnt;
     }
 
     [[nodiscard]] inline uint16_t* blending_transparency_register()
@@ -179,7 +185,7 @@ namespace bn::hw::display
 
     inline void set_blending_fade(int fade_alpha)
     {
-        set_blending_fade(fade_alpha, const_cast<uint16_t&>(REG_BLDY));
+        set_blending_fade(fade_alpha, commit_register(0x0054));
     }
 
     [[nodiscard]] inline uint16_t* blending_fade_register()
@@ -189,8 +195,8 @@ namespace bn::hw::display
 
     inline void set_windows_flags(const unsigned* flags_ptr)
     {
-        REG_WININ = uint16_t((flags_ptr[1] << 8) | flags_ptr[0]);
-        REG_WINOUT = uint16_t((flags_ptr[2] << 8) | flags_ptr[3]);
+        commit_register(0x0048) = uint16_t((flags_ptr[1] << 8) | flags_ptr[0]);
+        commit_register(0x004A) = uint16_t((flags_ptr[2] << 8) | flags_ptr[3]);
     }
 
     inline void set_window_boundaries(int first, int second, uint16_t& window_cnt)
@@ -200,10 +206,10 @@ namespace bn::hw::display
 
     inline void set_windows_boundaries(const point* boundaries_ptr)
     {
-        REG_WIN0H = uint16_t((boundaries_ptr[0].x() << 8) + boundaries_ptr[1].x());
-        REG_WIN0V = uint16_t((boundaries_ptr[0].y() << 8) + boundaries_ptr[1].y());
-        REG_WIN1H = uint16_t((boundaries_ptr[2].x() << 8) + boundaries_ptr[3].x());
-        REG_WIN1V = uint16_t((boundaries_ptr[2].y() << 8) + boundaries_ptr[3].y());
+        commit_register(0x0040) = uint16_t((boundaries_ptr[0].x() << 8) + boundaries_ptr[1].x());
+        commit_register(0x0044) = uint16_t((boundaries_ptr[0].y() << 8) + boundaries_ptr[1].y());
+        commit_register(0x0042) = uint16_t((boundaries_ptr[2].x() << 8) + boundaries_ptr[3].x());
+        commit_register(0x0046) = uint16_t((boundaries_ptr[2].y() << 8) + boundaries_ptr[3].y());
     }
 
     [[nodiscard]] inline uint16_t* window_horizontal_boundaries_register(int id)
@@ -230,7 +236,7 @@ namespace bn::hw::display
 
     inline void set_green_swap_enabled(bool enabled)
     {
-        set_green_swap_enabled(enabled, REG_DISPCNT_U16_2);
+        set_green_swap_enabled(enabled, commit_register(0x0002));
     }
 
     [[nodiscard]] inline uint16_t* green_swap_register()
@@ -238,14 +244,24 @@ namespace bn::hw::display
         return &REG_DISPCNT_U16_2;
     }
 
+    // Direct register writes are mirrored to the pipelined commit shadow registers,
+    // so the next staged commit doesn't undo them:
     inline void sleep()
     {
         REG_DISPCNT_U16 |= DCNT_BLANK;
+
+        #if BN_CFG_CORE_PIPELINED_COMMIT
+            commit_register(0x0000) |= DCNT_BLANK;
+        #endif
     }
 
     inline void wake_up()
     {
         REG_DISPCNT_U16 &= unsigned(~DCNT_BLANK);
+
+        #if BN_CFG_CORE_PIPELINED_COMMIT
+            commit_register(0x0000) &= unsigned(~DCNT_BLANK);
+        #endif
     }
 
     inline void stop()
@@ -253,12 +269,22 @@ namespace bn::hw::display
         REG_BLDCNT = 0;
         REG_MOSAIC_U16 = 0;
         REG_DISPCNT_U16_2 = 0;
+
+        #if BN_CFG_CORE_PIPELINED_COMMIT
+            commit_register(0x0050) = 0;
+            commit_register(0x004C) = 0;
+            commit_register(0x0002) = 0;
+        #endif
     }
 
     inline void set_show_mode()
     {
         stop();
         REG_DISPCNT_U16 = DCNT_MODE3 | DCNT_BG2;
+
+        #if BN_CFG_CORE_PIPELINED_COMMIT
+            commit_register(0x0000) = DCNT_MODE3 | DCNT_BG2;
+        #endif
     }
 }
 
@@ -8,6 +8,7 @@
 
 #include "bn_config_hbes.h"
 #include "bn_hw_irq.h"
+#include "bn_hw_tonc.h"
 
 namespace bn::hw::hblank_effects
 {
@@ -32,6 +33,64 @@ namespace bn::hw::hblank_effects
         return 4;
     }
 
+    [[nodiscard]] constexpr int max_sparse_lines()
+    {
+        return BN_CFG_HBES_MAX_SPARSE_LINES;
+    }
+
+    [[nodiscard]] constexpr int last_vcount()
+    {
+        return 227;
+    }
+
+    [[nodiscard]] constexpr int uint32_entries_mask_shift()
+    {
+        return 16;
+    }
+
+    static_assert(BN_CFG_HBES_MAX_ITEMS <= uint32_entries_mask_shift());
+
+    [[nodiscard]] constexpr int max_cycles()
+    {
+        return 272; // H-Blank length.
+    }
+
+    // H-Blank interrupt cost model, counted from the ARM7TDMI instruction timings (not measured on hardware).
+    // Code and entries are in IWRAM and output values tables are in EWRAM (2 wait states, 16-bit bus).
+
+    // BIOS IRQ vector, libugba dispatcher (IE and IF test, acknowledge, IME and CPU mode switches)
+    // and _intr fixed work (REG_VCOUNT load, line range check and both computed jumps into the unrolled copies):
+    [[nodiscard]] constexpr int intr_base_cycles()
+    {
+        return 135;
+    }
+
+    // _sparse_intr extra work: DISPSTAT read-modify-writes, armed flag and next sparse line and mask loads:
+    [[nodiscard]] constexpr int sparse_intr_base_cycles()
+    {
+        return 30;
+    }
+
+    // ldmdb of src and dest from IWRAM (4), ldrh from EWRAM (1S + 3 cycles N + 1I = 5) and strh to I/O (2):
+    [[nodiscard]] constexpr int uint16_entry_cycles()
+    {
+        return 11;
+    }
+
+    // Same as a 16-bit entry, but the 32-bit EWRAM load takes two 16-bit bus accesses (1S + 6 cycles N + 1I = 8):
+    [[nodiscard]] constexpr int uint32_entry_cycles()
+    {
+        return 14;
+    }
+
+    // Rough estimate of the CPU cycles used by an H-Blank interrupt:
+    [[nodiscard]] constexpr int cycles(int uint16_entries_count, int uint32_entries_count, bool sparse)
+    {
+        return intr_base_cycles() + (sparse ? sparse_intr_base_cycles() : 0) +
+                (uint16_entries_count * uint16_entry_cycles()) + (uint32_entries_count * uint32_entry_cycles());
+    }
+
+    // The layout of the entries fields is used by the _intr assembly routine, so new fields must go last:
     class entries
     {
 
@@ -40,12 +99,21 @@ namespace bn::hw::hblank_effects
         uint16_entry uint16_entries[BN_CFG_HBES_MAX_ITEMS];
         int uint32_entries_count = 0;
         uint32_entry uint32_entries[max_uint32_entries()];
+        int sparse_lines_count = 0;                     // If it's 0, values are written in every H-Blank.
+        uint8_t sparse_lines[max_sparse_lines() + 1];   // V-Counts before lines with changes, ended by last_vcount().
+        unsigned sparse_masks[max_sparse_lines() + 1];  // Changed entries of each sparse line.
     };
 
     extern entries* data;
 
     BN_CODE_IWRAM void _intr();
 
+    #if BN_CFG_HBES_MAX_SPARSE_LINES
+        BN_CODE_IWRAM void _sparse_intr();
+
+        BN_CODE_IWRAM void _vcount_intr();
+    #endif
+
     inline void commit_entries(entries& entries_ref)
     {
         data = &entries_ref;
@@ -53,12 +121,33 @@ namespace bn::hw::hblank_effects
 
     inline void enable()
     {
+        #if BN_CFG_HBES_MAX_SPARSE_LINES
+            if(data->sparse_lines_count)
+            {
+                // H-Blank interrupt is enabled by the V-Count interrupt only before lines with changes:
+                irq::set_isr(irq::id::HBLANK, _sparse_intr);
+                irq::set_isr(irq::id::VCOUNT, _vcount_intr);
+                REG_DISPSTAT = uint16_t((REG_DISPSTAT & ~DSTAT_VCT_MASK) | DSTAT_VCT(last_vcount()));
+                irq::enable(irq::id::HBLANK);
+                irq::enable(irq::id::VCOUNT);
+                REG_DISPSTAT = uint16_t(REG_DISPSTAT & ~DSTAT_HBL_IRQ);
+                return;
+            }
+
+            irq::set_isr(irq::id::HBLANK, _intr);
+            irq::disable(irq::id::VCOUNT);
+        #endif
+
         irq::enable(irq::id::HBLANK);
     }
 
     inline void disable()
     {
         irq::disable(irq::id::HBLANK);
+
+        #if BN_CFG_HBES_MAX_SPARSE_LINES
+            irq::disable(irq::id::VCOUNT);
+        #endif
     }
 }
 
@@ -9,6 +9,7 @@
 #include "bn_color.h"
 #include "bn_hw_dma.h"
 #include "bn_hw_memory.h"
+#include "bn_hw_pipelined_commit.h"
 
 extern "C"
 {
@@ -33,26 +34,35 @@ namespace bn::hw::palettes
         return count() * colors_per_palette();
     }
 
+    [[nodiscard]] constexpr int lut_size()
+    {
+        return 32 * 3;
+    }
+
     namespace
     {
         static_assert(sizeof(color) == sizeof(COLOR));
         static_assert(alignof(color) == alignof(COLOR));
 
         inline void commit(const color* source_colors_ptr, int offset, int count, color* destination_colors_ptr,
-                           bool use_dma)
+                           [[maybe_unused]] pipelined_commit::copy_slot slot, [[maybe_unused]] bool use_dma)
         {
             const void* source = source_colors_ptr + offset;
             int words = count / 2;
             void* destination = destination_colors_ptr + offset;
 
-            if(use_dma)
-            {
-                hw::dma::copy_words(source, words, destination);
-            }
-            else
-            {
-                hw::memory::copy_words(source, words, destination);
-            }
+            #if BN_CFG_CORE_PIPELINED_COMMIT
+                hw::pipelined_commit::stage_copy(slot, source, words, destination);
+            #else
+                if(use_dma)
+                {
+                    hw::dma::copy_words(source, words, destination);
+                }
+                else
+                {
+                    hw::memory::copy_words(source, words, destination);
+                }
+            #endif
         }
     }
 
@@ -63,6 +73,12 @@ namespace bn::hw::palettes
 
     void intensity(const color* source_colors_ptr, int value, int count, color* destination_colors_ptr);
 
+    // Composes brightness, contrast, intensity and invert into one LUT with a color component per entry:
+    void build_lut(int brightness, int contrast, int intensity, bool inverted, unsigned* lut);
+
+    BN_CODE_IWRAM void aligned_lut_effect(
+            const color* source_colors_ptr, const unsigned* lut, int count, color* destination_colors_ptr);
+
     inline void invert(const color* source_colors_ptr, int count, color* destination_colors_ptr)
     {
         auto tonc_src_ptr = reinterpret_cast<const COLOR*>(source_colors_ptr);
@@ -103,6 +119,28 @@ namespace bn::hw::palettes
         }
     }
 
+    BN_CODE_IWRAM void _aligned_grayscale_effect(
+            const color* source_colors_ptr, int count, color* destination_colors_ptr);
+
+    inline void aligned_grayscale(const color* source_colors_ptr, int intensity, int count,
+                                  color* destination_colors_ptr)
+    {
+        if(intensity == 32)
+        {
+            _aligned_grayscale_effect(source_colors_ptr, count, destination_colors_ptr);
+        }
+        else
+        {
+            alignas(int) color temp_colors[colors()];
+            _aligned_grayscale_effect(source_colors_ptr, count, temp_colors);
+
+            auto tonc_src_ptr = const_cast<COLOR*>(reinterpret_cast<const COLOR*>(source_colors_ptr));
+            auto tonc_temp_ptr = reinterpret_cast<COLOR*>(temp_colors);
+            auto tonc_dst_ptr = reinterpret_cast<COLOR*>(destination_colors_ptr);
+            clr_blend_fast(tonc_src_ptr, tonc_temp_ptr, tonc_dst_ptr, unsigned(count), unsigned(intensity));
+        }
+    }
+
     void hue_shift(const color* source_colors_ptr, int value, int count, color* destination_colors_ptr);
 
     inline void blend(const color* first_source_colors_ptr, const color* second_source_colors_ptr,
@@ -136,12 +174,14 @@ namespace bn::hw::palettes
 
     inline void commit_sprites(const color* colors_ptr, int offset, int count, bool use_dma)
     {
-        commit(colors_ptr, offset, count, reinterpret_cast<color*>(MEM_PAL_OBJ), use_dma);
+        commit(colors_ptr, offset, count, reinterpret_cast<color*>(MEM_PAL_OBJ),
+               pipelined_commit::copy_slot::SPRITE_PALETTES, use_dma);
     }
 
     inline void commit_bgs(const color* colors_ptr, int offset, int count, bool use_dma)
     {
-        commit(colors_ptr, offset, count, reinterpret_cast<color*>(MEM_PAL_BG), use_dma);
+        commit(colors_ptr, offset, count, reinterpret_cast<color*>(MEM_PAL_BG),
+               pipelined_commit::copy_slot::BG_PALETTES, use_dma);
     }
 
     [[nodiscard]] inline uint16_t* sprite_color_register(int index)
@@ -161,6 +201,9 @@ namespace bn::hw::palettes
 
     BN_CODE_IWRAM void _lut_effect(
             const color* source_colors_ptr, const uint8_t* lut, int count, color* destination_colors_ptr);
+
+    BN_CODE_IWRAM void _hue_shift_effect(
+            const color* source_colors_ptr, const int* luts, int count, color* destination_colors_ptr);
 }
 
 #endif
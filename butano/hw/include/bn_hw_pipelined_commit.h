@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_HW_PIPELINED_COMMIT_H
+#define BN_HW_PIPELINED_COMMIT_H
+
+#include "bn_config_core.h"
+#include "bn_hw_tonc.h"
+
+#if BN_CFG_CORE_PIPELINED_COMMIT
+    #include "bn_assert.h"
+    #include "bn_hw_memory.h"
+#endif
+
+namespace bn::hw::pipelined_commit
+{
+    // Each committer stages at most one copy per frame, in its own slot:
+    enum class copy_slot : uint8_t
+    {
+        SPRITES,
+        SPRITE_PALETTES,
+        BG_PALETTES
+    };
+
+    #if BN_CFG_CORE_PIPELINED_COMMIT
+        // Shadowed I/O registers: display, backgrounds, windows, mosaic and blending (DISPSTAT and VCOUNT are skipped).
+        [[nodiscard]] constexpr int io_registers_size()
+        {
+            return 0x58;
+        }
+
+        [[nodiscard]] constexpr int max_copies()
+        {
+            return int(copy_slot::BG_PALETTES) + 1;
+        }
+
+        [[nodiscard]] constexpr int max_copy_words(copy_slot slot)
+        {
+            return slot == copy_slot::SPRITES ? 1024 / 4 : 512 / 4; // OAM or sprite/BG palettes.
+        }
+
+        [[nodiscard]] constexpr int copy_words_offset(copy_slot slot)
+        {
+            int result = 0;
+
+            for(int index = 0; index < int(slot); ++index)
+            {
+                result += max_copy_words(copy_slot(index));
+            }
+
+            return result;
+        }
+
+        [[nodiscard]] constexpr int max_copies_words()
+        {
+            return copy_words_offset(copy_slot::BG_PALETTES) + max_copy_words(copy_slot::BG_PALETTES);
+        }
+
+        static_assert(max_copies_words() == (1024 + 512 + 512) / 4);
+
+        class copy
+        {
+
+        public:
+            void* destination = nullptr;
+            int words = 0;
+        };
+
+        class static_data
+        {
+
+        public:
+            alignas(int) uint8_t io_registers[io_registers_size()];
+            unsigned copies_words[max_copies_words()];
+            copy copies[max_copies()];
+        };
+
+        extern static_data data;
+
+        inline void stage_copy(copy_slot slot, const void* source, int words, void* destination)
+        {
+            copy& slot_copy = data.copies[int(slot)];
+            BN_BASIC_ASSERT(! slot_copy.words, "Copy already staged: ", int(slot));
+            BN_BASIC_ASSERT(words > 0 && words <= max_copy_words(slot),
+                            "Invalid staged words: ", int(slot), " - ", words);
+
+            memory::copy_words(source, words, data.copies_words + copy_words_offset(slot));
+            slot_copy.destination = destination;
+            slot_copy.words = words;
+        }
+
+        void commit(bool use_dma);
+    #endif
+
+    [[nodiscard]] inline uintptr_t io_registers()
+    {
+        #if BN_CFG_CORE_PIPELINED_COMMIT
+            return uintptr_t(data.io_registers);
+        #else
+            return REG_BASE;
+        #endif
+    }
+}
+
+#endif
@@ -10,6 +10,7 @@
 #include "bn_hw_bfn.h"
 #include "bn_hw_dma.h"
 #include "bn_hw_memory.h"
+#include "bn_hw_pipelined_commit.h"
 
 namespace bn::hw::sprites
 {
@@ -188,6 +189,11 @@ namespace bn::hw::sprites
         BN_BFN_SET(sprite.attr1, int(shape_size.size()), ATTR1_SIZE);
     }
 
+    [[nodiscard]] inline int tiles_id(const handle_type& sprite)
+    {
+        return BN_BFN_GET(sprite.attr2, ATTR2_ID);
+    }
+
     inline void set_tiles(int tiles_id, handle_type& sprite)
     {
         BN_BFN_SET(sprite.attr2, tiles_id, ATTR2_ID);
@@ -325,20 +331,24 @@ namespace bn::hw::sprites
         }
     }
 
-    inline void commit(const handle_type& sprites_ref, int offset, int count, bool use_dma)
+    inline void commit(const handle_type& sprites_ref, int offset, int count, [[maybe_unused]] bool use_dma)
     {
         const void* source = (&sprites_ref) + offset;
         int words = count * int(sizeof(handle_type) / 4);
         void* destination = vram() + offset;
 
-        if(use_dma)
-        {
-            hw::dma::copy_words(source, words, destination);
-        }
-        else
-        {
-            hw::memory::copy_words(source, words, destination);
-        }
+        #if BN_CFG_CORE_PIPELINED_COMMIT
+            hw::pipelined_commit::stage_copy(pipelined_commit::copy_slot::SPRITES, source, words, destination);
+        #else
+            if(use_dma)
+            {
+                hw::dma::copy_words(source, words, destination);
+            }
+            else
+            {
+                hw::memory::copy_words(source, words, destination);
+            }
+        #endif
     }
 
     [[nodiscard]] inline uint16_t* first_attributes_register(int id)
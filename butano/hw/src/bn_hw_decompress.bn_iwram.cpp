@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "../include/bn_hw_decompress.h"
+
+#include "bn_assert.h"
+#include "bn_memory.h"
+
+namespace bn::hw::decompress
+{
+
+namespace
+{
+    constexpr int rans_scale_bits = 12;
+    constexpr unsigned rans_scale = 1U << rans_scale_bits;
+    constexpr unsigned rans_lower_bound = 1U << 23;
+
+    // rANS decoding tables, allocated in the EWRAM heap only while rANS data is being decompressed:
+    class rans_tables
+    {
+
+    public:
+        uint16_t starts[256];
+        uint16_t frequencies[256];
+        uint8_t symbols[rans_scale];
+    };
+
+
+    // Writes bytes with 16-bit stores only, so it can be used with VRAM destinations:
+    class writer
+    {
+
+    public:
+        explicit writer(void* dst) :
+            _dst(static_cast<uint8_t*>(dst))
+        {
+        }
+
+        [[nodiscard]] int index() const
+        {
+            return _index;
+        }
+
+        void write(unsigned value)
+        {
+            if(_index & 1)
+            {
+                *reinterpret_cast<uint16_t*>(_dst + _index - 1) = uint16_t(_pending_byte | (value << 8));
+            }
+            else
+            {
+                _pending_byte = uint8_t(value);
+            }
+
+            ++_index;
+        }
+
+        [[nodiscard]] unsigned read_back(int distance) const
+        {
+            if(distance == 1 && (_index & 1))
+            {
+                return _pending_byte;
+            }
+
+            return _dst[_index - distance];
+        }
+
+        void flush()
+        {
+            if(_index & 1)
+            {
+                // The next byte is written back unchanged:
+                *reinterpret_cast<uint16_t*>(_dst + _index - 1) = uint16_t(_pending_byte | (_dst[_index] << 8));
+            }
+        }
+
+    private:
+        uint8_t* _dst;
+        int _index = 0;
+        uint8_t _pending_byte = 0;
+    };
+
+
+    [[nodiscard]] unsigned _read_word(const uint8_t* src)
+    {
+        return src[0] | (unsigned(src[1]) << 8) | (unsigned(src[2]) << 16) | (unsigned(src[3]) << 24);
+    }
+
+    [[nodiscard]] int _read_lz4_length(const uint8_t*& src, int length)
+    {
+        if(length == 15)
+        {
+            unsigned extra;
+
+            do
+            {
+                extra = *src++;
+                length += int(extra);
+            }
+            while(extra == 255);
+        }
+
+        return length;
+    }
+}
+
+void lz4(const void* src, void* dst)
+{
+    auto src_ptr = static_cast<const uint8_t*>(src);
+    int dst_size = int(_read_word(src_ptr) >> 8);
+    src_ptr += 4;
+
+    writer output(dst);
+
+    while(output.index() < dst_size)
+    {
+        unsigned token = *src_ptr++;
+        int literals = _read_lz4_length(src_ptr, int(token >> 4));
+
+        for(; literals; --literals)
+        {
+            output.write(*src_ptr++);
+        }
+
+        if(output.index() >= dst_size)
+        {
+            break;
+        }
+
+        int distance = src_ptr[0] | (src_ptr[1] << 8);
+        src_ptr += 2;
+
+        int length = _read_lz4_length(src_ptr, int(token & 0xF)) + 4;
+
+        for(; length; --length)
+        {
+            output.write(output.read_back(distance));
+        }
+    }
+
+    output.flush();
+}
+
+void rans(const void* src, void* dst)
+{
+    auto src_ptr = static_cast<const uint8_t*>(src);
+    unsigned header = _read_word(src_ptr);
+    int dst_size = int(header >> 8);
+    bool nibbles = (header & 0xF) == 4;
+    src_ptr += 4;
+
+    int symbols_count = src_ptr[0] | (src_ptr[1] << 8);
+    const uint8_t* frequencies_ptr = src_ptr + 2;
+    src_ptr = frequencies_ptr + (symbols_count * 2);
+
+    auto tables = static_cast<rans_tables*>(bn::memory::ewram_alloc(sizeof(rans_tables)));
+    BN_BASIC_ASSERT(tables, "Not enough EWRAM to decompress rANS data: ",
+                    int(sizeof(rans_tables)), " - ", bn::memory::available_alloc_ewram());
+
+    uint16_t* starts = tables->starts;
+    uint16_t* frequencies = tables->frequencies;
+    uint8_t* symbols = tables->symbols;
+    unsigned start = 0;
+
+    for(int symbol = 0; symbol < symbols_count; ++symbol)
+    {
+        unsigned frequency = frequencies_ptr[symbol * 2] | (unsigned(frequencies_ptr[(symbol * 2) + 1]) << 8);
+        starts[symbol] = uint16_t(start);
+        frequencies[symbol] = uint16_t(frequency);
+
+        for(unsigned slot = start, slot_end = start + frequency; slot < slot_end; ++slot)
+        {
+            symbols[slot] = uint8_t(symbol);
+        }
+
+        start += frequency;
+    }
+
+    unsigned state = _read_word(src_ptr);
+    src_ptr += 4;
+
+    auto decode_symbol = [&]()
+    {
+        unsigned slot = state & (rans_scale - 1);
+        unsigned symbol = symbols[slot];
+        state = (frequencies[symbol] * (state >> rans_scale_bits)) + slot - starts[symbol];
+
+        while(state < rans_lower_bound)
+        {
+            state = (state << 8) | *src_ptr++;
+        }
+
+        return symbol;
+    };
+
+    writer output(dst);
+
+    if(nibbles)
+    {
+        while(output.index() < dst_size)
+        {
+            unsigned low_nibble = decode_symbol();
+            output.write(low_nibble | (decode_symbol() << 4));
+        }
+    }
+    else
+    {
+        while(output.index() < dst_size)
+        {
+            output.write(decode_symbol());
+        }
+    }
+
+    output.flush();
+    bn::memory::ewram_free(tables);
+}
+
+}
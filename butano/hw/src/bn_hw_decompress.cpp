@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "../include/bn_hw_decompress.h"
+
+#include "bn_assert.h"
+
+namespace bn::hw::decompress
+{
+
+namespace
+{
+    constexpr int lz77_type = 1;
+    constexpr int huff_type = 2;
+    constexpr int rl_type = 3;
+}
+
+void stream::init(const void* src, void* dst)
+{
+    auto src_ptr = static_cast<const uint8_t*>(src);
+    unsigned header = src_ptr[0] | (unsigned(src_ptr[1]) << 8) | (unsigned(src_ptr[2]) << 16) |
+            (unsigned(src_ptr[3]) << 24);
+    int type = int(header >> 4) & 0xF;
+    BN_BASIC_ASSERT(type == lz77_type || type == huff_type || type == rl_type, "Invalid compression type: ", type);
+
+    _dst = static_cast<uint16_t*>(dst);
+    _dst_size = int(header >> 8);
+    _dst_index = 0;
+    _run_count = 0;
+    _huff_bits_count = 0;
+    _type = uint8_t(type);
+    _flags_count = 0;
+    _huff_nibble_pending = false;
+
+    if(type == huff_type)
+    {
+        // Tree size is followed by the root node:
+        _huff_symbol_bits = uint8_t(header & 0xF);
+        _huff_tree = src_ptr + 5;
+        _src = src_ptr + 4 + ((src_ptr[4] + 1) * 2);
+    }
+    else
+    {
+        _src = src_ptr + 4;
+    }
+}
+
+int stream::decompress(int max_bytes)
+{
+    int old_dst_index = _dst_index;
+    int limit = _dst_size - _dst_index > max_bytes ? _dst_index + max_bytes : _dst_size;
+
+    switch(_type)
+    {
+
+    case lz77_type:
+        _lz77(limit);
+        break;
+
+    case huff_type:
+        _huff(limit);
+        break;
+
+    case rl_type:
+        _rl(limit);
+        break;
+
+    default:
+        break;
+    }
+
+    if(_dst_index >= _dst_size && (_dst_size & 1))
+    {
+        // Odd sizes are padded:
+        _dst[_dst_index >> 1] = _pending_byte;
+    }
+
+    return _dst_index - old_dst_index;
+}
+
+void stream::_write(unsigned value)
+{
+    int dst_index = _dst_index;
+
+    if(dst_index & 1)
+    {
+        _dst[dst_index >> 1] = uint16_t(_pending_byte | (value << 8));
+    }
+    else
+    {
+        _pending_byte = uint8_t(value);
+    }
+
+    _dst_index = dst_index + 1;
+}
+
+unsigned stream::_read_back(int index) const
+{
+    if(index == _dst_index - 1 && (index & 1) == 0)
+    {
+        return _pending_byte;
+    }
+
+    unsigned half_word = _dst[index >> 1];
+    return (index & 1) ? half_word >> 8 : half_word & 0xFF;
+}
+
+void stream::_lz77(int limit)
+{
+    while(_dst_index < limit)
+    {
+        if(_run_count)
+        {
+            --_run_count;
+            _write(_read_back(_dst_index - _run_distance));
+        }
+        else
+        {
+            if(! _flags_count)
+            {
+                _flags = *_src++;
+                _flags_count = 8;
+            }
+
+            bool reference = _flags & 0x80;
+            _flags <<= 1;
+            --_flags_count;
+
+            if(reference)
+            {
+                unsigned first_byte = _src[0];
+                unsigned second_byte = _src[1];
+                _src += 2;
+                _run_count = int(first_byte >> 4) + 3;
+                _run_distance = int(((first_byte & 0xF) << 8) | second_byte) + 1;
+            }
+            else
+            {
+                _write(*_src++);
+            }
+        }
+    }
+}
+
+void stream::_rl(int limit)
+{
+    while(_dst_index < limit)
+    {
+        if(_run_count)
+        {
+            --_run_count;
+            _write(_run_copy ? *_src++ : _run_byte);
+        }
+        else
+        {
+            unsigned flag = *_src++;
+
+            if(flag & 0x80)
+            {
+                _run_count = int(flag & 0x7F) + 3;
+                _run_byte = *_src++;
+                _run_copy = false;
+            }
+            else
+            {
+                _run_count = int(flag & 0x7F) + 1;
+                _run_copy = true;
+            }
+        }
+    }
+}
+
+void stream::_huff(int limit)
+{
+    while(_dst_index < limit)
+    {
+        const uint8_t* node = _huff_tree;
+        bool data_node = false;
+
+        while(! data_node)
+        {
+            if(! _huff_bits_count)
+            {
+                _huff_bits = _src[0] | (unsigned(_src[1]) << 8) | (unsigned(_src[2]) << 16) |
+                        (unsigned(_src[3]) << 24);
+                _src += 4;
+                _huff_bits_count = 32;
+            }
+
+            unsigned bit = _huff_bits >> 31;
+            _huff_bits <<= 1;
+            --_huff_bits_count;
+
+            unsigned node_value = *node;
+            data_node = node_value & (bit ? 0x40 : 0x80);
+
+            uintptr_t children_address = (uintptr_t(node) & ~uintptr_t(1)) + ((node_value & 0x3F) * 2) + 2;
+            node = reinterpret_cast<const uint8_t*>(children_address + bit);
+        }
+
+        unsigned symbol = *node;
+
+        if(_huff_symbol_bits == 8)
+        {
+            _write(symbol);
+        }
+        else if(_huff_nibble_pending)
+        {
+            _write(_huff_nibble | (symbol << 4));
+            _huff_nibble_pending = false;
+        }
+        else
+        {
+            _huff_nibble = uint8_t(symbol);
+            _huff_nibble_pending = true;
+        }
+    }
+}
+
+}
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+/*
+    GBA BIOS Huffman decompressor (4 and 8 bits per symbol).
+
+    Like the BIOS routine, output is written with 32-bit stores only (so it can be used with VRAM destinations),
+    and the destination must be word aligned.
+
+    void bn_hw_decompress_huff(const void* src, void* dst)
+    {
+        const uint8_t* src_bytes = static_cast<const uint8_t*>(src);
+        unsigned header = *reinterpret_cast<const unsigned*>(src);
+        unsigned symbol_bits = header & 0xF;
+        const uint8_t* root = src_bytes + 5;
+        const unsigned* bits_ptr = reinterpret_cast<const unsigned*>(src_bytes + 4 + ((src_bytes[4] + 1) * 2));
+        unsigned* dst_words = static_cast<unsigned*>(dst);
+        unsigned* dst_end = reinterpret_cast<unsigned*>(static_cast<uint8_t*>(dst) + (header >> 8));
+        unsigned bits = 0;
+        int bits_count = 0;
+        unsigned word = 0;
+        unsigned word_bits = 0;
+
+        while(dst_words < dst_end)
+        {
+            const uint8_t* node = root;
+            bool leaf = false;
+
+            while(! leaf)
+            {
+                if(! bits_count)
+                {
+                    bits = *bits_ptr++;
+                    bits_count = 32;
+                }
+
+                unsigned node_value = *node;
+                node = reinterpret_cast<const uint8_t*>(uintptr_t(node) & ~1) + ((node_value & 0x3F) * 2) + 2;
+
+                if(bits & 0x80000000)
+                {
+                    ++node;
+                    leaf = node_value & 0x40;
+                }
+                else
+                {
+                    leaf = node_value & 0x80;
+                }
+
+                bits <<= 1;
+                --bits_count;
+            }
+
+            word |= unsigned(*node) << word_bits;
+            word_bits += symbol_bits;
+
+            if(word_bits == 32)
+            {
+                *dst_words++ = word;
+                word = 0;
+                word_bits = 0;
+            }
+        }
+    }
+
+    Registers:
+    r0: bits source.
+    r1: dst.
+    r2: dst end.
+    r3: root node.
+    r4: bits.
+    r5: bits count - 1.
+    r6: node.
+    r7: node value.
+    r8: output word.
+    r9: output word bits.
+    r10: symbol bits.
+    r12: temp.
+*/
+    .syntax unified
+    .section .iwram, "ax", %progbits
+    .align 2
+    .arm
+    .global bn_hw_decompress_huff
+    .type bn_hw_decompress_huff, STT_FUNC
+bn_hw_decompress_huff:
+    push    {r4-r10}
+    ldr     r12, [r0], #4
+    and     r10, r12, #0xF
+    add     r2, r1, r12, lsr #8
+    add     r3, r0, #1
+    ldrb    r12, [r0]
+    add     r12, r12, #1
+    add     r0, r0, r12, lsl #1
+    mov     r5, #0
+    mov     r8, #0
+    mov     r9, #0
+    cmp     r1, r2
+    bhs     .huff_exit
+
+.huff_symbol_loop:
+    mov     r6, r3
+    ldrb    r7, [r6]
+
+.huff_node_loop:
+    subs    r5, r5, #1
+    ldrmi   r4, [r0], #4
+    movmi   r5, #31
+    and     r12, r7, #0x3F
+    bic     r6, r6, #1
+    add     r6, r6, r12, lsl #1
+    add     r6, r6, #2
+    movs    r4, r4, lsl #1
+    addcs   r6, r6, #1
+    movcs   r7, r7, lsl #1          @ right child: leaf flag is bit 6
+    tst     r7, #0x80
+    ldrb    r7, [r6]
+    beq     .huff_node_loop
+
+    orr     r8, r8, r7, lsl r9
+    add     r9, r9, r10
+    cmp     r9, #32
+    blo     .huff_symbol_loop
+
+    str     r8, [r1], #4
+    mov     r8, #0
+    mov     r9, #0
+    cmp     r1, r2
+    blo     .huff_symbol_loop
+
+.huff_exit:
+    pop     {r4-r10}
+    bx      lr
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "../include/bn_hw_hblank_effects.h"
+
+#if BN_CFG_HBES_MAX_SPARSE_LINES
+
+namespace bn::hw::hblank_effects
+{
+
+namespace
+{
+    int sparse_line_index = 0;
+    bool sparse_armed = false;
+
+    void _write_sparse_line(const entries& entries_ref, int line, unsigned mask)
+    {
+        // Only the entries with changed values are written:
+        const uint16_entry* uint16_entry_ptr = entries_ref.uint16_entries;
+
+        for(unsigned uint16_mask = mask & ((1U << uint32_entries_mask_shift()) - 1); uint16_mask; uint16_mask >>= 1)
+        {
+            if(uint16_mask & 1)
+            {
+                *uint16_entry_ptr->dest = uint16_entry_ptr->src[line];
+            }
+
+            ++uint16_entry_ptr;
+        }
+
+        const uint32_entry* uint32_entry_ptr = entries_ref.uint32_entries;
+
+        for(unsigned uint32_mask = mask >> uint32_entries_mask_shift(); uint32_mask; uint32_mask >>= 1)
+        {
+            if(uint32_mask & 1)
+            {
+                *uint32_entry_ptr->dest = uint32_entry_ptr->src[line];
+            }
+
+            ++uint32_entry_ptr;
+        }
+    }
+}
+
+void _sparse_intr()
+{
+    REG_DISPSTAT = uint16_t(REG_DISPSTAT & ~DSTAT_HBL_IRQ);
+
+    if(sparse_armed)
+    {
+        sparse_armed = false;
+
+        const entries& entries_ref = *data;
+        int line_index = sparse_line_index;
+        _write_sparse_line(entries_ref, entries_ref.sparse_lines[line_index] + 1, entries_ref.sparse_masks[line_index]);
+
+        int next_line_index = line_index + 1;
+        int next_vcount = entries_ref.sparse_lines[next_line_index];
+        sparse_line_index = next_line_index;
+        REG_DISPSTAT = uint16_t((REG_DISPSTAT & ~DSTAT_VCT_MASK) | DSTAT_VCT(next_vcount));
+    }
+}
+
+void _vcount_intr()
+{
+    if(REG_VCOUNT >= last_vcount())
+    {
+        // Values of the first screen line are written at the end of V-Blank:
+        _intr();
+        sparse_line_index = 0;
+        REG_DISPSTAT = uint16_t((REG_DISPSTAT & ~DSTAT_VCT_MASK) | DSTAT_VCT(data->sparse_lines[0]));
+    }
+    else
+    {
+        // The next line values are written in the H-Blank of this line:
+        sparse_armed = true;
+        REG_DISPSTAT = uint16_t(REG_DISPSTAT | DSTAT_HBL_IRQ);
+    }
+}
+
+}
+
+#endif
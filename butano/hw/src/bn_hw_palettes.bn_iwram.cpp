@@ -5,6 +5,7 @@
 
 #include "../include/bn_hw_palettes.h"
 
+#include "bn_fixed.h"
 #include "bn_algorithm.h"
 
 namespace bn::hw::palettes
@@ -24,6 +25,59 @@ void brightness(const color* source_colors_ptr, int value, int count, color* des
     }
 }
 
+void aligned_lut_effect(const color* source_colors_ptr, const unsigned* lut, int count, color* destination_colors_ptr)
+{
+    auto u32_src_ptr = reinterpret_cast<const unsigned*>(source_colors_ptr);
+    auto u32_dst_ptr = reinterpret_cast<unsigned*>(destination_colors_ptr);
+    const unsigned* red_lut = lut;
+    const unsigned* green_lut = lut + 32;
+    const unsigned* blue_lut = lut + 64;
+
+    // Two colors per word:
+    for(int index = 0, limit = count / 2; index < limit; ++index)
+    {
+        unsigned colors = u32_src_ptr[index];
+        unsigned first_color = red_lut[colors & 31] | green_lut[(colors >> 5) & 31] | blue_lut[(colors >> 10) & 31];
+        unsigned second_color = red_lut[(colors >> 16) & 31] | green_lut[(colors >> 21) & 31] |
+                blue_lut[(colors >> 26) & 31];
+        u32_dst_ptr[index] = first_color | (second_color << 16);
+    }
+}
+
+void _aligned_grayscale_effect(const color* source_colors_ptr, int count, color* destination_colors_ptr)
+{
+    auto u32_src_ptr = reinterpret_cast<const unsigned*>(source_colors_ptr);
+    auto u32_dst_ptr = reinterpret_cast<unsigned*>(destination_colors_ptr);
+
+    // Two colors per word, with the same weights as tonc's clr_grayscale:
+    for(int index = 0, limit = count / 2; index < limit; ++index)
+    {
+        unsigned colors = u32_src_ptr[index];
+        unsigned first_gray = (((colors & 31) * 0x4C) + (((colors >> 5) & 31) * 0x96) +
+                               (((colors >> 10) & 31) * 0x1E) + 0x80) >> 8;
+        unsigned second_gray = ((((colors >> 16) & 31) * 0x4C) + (((colors >> 21) & 31) * 0x96) +
+                                (((colors >> 26) & 31) * 0x1E) + 0x80) >> 8;
+        u32_dst_ptr[index] = (first_gray | (second_gray << 16)) * 0x421;
+    }
+}
+
+void _hue_shift_effect(const color* source_colors_ptr, const int* luts, int count, color* destination_colors_ptr)
+{
+    auto tonc_dst_ptr = reinterpret_cast<COLOR*>(destination_colors_ptr);
+
+    for(int index = 0; index < count; ++index)
+    {
+        color color = source_colors_ptr[index];
+        int in_r = color.red();
+        int in_g = color.green();
+        int in_b = color.blue();
+        int out_r = (luts[in_r] + luts[32 + in_g] + luts[64 + in_b]) >> fixed::precision();
+        int out_g = (luts[96 + in_r] + luts[128 + in_g] + luts[160 + in_b]) >> fixed::precision();
+        int out_b = (luts[192 + in_r] + luts[224 + in_g] + luts[256 + in_b]) >> fixed::precision();
+        tonc_dst_ptr[index] = RGB15(clamp(out_r, 0, 31), clamp(out_g, 0, 31), clamp(out_b, 0, 31));
+    }
+}
+
 void _lut_effect(const color* source_colors_ptr, const uint8_t* lut, int count, color* destination_colors_ptr)
 {
     auto tonc_dst_ptr = reinterpret_cast<COLOR*>(destination_colors_ptr);
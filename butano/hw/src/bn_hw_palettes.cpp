@@ -100,6 +100,41 @@ namespace
 
         return lut;
     }();
+
+    class hue_shift_luts_cache
+    {
+
+    public:
+        int luts[9 * 32];
+        int value = 0; // Hue shift effects are not applied if their value is 0, so it means empty cache.
+    };
+
+    BN_DATA_EWRAM_BSS hue_shift_luts_cache hue_shift_cache;
+
+    [[nodiscard]] const int* _hue_shift_luts(int value)
+    {
+        if(hue_shift_cache.value != value)
+        {
+            // Each color component is multiplied by each matrix coefficient only once:
+            const fixed* coefficients = hue_shift_lut.data() + (value * 9);
+            int* luts = hue_shift_cache.luts;
+
+            for(int coefficient_index = 0; coefficient_index < 9; ++coefficient_index)
+            {
+                fixed coefficient = coefficients[coefficient_index];
+
+                for(int component = 0; component < 32; ++component)
+                {
+                    *luts = (component * coefficient).data();
+                    ++luts;
+                }
+            }
+
+            hue_shift_cache.value = value;
+        }
+
+        return hue_shift_cache.luts;
+    }
 }
 
 void contrast(const color* source_colors_ptr, int value, int count, color* destination_colors_ptr)
@@ -114,26 +149,41 @@ void intensity(const color* source_colors_ptr, int value, int count, color* dest
     _lut_effect(source_colors_ptr, lut, count, destination_colors_ptr);
 }
 
-void hue_shift(const color* source_colors_ptr, int value, int count, color* destination_colors_ptr)
+void build_lut(int brightness, int contrast, int intensity, bool inverted, unsigned* lut)
 {
-    const fixed* lut = hue_shift_lut.data() + (value * 9);
-    auto tonc_dst_ptr = reinterpret_cast<COLOR*>(destination_colors_ptr);
+    const uint8_t* contrast_values = contrast_lut.data() + (contrast * 32);
+    const uint8_t* intensity_values = intensity_lut.data() + (intensity * 32);
 
-    for(int index = 0; index < count; ++index)
+    for(int component = 0; component < 32; ++component)
     {
-        color color = source_colors_ptr[index];
-        int in_r = color.red();
-        int in_g = color.green();
-        int in_b = color.blue();
-        fixed out_r = in_r * lut[0] + in_g * lut[1] + in_b * lut[2];
-        fixed out_g = in_r * lut[3] + in_g * lut[4] + in_b * lut[5];
-        fixed out_b = in_r * lut[6] + in_g * lut[7] + in_b * lut[8];
-        tonc_dst_ptr[index] = RGB15(
-                clamp(out_r.shift_integer(), 0, 31), clamp(out_g.shift_integer(), 0, 31),
-                clamp(out_b.shift_integer(), 0, 31));
+        int value = bn::min(component + brightness, 31);
+
+        if(contrast)
+        {
+            value = contrast_values[value];
+        }
+
+        if(intensity)
+        {
+            value = intensity_values[value];
+        }
+
+        if(inverted)
+        {
+            value = 31 - value;
+        }
+
+        lut[component] = unsigned(value);
+        lut[component + 32] = unsigned(value) << 5;
+        lut[component + 64] = unsigned(value) << 10;
     }
 }
 
+void hue_shift(const color* source_colors_ptr, int value, int count, color* destination_colors_ptr)
+{
+    _hue_shift_effect(source_colors_ptr, _hue_shift_luts(value), count, destination_colors_ptr);
+}
+
 void rotate(const color* source_colors_ptr, int rotate_count, int colors_count, color* destination_colors_ptr)
 {
     int destination_index = rotate_count;
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "../include/bn_hw_pipelined_commit.h"
+
+#if BN_CFG_CORE_PIPELINED_COMMIT
+
+#include "../include/bn_hw_dma.h"
+
+namespace bn::hw::pipelined_commit
+{
+
+BN_DATA_EWRAM static_data data;
+
+namespace
+{
+    void _copy_words(const void* source, int words, void* destination, bool use_dma)
+    {
+        if(use_dma)
+        {
+            dma::copy_words(source, words, destination);
+        }
+        else
+        {
+            memory::copy_words(source, words, destination);
+        }
+    }
+}
+
+void commit(bool use_dma)
+{
+    auto io_registers_words = reinterpret_cast<const unsigned*>(data.io_registers);
+    auto hw_io_registers_words = reinterpret_cast<unsigned*>(REG_BASE);
+
+    // DISPCNT and green swap:
+    hw_io_registers_words[0] = io_registers_words[0];
+
+    // DISPSTAT and VCOUNT are skipped:
+    constexpr int first_word = 0x0008 / 4;
+    constexpr int words = (io_registers_size() / 4) - first_word;
+    _copy_words(io_registers_words + first_word, words, hw_io_registers_words + first_word, use_dma);
+
+    for(int index = 0; index < max_copies(); ++index)
+    {
+        copy& staged_copy = data.copies[index];
+
+        if(int copy_words = staged_copy.words)
+        {
+            const unsigned* source = data.copies_words + copy_words_offset(copy_slot(index));
+            _copy_words(source, copy_words, staged_copy.destination, use_dma);
+            staged_copy.words = 0;
+        }
+    }
+}
+
+}
+
+#endif
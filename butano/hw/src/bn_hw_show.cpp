@@ -20,6 +20,8 @@
 
 #if BN_CFG_PROFILER_ENABLED
     #include "bn_core.h"
+    #include "bn_span.h"
+    #include "bn_bitset.h"
     #include "bn_vector.h"
     #include "bn_keypad.h"
     #include "bn_profiler.h"
@@ -144,11 +146,13 @@ namespace
 #if BN_CFG_PROFILER_ENABLED
     void profiler_results(const system_font& system_font)
     {
-        const auto& ticks_per_entry = _bn::profiler::ticks_per_entry();
+        span<const _bn::profiler::node> nodes = _bn::profiler::nodes();
+        const auto& counts_per_entry = _bn::profiler::counts_per_entry();
+        int nodes_count = nodes.size();
         init_tte(system_font);
         tte_set_ink(colors::green.data());
 
-        if(ticks_per_entry.empty())
+        if(nodes_count <= 1 && counts_per_entry.empty())
         {
             tte_write("PROFILER results\n\nNo entries found");
 
@@ -159,38 +163,43 @@ namespace
         }
         else
         {
-            // Collect entries:
+            enum class mode_type
+            {
+                TOTAL_TICKS,
+                SELF_TICKS,
+                MAX_TICKS,
+                TOTAL_COUNTS,
+                MAX_COUNTS,
+            };
+
             struct entry
             {
                 string_view id;
-                int64_t total_ticks;
-                int max_ticks;
+                int64_t value;
+                int depth;
             };
 
-            vector<entry, BN_CFG_PROFILER_MAX_ENTRIES * 2> entries;
-            int64_t total_ticks = 0;
-            int64_t max_ticks = 0;
-            bool show_total = true;
-            bool rebuild = true;
+            constexpr int max_entries = BN_CFG_PROFILER_MAX_ENTRIES * 2;
+            using entries_type = vector<entry, max_entries>;
 
-            for(const auto& ticks_per_entry_pair : ticks_per_entry)
-            {
-                auto& ticks_entry = ticks_per_entry_pair.second;
-                entries.push_back({ ticks_per_entry_pair.first, ticks_entry.total, ticks_entry.max });
-                total_ticks += ticks_entry.total;
-                max_ticks = bn::max(max_ticks, int64_t(ticks_entry.max));
-            }
+            entries_type entries;
+            bool ticks_available = nodes_count > 1;
+            bool counts_available = ! counts_per_entry.empty();
+            mode_type mode = ticks_available ? mode_type::TOTAL_TICKS : mode_type::TOTAL_COUNTS;
+            bool rebuild = true;
 
             // Retrieve max width for indexes, labels and ticks:
             string<BN_CFG_ASSERT_BUFFER_SIZE> buffer;
             ostringstream buffer_stream(buffer);
-            int num_entries = entries.size();
+            int num_entries = 0;
             int max_index_width = 0;
             int max_id_width = 0;
             int max_ticks_width = 0;
+            int64_t global_var = 0;
 
             const int margin = 8;
             const int index_margin = 4;
+            const int depth_margin = 4;
             const int max_visible_entries = 8;
             int current_index = 0;
             int init_x;
@@ -201,25 +210,103 @@ namespace
             {
                 if(rebuild)
                 {
-                    max_index_width = 0;
-                    max_id_width = 0;
-                    max_ticks_width = 0;
-                    current_index = 0;
+                    entries.clear();
+                    global_var = 0;
 
-                    // Sort entries by ticks (higher to lower):
-                    if(show_total)
+                    if(mode == mode_type::TOTAL_COUNTS || mode == mode_type::MAX_COUNTS)
                     {
+                        bool total = mode == mode_type::TOTAL_COUNTS;
+
+                        for(const auto& counts_per_entry_pair : counts_per_entry)
+                        {
+                            auto& counts_entry = counts_per_entry_pair.second;
+                            int64_t value = total ? counts_entry.total : counts_entry.max;
+                            entries.push_back({ counts_per_entry_pair.first, value, 0 });
+                            global_var = total ? global_var + value : bn::max(global_var, value);
+                        }
+
+                        // Sort entries by counts (higher to lower):
                         sort(entries.begin(), entries.end(), [](const entry& a, const entry& b) {
-                            return a.total_ticks > b.total_ticks;
+                            return a.value > b.value;
                         });
                     }
                     else
                     {
-                        sort(entries.begin(), entries.end(), [](const entry& a, const entry& b) {
-                            return a.max_ticks > b.max_ticks;
-                        });
+                        auto node_value = [mode](const _bn::profiler::node& node) {
+                            switch(mode)
+                            {
+
+                            case mode_type::TOTAL_TICKS:
+                                return node.total_ticks;
+
+                            case mode_type::SELF_TICKS:
+                                return node.self_ticks();
+
+                            default:
+                                return int64_t(node.max_ticks);
+                            }
+                        };
+
+                        // Add nodes in depth first order, with children sorted by ticks (higher to lower):
+                        bitset<max_entries> added_nodes;
+                        int first_children[BN_CFG_PROFILER_MAX_DEPTH + 1];
+                        int depth = 0;
+                        first_children[0] = nodes[0].first_child;
+
+                        while(depth >= 0)
+                        {
+                            int best_node_index = -1;
+                            int64_t best_node_value = 0;
+
+                            for(int node_index = first_children[depth]; node_index >= 0;
+                                node_index = nodes[node_index].next_sibling)
+                            {
+                                if(! added_nodes[node_index])
+                                {
+                                    int64_t value = node_value(nodes[node_index]);
+
+                                    if(best_node_index < 0 || value > best_node_value)
+                                    {
+                                        best_node_index = node_index;
+                                        best_node_value = value;
+                                    }
+                                }
+                            }
+
+                            if(best_node_index < 0)
+                            {
+                                --depth;
+                            }
+                            else
+                            {
+                                const _bn::profiler::node& node = nodes[best_node_index];
+                                added_nodes.set(best_node_index);
+                                entries.push_back({ node.id, best_node_value, depth });
+
+                                if(mode == mode_type::MAX_TICKS)
+                                {
+                                    global_var = bn::max(global_var, best_node_value);
+                                }
+                                else if(mode == mode_type::SELF_TICKS || ! depth)
+                                {
+                                    global_var += best_node_value;
+                                }
+
+                                if(node.first_child >= 0)
+                                {
+                                    ++depth;
+                                    first_children[depth] = node.first_child;
+                                }
+                            }
+                        }
                     }
 
+                    num_entries = entries.size();
+                    max_index_width = 0;
+                    max_id_width = 0;
+                    max_ticks_width = 0;
+                    current_index = 0;
+
                     // Calculate columns width:
                     for(int index = 0; index < num_entries; ++index)
                     {
@@ -230,10 +317,11 @@ namespace
 
                         buffer.clear();
                         buffer_stream << entry.id;
-                        max_id_width = max(max_id_width, int(tte_get_text_size(buffer_stream.str().c_str()).x));
+                        int id_width = int(tte_get_text_size(buffer_stream.str().c_str()).x);
+                        max_id_width = max(max_id_width, id_width + (entry.depth * depth_margin));
 
                         buffer.clear();
-                        buffer_stream << (show_total ? entry.total_ticks : entry.max_ticks);
+                        buffer_stream << entry.value;
                         max_ticks_width = max(max_ticks_width, int(tte_get_text_size(buffer_stream.str().c_str()).x));
                     }
 
@@ -241,22 +329,35 @@ namespace
                 }
 
                 // Print title:
-                int64_t global_var;
                 tte_set_pos(init_x, init_y);
                 tte_set_ink(colors::green.data());
                 buffer.clear();
 
-                if(show_total)
+                switch(mode)
                 {
-                    buffer_stream << "PROFILER - Total ticks: " << total_ticks;
-                    global_var = total_ticks;
-                }
-                else
-                {
-                    buffer_stream << "PROFILER - Max ticks: " << max_ticks;
-                    global_var = max_ticks;
+
+                case mode_type::TOTAL_TICKS:
+                    buffer_stream << "PROFILER - Total ticks: ";
+                    break;
+
+                case mode_type::SELF_TICKS:
+                    buffer_stream << "PROFILER - Self ticks: ";
+                    break;
+
+                case mode_type::MAX_TICKS:
+                    buffer_stream << "PROFILER - Max ticks: ";
+                    break;
+
+                case mode_type::TOTAL_COUNTS:
+                    buffer_stream << "PROFILER - Total counts: ";
+                    break;
+
+                default:
+                    buffer_stream << "PROFILER - Max counts: ";
+                    break;
                 }
 
+                buffer_stream << global_var;
                 tte_write(buffer.c_str());
 
                 if(num_entries > max_visible_entries)
@@ -289,13 +390,14 @@ namespace
 
                     buffer.clear();
                     buffer_stream << entry.id;
+                    tte_set_pos(x + (entry.depth * depth_margin), y);
                     tte_set_ink(colors::white.data());
                     tte_write(buffer.c_str());
 
                     tte_set_pos(x + max_id_width + margin, y);
                     tte_get_pos(&x, &y);
 
-                    int64_t entry_var = show_total ? entry.total_ticks : entry.max_ticks;
+                    int64_t entry_var = entry.value;
                     buffer.clear();
                     buffer_stream << entry_var;
                     tte_set_ink(colors::yellow.data());
@@ -321,7 +423,30 @@ namespace
 
                     if(keypad::a_pressed())
                     {
-                        show_total = ! show_total;
+                        switch(mode)
+                        {
+
+                        case mode_type::TOTAL_TICKS:
+                            mode = mode_type::SELF_TICKS;
+                            break;
+
+                        case mode_type::SELF_TICKS:
+                            mode = mode_type::MAX_TICKS;
+                            break;
+
+                        case mode_type::MAX_TICKS:
+                            mode = counts_available ? mode_type::TOTAL_COUNTS : mode_type::TOTAL_TICKS;
+                            break;
+
+                        case mode_type::TOTAL_COUNTS:
+                            mode = mode_type::MAX_COUNTS;
+                            break;
+
+                        default:
+                            mode = ticks_available ? mode_type::TOTAL_TICKS : mode_type::TOTAL_COUNTS;
+                            break;
+                        }
+
                         rebuild = true;
                         tte_erase_screen();
                         break;
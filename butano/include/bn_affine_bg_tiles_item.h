@@ -72,7 +72,30 @@ public:
      * @param compression Compression type.
      */
     constexpr affine_bg_tiles_item(const span<const tile>& tiles_ref, compression_type compression) :
+        affine_bg_tiles_item(tiles_ref, compression, 0)
+    {
+    }
+
+    /**
+     * @brief Constructor.
+     * @param tiles_ref Reference to one or more background tiles.
+     *
+     * The tiles are not copied but referenced, so they should outlive the affine_bg_tiles_item
+     * to avoid dangling references.
+     *
+     * @param compression Compression type.
+     * @param content_hash Hash of the referenced tiles data, or 0 if it is not available.
+     *
+     * Uncompressed tiles items with the same non zero content hash and the same tiles data are considered equal
+     * when searching for already created affine_bg_tiles_ptr objects, even if they don't reference the same tiles.
+     *
+     * The first search with tiles data other than the one referenced by an already created item
+     * has a one-time cost: both tiles data are compared to discard hash collisions.
+     */
+    constexpr affine_bg_tiles_item(const span<const tile>& tiles_ref, compression_type compression,
+                                   unsigned content_hash) :
         _tiles_ref(tiles_ref),
+        _content_hash(content_hash),
         _compression(compression)
     {
         BN_BASIC_ASSERT(! tiles_ref.empty(), "There are no tiles");
@@ -86,6 +109,14 @@ public:
         return _compression;
     }
 
+    /**
+     * @brief Returns the hash of the referenced tiles data, or 0 if it is not available.
+     */
+    [[nodiscard]] constexpr unsigned content_hash() const
+    {
+        return _content_hash;
+    }
+
     /**
      * @brief Decompresses the stored data in the tiles referenced by decompressed_tiles_ref.
      *
@@ -201,6 +232,7 @@ public:
 
 private:
     span<const tile> _tiles_ref;
+    unsigned _content_hash;
     compression_type _compression;
 };
 
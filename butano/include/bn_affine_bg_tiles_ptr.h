@@ -288,6 +288,13 @@ public:
      */
     [[nodiscard]] optional<span<tile>> vram();
 
+    /**
+     * @brief Indicates if the tiles have been fully copied to VRAM or not.
+     *
+     * Compressed tiles can be decompressed over several frames if streaming is enabled.
+     */
+    [[nodiscard]] bool loaded() const;
+
     /**
      * @brief Returns the internal handle.
      */
@@ -46,6 +46,7 @@ namespace bn
 
     using std::sort;
     using std::stable_sort;
+    using std::nth_element;
 
     using std::reverse;
 
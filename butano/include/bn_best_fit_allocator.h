@@ -23,6 +23,16 @@ namespace bn
 /**
  * @brief Manages a chunk of memory with a best fit allocation strategy.
  *
+ * If @ref BN_CFG_BEST_FIT_ALLOCATOR_SEGREGATED_FREE_LISTS is `true`, free items are stored in segregated lists
+ * indexed by size class (power of two ranges split in four), with bitmaps to find the first non empty list.
+ * Requests are served from the first non empty list of a bigger size class,
+ * so the allocation strategy is good fit instead of best fit,
+ * but allocations and deallocations take constant time.
+ * Only if there's no free item in bigger size classes, the list of the requested size class is searched.
+ *
+ * Otherwise, free items are stored in a single list sorted by address
+ * and the smallest free item which fits is found by searching the whole list.
+ *
  * @ingroup allocator
  */
 class best_fit_allocator
@@ -238,8 +248,25 @@ private:
     static constexpr size_type _sizeof_free_item = sizeof(item_type);
     static constexpr size_type _sizeof_used_item = sizeof(item_type) - sizeof(free_items_pair);
 
+    #if BN_CFG_BEST_FIT_ALLOCATOR_SEGREGATED_FREE_LISTS
+        static constexpr int _min_size_bits = _sizeof_free_item >= 32 ? 5 : 4;
+        static constexpr int _first_level_count = 31 - _min_size_bits;
+        static constexpr int _second_level_bits = 2;
+        static constexpr int _second_level_count = 1 << _second_level_bits;
+
+        static_assert(_sizeof_free_item >= (1 << _min_size_bits) && _sizeof_free_item < (2 << _min_size_bits));
+    #endif
+
     uint8_t* _start_ptr = nullptr;
-    item_type* _first_free_item = nullptr;
+
+    #if BN_CFG_BEST_FIT_ALLOCATOR_SEGREGATED_FREE_LISTS
+        item_type* _free_lists[_first_level_count][_second_level_count] = {};
+        unsigned _first_level_bitmap = 0;
+        uint8_t _second_level_bitmaps[_first_level_count] = {};
+    #else
+        item_type* _first_free_item = nullptr;
+    #endif
+
     size_type _total_bytes_count = 0;
     size_type _free_bytes_count = 0;
     bool _skip_empty_check_on_destructor = false;
@@ -264,6 +291,16 @@ private:
         return reinterpret_cast<item_type*>(_start_ptr + _total_bytes_count);
     }
 
+    #if BN_CFG_BEST_FIT_ALLOCATOR_SEGREGATED_FREE_LISTS
+        static void _free_list_indexes(unsigned bytes, int& first_level, int& second_level);
+    #endif
+
+    void _insert_free_item(item_type* item);
+
+    void _remove_free_item(item_type* item);
+
+    void _replace_free_item(item_type* item, item_type* new_item);
+
     [[nodiscard]] item_type* _best_free_item(size_type bytes);
 
     #if BN_CFG_BEST_FIT_ALLOCATOR_SANITY_CHECK_ENABLED
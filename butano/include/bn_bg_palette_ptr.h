@@ -23,6 +23,7 @@ namespace bn
 
 class color;
 class bg_palette_item;
+class palette_animation_item;
 enum class bpp_mode : uint8_t;
 
 /**
@@ -247,6 +248,35 @@ public:
      */
     void set_rotate_range(int start, int size);
 
+    /**
+     * @brief Indicates if the colors of this palette are being animated by a palette_animation_item or not.
+     */
+    [[nodiscard]] bool has_animation() const;
+
+    /**
+     * @brief Indicates if the palette animation of this palette has been finished or not.
+     *
+     * Looping palette animations are never finished.
+     */
+    [[nodiscard]] bool animation_done() const;
+
+    /**
+     * @brief Animates the colors of this palette with the given palette_animation_item.
+     *
+     * Each frame only the colors updated by the animation are processed and committed to the GBA,
+     * so no game code is required to keep it running.
+     *
+     * @param animation_item palette_animation_item which references the animation frames.
+     *
+     * The frames are not copied but referenced, so they should outlive the animation.
+     */
+    void set_animation(const palette_animation_item& animation_item);
+
+    /**
+     * @brief Stops animating the colors of this palette (they are not restored).
+     */
+    void remove_animation();
+
     /**
      * @brief Exchanges the contents of this bg_palette_ptr with those of the other one.
      * @param other bg_palette_ptr to exchange the contents with.
@@ -56,6 +56,53 @@ namespace bn::bg_tiles
      */
     void set_allow_offset(bool allow_offset);
 
+    /**
+     * @brief Indicates if background VRAM is compacted automatically or not.
+     *
+     * If it is enabled, background tiles and maps are relocated over several frames to merge free VRAM blocks.
+     *
+     * The maximum number of bytes relocated per frame is specified by
+     * @ref BN_CFG_BG_BLOCKS_COMPACTION_MAX_BYTES_PER_FRAME.
+     */
+    [[nodiscard]] bool compaction_enabled();
+
+    /**
+     * @brief Sets if background VRAM must be compacted automatically or not.
+     *
+     * If it is enabled, background tiles and maps are relocated over several frames to merge free VRAM blocks.
+     *
+     * The maximum number of bytes relocated per frame is specified by
+     * @ref BN_CFG_BG_BLOCKS_COMPACTION_MAX_BYTES_PER_FRAME.
+     */
+    void set_compaction_enabled(bool compaction_enabled);
+
+    /**
+     * @brief Relocates background tiles and maps to merge free VRAM blocks as much as possible.
+     *
+     * Relocated items are committed to VRAM in the next core::update call, so it should be called in a loading screen.
+     *
+     * Items which can't be reloaded from their source data (like big maps, allocated tiles and maps
+     * or tiles with overwritten tiles) are not relocated.
+     */
+    void compact();
+
+    /**
+     * @brief Returns the maximum number of compressed background tiles bytes decompressed to VRAM per frame.
+     *
+     * If it is 0 (the default), compressed background tiles are fully decompressed in the next core::update call.
+     */
+    [[nodiscard]] int stream_max_bytes_per_frame();
+
+    /**
+     * @brief Sets the maximum number of compressed background tiles bytes decompressed to VRAM per frame.
+     *
+     * If it is greater than 0, compressed background tiles are decompressed over several frames
+     * (use regular_bg_tiles_ptr::loaded and affine_bg_tiles_ptr::loaded to know when they are ready).
+     *
+     * If it is 0, compressed background tiles are fully decompressed in the next core::update call.
+     */
+    void set_stream_max_bytes_per_frame(int max_bytes_per_frame);
+
     /**
      * @brief Logs the current status of the background blocks manager.
      */
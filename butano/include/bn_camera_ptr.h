@@ -158,6 +158,26 @@ public:
      */
     void set_position(const fixed_point& position);
 
+    /**
+     * @brief Indicates if the sprites attached to this camera are culled with a coarse spatial grid or not.
+     *
+     * When it is enabled, moving the camera only updates the sprites placed in the grid cells
+     * entering or leaving the screen, instead of all sprites attached to the camera.
+     *
+     * Hardware positions of the sprites placed far away from the camera are not updated until they get close to it.
+     */
+    [[nodiscard]] bool sprites_culling_enabled() const;
+
+    /**
+     * @brief Sets if the sprites attached to this camera must be culled with a coarse spatial grid or not.
+     *
+     * When it is enabled, moving the camera only updates the sprites placed in the grid cells
+     * entering or leaving the screen, instead of all sprites attached to the camera.
+     *
+     * Hardware positions of the sprites placed far away from the camera are not updated until they get close to it.
+     */
+    void set_sprites_culling_enabled(bool sprites_culling_enabled);
+
     /**
      * @brief Exchanges the contents of this camera_ptr with those of the other one.
      * @param other camera_ptr to exchange the contents with.
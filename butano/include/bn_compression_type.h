@@ -28,7 +28,9 @@ enum class compression_type : uint8_t
     NONE, //!< Uncompressed data.
     LZ77, //!< LZ77 compressed data.
     RUN_LENGTH, //!< Run-length compressed data.
-    HUFFMAN //!< Huffman compressed data.
+    HUFFMAN, //!< Huffman compressed data.
+    LZ4, //!< LZ4 compressed data (faster to decompress than LZ77).
+    RANS //!< rANS compressed data (usually smaller than Huffman, but decompressing it uses 5KB of EWRAM heap).
 };
 
 }
@@ -15,6 +15,22 @@
 
 #include "bn_common.h"
 
+/**
+ * @def BN_CFG_BEST_FIT_ALLOCATOR_SEGREGATED_FREE_LISTS
+ *
+ * Specifies if bn::best_fit_allocator stores free items in segregated lists indexed by size class or not.
+ *
+ * Segregated lists make allocations and deallocations take constant time,
+ * but they take around 450 more bytes of code and the allocation strategy becomes good fit instead of best fit.
+ *
+ * If it is `false`, free items are stored in a single list sorted by address which is searched on each allocation.
+ *
+ * @ingroup allocator
+ */
+#ifndef BN_CFG_BEST_FIT_ALLOCATOR_SEGREGATED_FREE_LISTS
+    #define BN_CFG_BEST_FIT_ALLOCATOR_SEGREGATED_FREE_LISTS true
+#endif
+
 /**
  * @def BN_CFG_BEST_FIT_ALLOCATOR_SANITY_CHECK_ENABLED
  *
@@ -38,6 +38,20 @@
     #define BN_CFG_BG_BLOCKS_MAX_OVERWRITE_TILES 32
 #endif
 
+/**
+ * @def BN_CFG_BG_BLOCKS_COMPACTION_MAX_BYTES_PER_FRAME
+ *
+ * Specifies the maximum number of background VRAM bytes that can be relocated per frame
+ * when background VRAM compaction is enabled with bn::bg_tiles::set_compaction_enabled.
+ *
+ * An item bigger than this limit is relocated alone in one frame.
+ *
+ * @ingroup bg
+ */
+#ifndef BN_CFG_BG_BLOCKS_COMPACTION_MAX_BYTES_PER_FRAME
+    #define BN_CFG_BG_BLOCKS_COMPACTION_MAX_BYTES_PER_FRAME 8192
+#endif
+
 /**
  * @def BN_CFG_BG_BLOCKS_LOG_ENABLED
  *
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_CONFIG_CORE_H
+#define BN_CONFIG_CORE_H
+
+/**
+ * @file
+ * Core configuration header file.
+ *
+ * @ingroup core
+ */
+
+#include "bn_common.h"
+
+/**
+ * @def BN_CFG_CORE_PIPELINED_COMMIT
+ *
+ * Specifies if bn::core::update must return without waiting for the next V-Blank.
+ *
+ * If it's `true`, sprites, palettes, backgrounds and display registers are copied to shadow buffers
+ * at the end of bn::core::update, and they are committed to the GBA in the next V-Blank interrupt
+ * while the game logic of the next frame is already running.
+ * H-Blank effects and HDMA are committed in that interrupt too.
+ *
+ * This buys back the idle time between the end of bn::core::update and the next V-Blank for CPU bound games,
+ * at the cost of one frame of latency: bn::core::update waits until the previous commit has been done
+ * before updating the engine again.
+ *
+ * Frames with pending VRAM uploads (sprite tiles, background tiles and maps, big maps)
+ * are committed without pipelining, as they can overwrite VRAM still in use by the displayed frame.
+ *
+ * Since the commit is done in the V-Blank interrupt, the function set with bn::core::set_vblank_callback
+ * is not called during V-Blank anymore: it is called at the beginning of bn::core::update,
+ * right after waiting for the previous commit, so it can't be used to write video registers or VRAM
+ * without tearing.
+ *
+ * @ingroup core
+ */
+#ifndef BN_CFG_CORE_PIPELINED_COMMIT
+    #define BN_CFG_CORE_PIPELINED_COMMIT false
+#endif
+
+#endif
@@ -23,10 +23,56 @@
  *
  * Specifies the maximum number of active H-Blank effects.
  *
+ * It can't be greater than `16`.
+ *
+ * If the estimated cost of the active H-Blank effects is greater than the H-Blank length,
+ * effects writing adjacent 16-bit registers are merged into 32-bit writes when possible.
+ * bn::hbes::estimated_hblank_cycles can be used to check that cost.
+ *
  * @ingroup hblank_effect
  */
 #ifndef BN_CFG_HBES_MAX_ITEMS
     #define BN_CFG_HBES_MAX_ITEMS 6
 #endif
 
+/**
+ * @def BN_CFG_HBES_MAX_SPARSE_LINES
+ *
+ * Specifies the maximum number of screen lines with value changes
+ * for H-Blank effects to be committed with a sparse schedule.
+ *
+ * If the committed H-Blank effects values change in no more than this number of lines,
+ * the CPU is interrupted only before those lines (with a V-Count interrupt followed by an H-Blank one)
+ * instead of in every H-Blank.
+ *
+ * Each scheduled line requires two interrupts, so this value should be much lower than the screen height.
+ * If it's `0`, sparse schedules are disabled and H-Blank effects are always committed in every H-Blank.
+ *
+ * The IRQ dispatcher only checks V-Count interrupts if this value is not `0`,
+ * so it must be defined in both `USERFLAGS` and `USERASFLAGS`.
+ *
+ * @ingroup hblank_effect
+ */
+#ifndef BN_CFG_HBES_MAX_SPARSE_LINES
+    #define BN_CFG_HBES_MAX_SPARSE_LINES 0
+#endif
+
+/**
+ * @def BN_CFG_HBES_MAX_HDMA_ITEMS
+ *
+ * Specifies the maximum number of H-Blank effects that can be committed with HDMA instead of with H-Blank interrupts.
+ *
+ * H-Blank effects are committed with HDMA only if the required DMA channels are not used by bn::hdma
+ * or by the audio backend. Otherwise, they are committed with H-Blank interrupts.
+ *
+ * If it's `1`, only the low priority HDMA channel is used.
+ * If it's `2`, the high priority HDMA channel is used too, which can cause issues with audio.
+ * If it's `0`, H-Blank effects are always committed with H-Blank interrupts.
+ *
+ * @ingroup hblank_effect
+ */
+#ifndef BN_CFG_HBES_MAX_HDMA_ITEMS
+    #define BN_CFG_HBES_MAX_HDMA_ITEMS 0
+#endif
+
 #endif
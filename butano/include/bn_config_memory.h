@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_CONFIG_MEMORY_H
+#define BN_CONFIG_MEMORY_H
+
+/**
+ * @file
+ * Memory configuration header file.
+ *
+ * @ingroup memory
+ */
+
+#include "bn_common.h"
+
+/**
+ * @def BN_CFG_MEMORY_FRAME_IWRAM_BYTES
+ *
+ * Specifies the size in bytes of the IWRAM frame arena.
+ *
+ * It must be a multiple of 8.
+ *
+ * If it's `0`, the IWRAM frame arena is not compiled, so it doesn't waste IWRAM,
+ * and frame allocations from it always fail.
+ *
+ * @ingroup memory
+ */
+#ifndef BN_CFG_MEMORY_FRAME_IWRAM_BYTES
+    #define BN_CFG_MEMORY_FRAME_IWRAM_BYTES 0
+#endif
+
+/**
+ * @def BN_CFG_MEMORY_FRAME_EWRAM_BYTES
+ *
+ * Specifies the size in bytes of the EWRAM frame arena.
+ *
+ * It must be a multiple of 8.
+ *
+ * If it's `0`, the EWRAM frame arena is not compiled, so it doesn't waste EWRAM,
+ * and frame allocations from it always fail.
+ *
+ * @ingroup memory
+ */
+#ifndef BN_CFG_MEMORY_FRAME_EWRAM_BYTES
+    #define BN_CFG_MEMORY_FRAME_EWRAM_BYTES 0
+#endif
+
+#endif
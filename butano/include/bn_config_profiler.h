@@ -55,10 +55,52 @@
  *
  * Specifies the maximum number of code blocks that can be profiled without too many performance issues.
  *
+ * The same code block nested in different parents uses more than one entry.
+ *
  * @ingroup profiler
  */
 #ifndef BN_CFG_PROFILER_MAX_ENTRIES
     #define BN_CFG_PROFILER_MAX_ENTRIES 64
 #endif
 
+/**
+ * @def BN_CFG_PROFILER_MAX_DEPTH
+ *
+ * Specifies the maximum number of nested code blocks that can be profiled at the same time.
+ *
+ * @ingroup profiler
+ */
+#ifndef BN_CFG_PROFILER_MAX_DEPTH
+    #define BN_CFG_PROFILER_MAX_DEPTH 16
+#endif
+
+/**
+ * @def BN_CFG_PROFILER_TRACE_ENABLED
+ *
+ * Specifies if the begin and end of each profiled code block must be recorded as timestamped events
+ * and logged at the end of each bn::core::update call.
+ *
+ * Logged events can be converted to the Chrome trace format with the `butano/tools/butano_trace_tool.py` script.
+ *
+ * @ref BN_CFG_PROFILER_ENABLED and @ref BN_CFG_LOG_ENABLED must be `true` to enable events tracing.
+ *
+ * @ingroup profiler
+ */
+#ifndef BN_CFG_PROFILER_TRACE_ENABLED
+    #define BN_CFG_PROFILER_TRACE_ENABLED false
+#endif
+
+/**
+ * @def BN_CFG_PROFILER_TRACE_MAX_EVENTS
+ *
+ * Specifies the maximum number of events that can be recorded between two bn::core::update calls.
+ *
+ * Events that don't fit are dropped.
+ *
+ * @ingroup profiler
+ */
+#ifndef BN_CFG_PROFILER_TRACE_MAX_EVENTS
+    #define BN_CFG_PROFILER_TRACE_MAX_EVENTS 512
+#endif
+
 #endif
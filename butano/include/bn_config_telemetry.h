@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_CONFIG_TELEMETRY_H
+#define BN_CONFIG_TELEMETRY_H
+
+/**
+ * @file
+ * Telemetry configuration header file.
+ *
+ * @ingroup telemetry
+ */
+
+#include "bn_common.h"
+
+/**
+ * @def BN_CFG_TELEMETRY_ENABLED
+ *
+ * Specifies if telemetry is enabled or not.
+ *
+ * @ingroup telemetry
+ */
+#ifndef BN_CFG_TELEMETRY_ENABLED
+    #define BN_CFG_TELEMETRY_ENABLED false
+#endif
+
+/**
+ * @def BN_CFG_TELEMETRY_MAX_SAMPLES
+ *
+ * Specifies the maximum number of per-frame samples stored in the telemetry ring buffer.
+ *
+ * It must be a power of two.
+ *
+ * @ingroup telemetry
+ */
+#ifndef BN_CFG_TELEMETRY_MAX_SAMPLES
+    #define BN_CFG_TELEMETRY_MAX_SAMPLES 64
+#endif
+
+/**
+ * @def BN_CFG_TELEMETRY_LOG_INTERVAL
+ *
+ * Specifies every how many samples telemetry statistics must be logged (0 disables periodic logging).
+ *
+ * @ingroup telemetry
+ */
+#ifndef BN_CFG_TELEMETRY_LOG_INTERVAL
+    #define BN_CFG_TELEMETRY_LOG_INTERVAL 0
+#endif
+
+#endif
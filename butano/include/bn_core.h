@@ -178,11 +178,17 @@ namespace bn::core
 
     /**
      * @brief Returns the user function called in core::update, during V-Blank.
+     *
+     * If @ref BN_CFG_CORE_PIPELINED_COMMIT is `true`, it is called at the beginning of core::update instead,
+     * outside V-Blank.
      */
     [[nodiscard]] vblank_callback_type vblank_callback();
 
     /**
      * @brief Sets the user function called in core::update, during V-Blank.
+     *
+     * If @ref BN_CFG_CORE_PIPELINED_COMMIT is `true`, it is called at the beginning of core::update instead,
+     * outside V-Blank, since the commit is done in the V-Blank interrupt.
      */
     void set_vblank_callback(vblank_callback_type vblank_callback);
 
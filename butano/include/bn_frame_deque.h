@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_FRAME_DEQUE_H
+#define BN_FRAME_DEQUE_H
+
+/**
+ * @file
+ * bn::frame_deque implementation header file.
+ *
+ * @ingroup deque
+ */
+
+#include "bn_memory.h"
+#include "bn_deque.h"
+
+namespace bn
+{
+
+/**
+ * @brief bn::ideque which storage is allocated from a frame arena.
+ *
+ * Frame arenas are reset at the end of each bn::core::update call,
+ * so it must be destroyed before calling bn::core::update.
+ *
+ * Frame arenas are disabled by default,
+ * so BN_CFG_MEMORY_FRAME_IWRAM_BYTES or BN_CFG_MEMORY_FRAME_EWRAM_BYTES must be set before using it.
+ *
+ * @tparam Type Element type.
+ *
+ * @ingroup deque
+ */
+template<typename Type>
+class frame_deque : public ideque<Type>
+{
+    static_assert(alignof(Type) <= alignof(uint64_t));
+
+public:
+    using value_type = Type; //!< Value type alias.
+    using size_type = int; //!< Size type alias.
+    using difference_type = int; //!< Difference type alias.
+    using reference = Type&; //!< Reference alias.
+    using const_reference = const Type&; //!< Const reference alias.
+    using pointer = Type*; //!< Pointer alias.
+    using const_pointer = const Type*; //!< Const pointer alias.
+    using iterator = typename ideque<Type>::iterator; //!< Iterator alias.
+    using const_iterator = typename ideque<Type>::const_iterator; //!< Const iterator alias.
+    using reverse_iterator = typename ideque<Type>::reverse_iterator; //!< Reverse iterator alias.
+    using const_reverse_iterator = typename ideque<Type>::const_reverse_iterator; //!< Const reverse iterator alias.
+
+    /**
+     * @brief Constructor.
+     * @param max_size Maximum number of elements that can be stored (it must be a power of two).
+     * @param iwram Indicates if the storage must be allocated from the IWRAM frame arena
+     * instead of the EWRAM one.
+     */
+    explicit frame_deque(size_type max_size, bool iwram = false) :
+        ideque<Type>(_storage(max_size, iwram), max_size)
+    {
+    }
+
+    frame_deque(const frame_deque& other) = delete;
+
+    /**
+     * @brief Destructor.
+     */
+    ~frame_deque() noexcept
+    {
+        _bn::memory::frame_container_free();
+    }
+
+    using ideque<Type>::operator=;
+
+private:
+    [[nodiscard]] static reference _storage(size_type max_size, bool iwram)
+    {
+        BN_ASSERT(max_size > 0 && power_of_two(max_size), "Invalid max size: ", max_size);
+
+        void* storage = _bn::memory::frame_container_alloc(max_size * int(sizeof(Type)), iwram);
+        return *static_cast<pointer>(storage);
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_FRAME_VECTOR_H
+#define BN_FRAME_VECTOR_H
+
+/**
+ * @file
+ * bn::frame_vector implementation header file.
+ *
+ * @ingroup vector
+ */
+
+#include "bn_memory.h"
+#include "bn_vector.h"
+
+namespace bn
+{
+
+/**
+ * @brief bn::ivector which storage is allocated from a frame arena.
+ *
+ * Frame arenas are reset at the end of each bn::core::update call,
+ * so it must be destroyed before calling bn::core::update.
+ *
+ * Frame arenas are disabled by default,
+ * so BN_CFG_MEMORY_FRAME_IWRAM_BYTES or BN_CFG_MEMORY_FRAME_EWRAM_BYTES must be set before using it.
+ *
+ * @tparam Type Element type.
+ *
+ * @ingroup vector
+ */
+template<typename Type>
+class frame_vector : public ivector<Type>
+{
+    static_assert(alignof(Type) <= alignof(uint64_t));
+
+public:
+    using value_type = Type; //!< Value type alias.
+    using size_type = int; //!< Size type alias.
+    using difference_type = int; //!< Difference type alias.
+    using reference = Type&; //!< Reference alias.
+    using const_reference = const Type&; //!< Const reference alias.
+    using pointer = Type*; //!< Pointer alias.
+    using const_pointer = const Type*; //!< Const pointer alias.
+    using iterator = Type*; //!< Iterator alias.
+    using const_iterator = const Type*; //!< Const iterator alias.
+    using reverse_iterator = bn::reverse_iterator<iterator>; //!< Reverse iterator alias.
+    using const_reverse_iterator = bn::reverse_iterator<const_iterator>; //!< Const reverse iterator alias.
+
+    /**
+     * @brief Constructor.
+     * @param max_size Maximum number of elements that can be stored.
+     * @param iwram Indicates if the storage must be allocated from the IWRAM frame arena
+     * instead of the EWRAM one.
+     */
+    explicit frame_vector(size_type max_size, bool iwram = false) :
+        ivector<Type>(_storage(max_size, iwram), max_size)
+    {
+    }
+
+    frame_vector(const frame_vector& other) = delete;
+
+    /**
+     * @brief Destructor.
+     */
+    ~frame_vector() noexcept
+    {
+        _bn::memory::frame_container_free();
+    }
+
+    using ivector<Type>::operator=;
+
+private:
+    [[nodiscard]] static reference _storage(size_type max_size, bool iwram)
+    {
+        BN_ASSERT(max_size > 0, "Invalid max size: ", max_size);
+
+        void* storage = _bn::memory::frame_container_alloc(max_size * int(sizeof(Type)), iwram);
+        return *static_cast<pointer>(storage);
+    }
+};
+
+}
+
+#endif
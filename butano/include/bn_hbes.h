@@ -31,6 +31,15 @@ namespace bn::hbes
      * @brief Returns the number of available H-Blank effects that can be created.
      */
     [[nodiscard]] int available_count();
+
+    /**
+     * @brief Returns a rough estimate of the CPU cycles spent in the slowest H-Blank interrupt
+     * to commit the active H-Blank effects.
+     *
+     * If it's greater than 272 (the H-Blank length), some H-Blank effects values can be written too late,
+     * showing graphical glitches.
+     */
+    [[nodiscard]] int estimated_hblank_cycles();
 }
 
 #endif
@@ -38,6 +38,9 @@ namespace bn::hdma
      *
      * If the elements overlap, the behavior is undefined.
      *
+     * If an H-Blank effect is committed with this HDMA channel (see @ref BN_CFG_HBES_MAX_HDMA_ITEMS),
+     * it is committed with H-Blank interrupts again in the next update.
+     *
      * @param source_ref Const reference to the memory location to copy from.
      * It must refer to a multiple of bn::display::height() values.
      * @param destination_ref Reference to the memory location to copy to.
@@ -74,6 +77,9 @@ namespace bn::hdma
      *
      * High priority HDMA can cause issues with audio, so avoid it unless necessary.
      *
+     * If an H-Blank effect is committed with this HDMA channel (see @ref BN_CFG_HBES_MAX_HDMA_ITEMS),
+     * it is committed with H-Blank interrupts again in the next update.
+     *
      * @param source_ref Const reference to the memory location to copy from.
      * It must refer to a multiple of bn::display::height() values.
      * @param destination_ref Reference to the memory location to copy to.
@@ -46,6 +46,10 @@ namespace _bn::memory
     void unsafe_set_half_words(uint16_t value, int half_words, void* destination);
 
     void unsafe_set_words(unsigned value, int words, void* destination);
+
+    [[nodiscard]] void* frame_container_alloc(int bytes, bool iwram);
+
+    void frame_container_free();
 }
 
 /// @endcond
@@ -128,6 +132,64 @@ namespace bn::memory
      */
     void log_alloc_ewram_status();
 
+    /**
+     * @brief Allocates uninitialized storage in the IWRAM frame arena.
+     *
+     * The frame arena is reset at the end of each bn::core::update call,
+     * so the returned storage must not be used after it.
+     *
+     * The IWRAM frame arena is disabled by default (see BN_CFG_MEMORY_FRAME_IWRAM_BYTES).
+     *
+     * @param bytes Bytes to allocate.
+     * @return On success, returns the pointer to the beginning of newly allocated memory.
+     * On failure, returns `nullptr`.
+     */
+    [[nodiscard]] void* frame_iwram_alloc(int bytes);
+
+    /**
+     * @brief Allocates uninitialized storage in the EWRAM frame arena.
+     *
+     * The frame arena is reset at the end of each bn::core::update call,
+     * so the returned storage must not be used after it.
+     *
+     * The EWRAM frame arena is disabled by default (see BN_CFG_MEMORY_FRAME_EWRAM_BYTES).
+     *
+     * @param bytes Bytes to allocate.
+     * @return On success, returns the pointer to the beginning of newly allocated memory.
+     * On failure, returns `nullptr`.
+     */
+    [[nodiscard]] void* frame_ewram_alloc(int bytes);
+
+    /**
+     * @brief Returns the size in bytes of all allocated items in the IWRAM frame arena in the current frame.
+     */
+    [[nodiscard]] int used_frame_iwram();
+
+    /**
+     * @brief Returns the number of bytes that still can be allocated in the IWRAM frame arena in the current frame.
+     */
+    [[nodiscard]] int available_frame_iwram();
+
+    /**
+     * @brief Returns the maximum number of bytes allocated in the IWRAM frame arena in a single frame.
+     */
+    [[nodiscard]] int max_used_frame_iwram();
+
+    /**
+     * @brief Returns the size in bytes of all allocated items in the EWRAM frame arena in the current frame.
+     */
+    [[nodiscard]] int used_frame_ewram();
+
+    /**
+     * @brief Returns the number of bytes that still can be allocated in the EWRAM frame arena in the current frame.
+     */
+    [[nodiscard]] int available_frame_ewram();
+
+    /**
+     * @brief Returns the maximum number of bytes allocated in the EWRAM frame arena in a single frame.
+     */
+    [[nodiscard]] int max_used_frame_ewram();
+
     /**
      * @brief Returns the number of bytes of IWRAM used by the stack.
      */
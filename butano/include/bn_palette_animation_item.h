@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_PALETTE_ANIMATION_ITEM_H
+#define BN_PALETTE_ANIMATION_ITEM_H
+
+/**
+ * @file
+ * bn::palette_animation_item header file.
+ *
+ * @ingroup palette
+ * @ingroup tool
+ */
+
+#include "bn_span.h"
+#include "bn_color.h"
+
+namespace bn
+{
+
+/**
+ * @brief Contains the required information to animate the colors of a color palette without game code intervention.
+ *
+ * The assets conversion tools generate an object of this type in the build folder for each *.bmp file
+ * with `palette_animation` type.
+ *
+ * Keyframes are interpolated by the assets conversion tools, so each frame only stores the range of colors
+ * which has changed since the previous frame.
+ *
+ * The colors and the frames are not copied but referenced, so they should outlive the palette_animation_item
+ * to avoid dangling references.
+ *
+ * @ingroup palette
+ * @ingroup tool
+ */
+class palette_animation_item
+{
+
+public:
+    /**
+     * @brief Range of colors updated in a frame of a palette animation.
+     *
+     * @ingroup palette
+     * @ingroup tool
+     */
+    class frame
+    {
+
+    public:
+        uint16_t colors_offset; //!< Index of the first color of this frame in the colors array.
+        uint8_t first_color_index; //!< Index of the first palette color updated by this frame.
+        uint8_t colors_count; //!< Number of palette colors updated by this frame.
+
+        /**
+         * @brief Default equal operator.
+         */
+        [[nodiscard]] constexpr friend bool operator==(const frame& a, const frame& b) = default;
+    };
+
+    /**
+     * @brief Constructor.
+     * @param colors_ref Reference to the array of colors updated by all frames.
+     *
+     * The colors are not copied but referenced, so they should outlive the palette_animation_item
+     * to avoid dangling references.
+     *
+     * @param frames_ref Reference to the array of frames.
+     * The first one contains the colors of the first keyframe.
+     *
+     * If the animation loops, the last one goes back to the first keyframe.
+     *
+     * The frames are not copied but referenced, so they should outlive the palette_animation_item
+     * to avoid dangling references.
+     *
+     * @param loop Indicates if the animation must be played forever or not.
+     */
+    constexpr palette_animation_item(const span<const color>& colors_ref, const span<const frame>& frames_ref,
+                                     bool loop) :
+        _colors_ref(colors_ref),
+        _frames_ref(frames_ref),
+        _loop(loop)
+    {
+        BN_ASSERT(! frames_ref.empty() && frames_ref.size() <= 32767,
+                  "Invalid frames count: ", frames_ref.size());
+    }
+
+    /**
+     * @brief Returns the referenced array of colors updated by all frames.
+     *
+     * The colors are not copied but referenced, so they should outlive the palette_animation_item
+     * to avoid dangling references.
+     */
+    [[nodiscard]] constexpr const span<const color>& colors_ref() const
+    {
+        return _colors_ref;
+    }
+
+    /**
+     * @brief Returns the referenced array of frames.
+     *
+     * The frames are not copied but referenced, so they should outlive the palette_animation_item
+     * to avoid dangling references.
+     */
+    [[nodiscard]] constexpr const span<const frame>& frames_ref() const
+    {
+        return _frames_ref;
+    }
+
+    /**
+     * @brief Indicates if the animation must be played forever or not.
+     */
+    [[nodiscard]] constexpr bool loop() const
+    {
+        return _loop;
+    }
+
+    /**
+     * @brief Default equal operator.
+     */
+    [[nodiscard]] constexpr friend bool operator==(const palette_animation_item& a,
+                                                   const palette_animation_item& b) = default;
+
+private:
+    span<const color> _colors_ref;
+    span<const frame> _frames_ref;
+    bool _loop;
+};
+
+}
+
+#endif
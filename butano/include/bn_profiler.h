@@ -13,6 +13,7 @@
  * @ingroup profiler
  */
 
+#include "bn_config_assert.h"
 #include "bn_config_doxygen.h"
 #include "bn_config_profiler.h"
 
@@ -21,6 +22,15 @@
  *
  * Defines the start of a code block in which elapsed time is going to be measured.
  *
+ * Code blocks can be nested: each one is measured separately for each parent code block.
+ *
+ * Each call site is assigned to a fixed slot the first time it is executed,
+ * so it must be used inside a function.
+ *
+ * Since the slot is assigned only once, a call site must always use the same id:
+ * if the id is not a literal and it changes, its code block is still measured with the first id.
+ * If asserts are enabled, using a different id at the same call site stops the execution.
+ *
  * @param id Small text string which identifies the code block.
  *
  * @ingroup profiler
@@ -29,7 +39,20 @@
 /**
  * @def BN_PROFILER_STOP
  *
- * Defines the end of a code block in which elapsed time is going to be measured.
+ * Defines the end of the last started code block in which elapsed time is going to be measured.
+ *
+ * @ingroup profiler
+ */
+
+/**
+ * @def BN_PROFILER_COUNT
+ *
+ * Adds the given value to a counter instead of measuring elapsed time.
+ *
+ * Counters are shown separately from elapsed time measures.
+ *
+ * @param id Small text string which identifies the counter.
+ * @param count Value to add to the counter.
  *
  * @ingroup profiler
  */
@@ -43,6 +66,7 @@
  */
 
 #if BN_CFG_PROFILER_ENABLED || BN_DOXYGEN
+    #include "bn_span_fwd.h"
     #include "bn_unordered_map_fwd.h"
 
     /**
@@ -54,8 +78,18 @@
     {
         /**
          * @brief Stops the execution and shows the profiling results on the screen.
+         *
+         * Code blocks are shown as a tree (each child below its parent), with their total, self and max ticks.
          */
         [[noreturn]] void show();
+
+        /**
+         * @brief Logs the profiling results.
+         *
+         * Each line contains the path of a code block from the root (ids separated by semicolons)
+         * followed by its self ticks, so it can be used as input of flame graph generators.
+         */
+        void log();
     }
 
     /// @cond DO_NOT_DOCUMENT
@@ -68,25 +102,74 @@
             int max = 0;
         };
 
+        struct node
+        {
+            const char* id = nullptr;
+            int parent = -1;
+            int first_child = -1;
+            int next_sibling = -1;
+            int slot = -1;
+            int calls = 0;
+            int max_ticks = 0;
+            int64_t total_ticks = 0;
+            int64_t children_ticks = 0;
+
+            [[nodiscard]] int64_t self_ticks() const
+            {
+                return total_ticks - children_ticks;
+            }
+        };
+
         using ticks_map = bn::unordered_map<const char*, ticks, BN_CFG_PROFILER_MAX_ENTRIES * 2>;
 
-        void start(const char* id, unsigned id_hash);
+        [[nodiscard]] int slot(const char* id);
+
+        #if BN_CFG_ASSERT_ENABLED
+            void check_slot(int slot, const char* id);
+        #endif
+
+        void start(int slot);
 
         void stop();
 
-        [[nodiscard]] const ticks_map& ticks_per_entry();
+        void add_count(const char* id, unsigned id_hash, int count);
+
+        [[nodiscard]] bn::span<const node> nodes();
+
+        [[nodiscard]] const ticks_map& counts_per_entry();
 
         void reset();
+
+        #if BN_CFG_PROFILER_TRACE_ENABLED
+            void flush_trace();
+        #endif
     }
 
     /// @endcond
 
-    #define BN_PROFILER_START(id) \
-        _bn::profiler::start(id, bn::hash<const char*>()(id))
+    #if BN_CFG_ASSERT_ENABLED
+        #define BN_PROFILER_START(id) \
+            do \
+            { \
+                static const int _bn_profiler_slot = _bn::profiler::slot(id); \
+                _bn::profiler::check_slot(_bn_profiler_slot, id); \
+                _bn::profiler::start(_bn_profiler_slot); \
+            } while(false)
+    #else
+        #define BN_PROFILER_START(id) \
+            do \
+            { \
+                static const int _bn_profiler_slot = _bn::profiler::slot(id); \
+                _bn::profiler::start(_bn_profiler_slot); \
+            } while(false)
+    #endif
 
     #define BN_PROFILER_STOP() \
         _bn::profiler::stop()
 
+    #define BN_PROFILER_COUNT(id, count) \
+        _bn::profiler::add_count(id, bn::hash<const char*>()(id), count)
+
     #define BN_PROFILER_RESET() \
         _bn::profiler::reset()
 #else
@@ -100,6 +183,11 @@
         { \
         } while(false)
 
+    #define BN_PROFILER_COUNT(id, count) \
+        do \
+        { \
+        } while(false)
+
     #define BN_PROFILER_RESET() \
         do \
         { \
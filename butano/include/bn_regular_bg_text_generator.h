@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_REGULAR_BG_TEXT_GENERATOR_H
+#define BN_REGULAR_BG_TEXT_GENERATOR_H
+
+/**
+ * @file
+ * bn::regular_bg_text_generator header file.
+ *
+ * @ingroup regular_bg
+ * @ingroup text
+ */
+
+#include "bn_size.h"
+#include "bn_point.h"
+#include "bn_sprite_font.h"
+#include "bn_string_view.h"
+#include "bn_regular_bg_map_ptr.h"
+#include "bn_regular_bg_tiles_ptr.h"
+
+namespace bn
+{
+
+class bg_palette_item;
+
+/**
+ * @brief Draws text from a given sprite_font in the map of a regular background, so no sprites are used.
+ *
+ * Fixed width fonts without space between characters are drawn by pointing map cells to the font tiles.
+ *
+ * Variable width fonts and fonts with space between characters are drawn on a tile canvas,
+ * with one unique tile per text area cell.
+ *
+ * Currently, it supports 4 bits per pixel (16 colors) characters only.
+ *
+ * Also, UTF-8 characters are supported.
+ *
+ * @ingroup regular_bg
+ * @ingroup text
+ */
+class regular_bg_text_generator
+{
+
+public:
+    /**
+     * @brief Constructor.
+     *
+     * The size of the text area is the size of the screen in map cells.
+     *
+     * @param font Sprite font for drawing text.
+     */
+    explicit regular_bg_text_generator(const sprite_font& font);
+
+    /**
+     * @brief Constructor.
+     * @param font Sprite font for drawing text.
+     * @param dimensions Size in map cells of the text area.
+     */
+    regular_bg_text_generator(const sprite_font& font, const size& dimensions);
+
+    /**
+     * @brief Constructor.
+     * @param font Sprite font for drawing text.
+     * @param dimensions Size in map cells of the text area.
+     * @param palette_item Color palette used to draw text.
+     */
+    regular_bg_text_generator(const sprite_font& font, const size& dimensions, const bg_palette_item& palette_item);
+
+    /**
+     * @brief Returns the sprite font for drawing text.
+     */
+    [[nodiscard]] const sprite_font& font() const
+    {
+        return _font;
+    }
+
+    /**
+     * @brief Returns the size in map cells of the text area.
+     */
+    [[nodiscard]] const size& dimensions() const
+    {
+        return _dimensions;
+    }
+
+    /**
+     * @brief Indicates if text is drawn on a tile canvas or by pointing map cells to the font tiles.
+     */
+    [[nodiscard]] bool canvas() const
+    {
+        return _canvas;
+    }
+
+    /**
+     * @brief Returns the map in which text is drawn.
+     *
+     * Its size is 32x32 map cells and the text area is centered in it,
+     * so if the text area has the size of the screen and a regular_bg_ptr is created with this map at (0, 0),
+     * the top-left corner of the text area is the top-left corner of the screen.
+     */
+    [[nodiscard]] const regular_bg_map_ptr& map() const
+    {
+        return _map;
+    }
+
+    /**
+     * @brief Returns the width in pixels of the given single line of text.
+     */
+    [[nodiscard]] int width(const string_view& text) const;
+
+    /**
+     * @brief Draws the given single line of text.
+     *
+     * Only the cells covered by the text are updated.
+     *
+     * @param cell Position in map cells of the top-left corner of the text, relative to the text area.
+     * @param text Single line of text to draw.
+     */
+    void generate(const point& cell, const string_view& text);
+
+    /**
+     * @brief Replaces a single line of text previously drawn with the given one.
+     *
+     * Only the cells from the first character that differs between both texts to the end of the longest one
+     * are updated, so modifying a few characters of a long text is cheap.
+     *
+     * @param cell Position in map cells of the top-left corner of the text, relative to the text area.
+     * @param old_text Single line of text previously drawn at the given position.
+     * @param new_text Single line of text to draw.
+     */
+    void update(const point& cell, const string_view& old_text, const string_view& new_text);
+
+    /**
+     * @brief Clears the given region of the text area.
+     * @param cell Position in map cells of the top-left corner of the region to clear,
+     * relative to the text area.
+     * @param dimensions Size in map cells of the region to clear.
+     */
+    void clear(const point& cell, const size& dimensions);
+
+    /**
+     * @brief Clears the whole text area.
+     */
+    void clear();
+
+private:
+    sprite_font _font;
+    size _dimensions;
+    int8_t _character_columns;
+    int8_t _character_rows;
+    bool _canvas;
+    regular_bg_tiles_ptr _tiles;
+    regular_bg_map_ptr _map;
+
+    void _update(const point& cell, int dirty_width, int old_width, const string_view& new_text);
+};
+
+}
+
+#endif
@@ -17,6 +17,7 @@
 
 #include "bn_array.h"
 #include "bn_vector.h"
+#include "bn_optional.h"
 #include "bn_sprite_ptr.h"
 #include "bn_sprite_tiles_ptr.h"
 #include "bn_sprite_tiles_item.h"
@@ -964,6 +965,412 @@ template<typename ...Args>
                 array<uint16_t, sizeof...(Args)>{{ uint16_t(graphics_indexes)... }});
 }
 
+
+// animation group
+
+/**
+ * @brief Base class of bn::sprite_animate_group.
+ *
+ * Can be used as a reference type for all bn::sprite_animate_group objects.
+ *
+ * @ingroup sprite
+ * @ingroup tile
+ * @ingroup action
+ */
+class isprite_animate_group
+{
+
+public:
+    isprite_animate_group(const isprite_animate_group& other) = delete;
+
+    /**
+     * @brief Copy assignment operator.
+     * @param other isprite_animate_group to copy.
+     * @return Reference to this.
+     */
+    isprite_animate_group& operator=(const isprite_animate_group& other);
+
+    /**
+     * @brief Move assignment operator.
+     * @param other isprite_animate_group to move.
+     * @return Reference to this.
+     */
+    isprite_animate_group& operator=(isprite_animate_group&& other) noexcept;
+
+    /**
+     * @brief Changes the tile set of the sprites of the group when the given amount of update calls are done.
+     */
+    void update();
+
+    /**
+     * @brief Indicates if the group must not be updated anymore.
+     */
+    [[nodiscard]] bool done() const
+    {
+        return _current_graphics_indexes_index == _graphics_indexes_ref->size();
+    }
+
+    /**
+     * @brief Resets the group to its initial state.
+     */
+    void reset()
+    {
+        _current_graphics_indexes_index = 0;
+        _current_wait_updates = 0;
+    }
+
+    /**
+     * @brief Returns the sprites of the group.
+     */
+    [[nodiscard]] const ivector<sprite_ptr>& sprites() const
+    {
+        return *_sprites_ref;
+    }
+
+    /**
+     * @brief Adds a sprite to the group.
+     *
+     * If the group has been updated before, the current tile set of the group is assigned to the given sprite.
+     *
+     * The group stores a copy of the given sprite_ptr, which references the same sprite,
+     * so the sprite is not destroyed until it is removed from the group and no other sprite_ptr references it.
+     * Tile sets assigned by the group are shown by all sprite_ptr objects which reference the sprite.
+     *
+     * @param sprite sprite_ptr to copy.
+     */
+    void add_sprite(const sprite_ptr& sprite);
+
+    /**
+     * @brief Adds a sprite to the group.
+     *
+     * If the group has been updated before, the current tile set of the group is assigned to the given sprite.
+     *
+     * The group takes the ownership of the given sprite_ptr,
+     * so the sprite is destroyed when it is removed from the group if no other sprite_ptr references it.
+     *
+     * @param sprite sprite_ptr to move.
+     */
+    void add_sprite(sprite_ptr&& sprite);
+
+    /**
+     * @brief Removes the given sprite from the group.
+     *
+     * The sprite_ptr stored by the group is released, but the tile set assigned to the sprite is kept.
+     *
+     * @param sprite sprite_ptr to remove.
+     * @return `true` if the sprite has been removed; `false` otherwise.
+     */
+    bool remove_sprite(const sprite_ptr& sprite);
+
+    /**
+     * @brief Removes all sprites from the group.
+     */
+    void clear_sprites()
+    {
+        _sprites_ref->clear();
+    }
+
+    /**
+     * @brief Returns the number of times the group must be updated before changing the tiles of its sprites.
+     */
+    [[nodiscard]] int wait_updates() const
+    {
+        return _wait_updates;
+    }
+
+    /**
+     * @brief Sets the number of times the group must be updated before changing the tiles of its sprites.
+     */
+    void set_wait_updates(int wait_updates);
+
+    /**
+     * @brief Returns the number of times the group must be updated before the next tiles change.
+     */
+    [[nodiscard]] int next_change_updates() const
+    {
+        return _current_wait_updates;
+    }
+
+    /**
+     * @brief Sets the number of times the group must be updated before the next tiles change.
+     */
+    void set_next_change_updates(int next_change_updates);
+
+    /**
+     * @brief Returns the sprite_tiles_item used to create the new sprite tiles to use by the sprites of the group.
+     */
+    [[nodiscard]] const sprite_tiles_item& tiles_item() const
+    {
+        return *_tiles_item_ref;
+    }
+
+    /**
+     * @brief Returns the indexes of the tile sets to reference in the given sprite_tiles_item.
+     */
+    [[nodiscard]] const ivector<uint16_t>& graphics_indexes() const
+    {
+        return *_graphics_indexes_ref;
+    }
+
+    /**
+     * @brief Returns the tile set currently shared by the sprites of the group, if any.
+     */
+    [[nodiscard]] const optional<sprite_tiles_ptr>& tiles() const
+    {
+        return _tiles;
+    }
+
+    /**
+     * @brief Indicates if the group can be updated forever or not.
+     */
+    [[nodiscard]] bool update_forever() const
+    {
+        return _forever;
+    }
+
+    /**
+     * @brief Returns the current index of the given graphics_indexes
+     * (not the current index of the tile set to reference in the given tiles_item).
+     */
+    [[nodiscard]] int current_index() const
+    {
+        return _current_graphics_indexes_index;
+    }
+
+    /**
+     * @brief Sets the current index of the given graphics_indexes
+     * (not the current index of the tile set to reference in the given tiles_item).
+     */
+    void set_current_index(int current_index);
+
+    /**
+     * @brief Returns the current index of the tile set to reference in the given tiles_item.
+     */
+    [[nodiscard]] int current_graphics_index() const
+    {
+        return graphics_indexes()[_current_graphics_indexes_index];
+    }
+
+protected:
+    /// @cond DO_NOT_DOCUMENT
+
+    isprite_animate_group() = default;
+
+    void _set_refs(ivector<sprite_ptr>& sprites, sprite_tiles_item& tiles_item, ivector<uint16_t>& graphics_indexes);
+
+    void _assign(const isprite_animate_group& other);
+
+    void _set_update_forever(bool forever)
+    {
+        _forever = forever;
+    }
+
+    void _assign_graphics_indexes(const span<const uint16_t>& graphics_indexes);
+
+    /// @endcond
+
+private:
+    ivector<sprite_ptr>* _sprites_ref = nullptr;
+    sprite_tiles_item* _tiles_item_ref = nullptr;
+    ivector<uint16_t>* _graphics_indexes_ref = nullptr;
+    optional<sprite_tiles_ptr> _tiles;
+    uint16_t _wait_updates = 0;
+    uint16_t _current_graphics_indexes_index = 0;
+    uint16_t _current_wait_updates = 0;
+    bool _forever = true;
+
+    void _set_tiles(int graphics_index);
+};
+
+/**
+ * @brief Changes the tile set of a group of sprites when the group is updated a given number of times.
+ *
+ * This class differs from sprite_animate_action in that all sprites of the group share the same clock
+ * and the same tile set, so each tiles change searches for and creates a single tile set for all of them.
+ *
+ * It is useful to animate many sprites which always show the same tile set at the same time.
+ *
+ * The group stores its own sprite_ptr copies, so its sprites are kept alive while they belong to it,
+ * even if the original sprite_ptr objects are destroyed.
+ *
+ * @tparam MaxSize Maximum number of indexes to sprite tile sets to store.
+ * @tparam MaxSprites Maximum number of sprites to animate.
+ *
+ * @ingroup sprite
+ * @ingroup tile
+ * @ingroup action
+ */
+template<int MaxSize, int MaxSprites>
+class sprite_animate_group : public isprite_animate_group
+{
+    static_assert(MaxSize > 1);
+    static_assert(MaxSprites > 0);
+
+public:
+    /**
+     * @brief Generates a sprite_animate_group which loops over the given sprite tile sets only once.
+     * @param wait_updates Number of times the group must be updated before changing the tiles of its sprites.
+     * @param tiles_item It creates the new sprite tiles to use by the sprites of the group.
+     * @param graphics_indexes Indexes of the tile sets to reference in tiles_item.
+     * @return The requested sprite_animate_group.
+     */
+    [[nodiscard]] static sprite_animate_group once(
+            int wait_updates, const sprite_tiles_item& tiles_item, const span<const uint16_t>& graphics_indexes)
+    {
+        return sprite_animate_group(wait_updates, tiles_item, false, graphics_indexes);
+    }
+
+    /**
+     * @brief Generates a sprite_animate_group which loops over the given sprite tile sets forever.
+     * @param wait_updates Number of times the group must be updated before changing the tiles of its sprites.
+     * @param tiles_item It creates the new sprite tiles to use by the sprites of the group.
+     * @param graphics_indexes Indexes of the tile sets to reference in tiles_item.
+     * @return The requested sprite_animate_group.
+     */
+    [[nodiscard]] static sprite_animate_group forever(
+            int wait_updates, const sprite_tiles_item& tiles_item, const span<const uint16_t>& graphics_indexes)
+    {
+        return sprite_animate_group(wait_updates, tiles_item, true, graphics_indexes);
+    }
+
+    /**
+     * @brief Copy constructor.
+     * @param other sprite_animate_group to copy.
+     */
+    sprite_animate_group(const sprite_animate_group& other) :
+        _sprites(other._sprites),
+        _tiles_item(other._tiles_item),
+        _graphics_indexes(other._graphics_indexes)
+    {
+        this->_set_refs(_sprites, _tiles_item, _graphics_indexes);
+        this->_assign(other);
+    }
+
+    /**
+     * @brief Move constructor.
+     * @param other sprite_animate_group to move.
+     */
+    sprite_animate_group(sprite_animate_group&& other) noexcept :
+        _sprites(move(other._sprites)),
+        _tiles_item(other._tiles_item),
+        _graphics_indexes(other._graphics_indexes)
+    {
+        this->_set_refs(_sprites, _tiles_item, _graphics_indexes);
+        this->_assign(other);
+    }
+
+    /**
+     * @brief Copy assignment operator.
+     * @param other sprite_animate_group to copy.
+     * @return Reference to this.
+     */
+    sprite_animate_group& operator=(const sprite_animate_group& other)
+    {
+        if(this != &other)
+        {
+            _sprites = other._sprites;
+            _tiles_item = other._tiles_item;
+            _graphics_indexes = other._graphics_indexes;
+            this->_assign(other);
+        }
+
+        return *this;
+    }
+
+    /**
+     * @brief Move assignment operator.
+     * @param other sprite_animate_group to move.
+     * @return Reference to this.
+     */
+    sprite_animate_group& operator=(sprite_animate_group&& other) noexcept
+    {
+        if(this != &other)
+        {
+            _sprites = move(other._sprites);
+            _tiles_item = other._tiles_item;
+            _graphics_indexes = other._graphics_indexes;
+            this->_assign(other);
+        }
+
+        return *this;
+    }
+
+    /**
+     * @brief Copy assignment operator.
+     * @param other isprite_animate_group to copy.
+     * @return Reference to this.
+     */
+    sprite_animate_group& operator=(const isprite_animate_group& other)
+    {
+        static_cast<isprite_animate_group&>(*this) = other;
+        return *this;
+    }
+
+    /**
+     * @brief Move assignment operator.
+     * @param other isprite_animate_group to move.
+     * @return Reference to this.
+     */
+    sprite_animate_group& operator=(isprite_animate_group&& other) noexcept
+    {
+        static_cast<isprite_animate_group&>(*this) = move(other);
+        return *this;
+    }
+
+private:
+    vector<sprite_ptr, MaxSprites> _sprites;
+    sprite_tiles_item _tiles_item;
+    vector<uint16_t, MaxSize> _graphics_indexes;
+
+    sprite_animate_group(int wait_updates, const sprite_tiles_item& tiles_item, bool forever,
+                         const span<const uint16_t>& graphics_indexes) :
+        _tiles_item(tiles_item)
+    {
+        this->_set_refs(_sprites, _tiles_item, _graphics_indexes);
+        this->_set_update_forever(forever);
+        this->set_wait_updates(wait_updates);
+        this->_assign_graphics_indexes(graphics_indexes);
+    }
+};
+
+
+/**
+ * @brief Generates a sprite_animate_group which loops over the given sprite tile sets only once.
+ * @tparam MaxSprites Maximum number of sprites to animate.
+ * @param wait_updates Number of times the group must be updated before changing the tiles of its sprites.
+ * @param tiles_item It creates the new sprite tiles to use by the sprites of the group.
+ * @param graphics_indexes Indexes of the tile sets to reference in tiles_item.
+ * @return The requested sprite_animate_group.
+ *
+ * @ingroup sprite
+ */
+template<int MaxSprites, typename ...Args>
+[[nodiscard]] auto create_sprite_animate_group_once(
+        int wait_updates, const sprite_tiles_item& tiles_item, Args ...graphics_indexes)
+{
+    return sprite_animate_group<sizeof...(Args), MaxSprites>::once(
+                wait_updates, tiles_item, array<uint16_t, sizeof...(Args)>{{ uint16_t(graphics_indexes)... }});
+}
+
+
+/**
+ * @brief Generates a sprite_animate_group which loops over the given sprite tile sets forever.
+ * @tparam MaxSprites Maximum number of sprites to animate.
+ * @param wait_updates Number of times the group must be updated before changing the tiles of its sprites.
+ * @param tiles_item It creates the new sprite tiles to use by the sprites of the group.
+ * @param graphics_indexes Indexes of the tile sets to reference in tiles_item.
+ * @return The requested sprite_animate_group.
+ *
+ * @ingroup sprite
+ */
+template<int MaxSprites, typename ...Args>
+[[nodiscard]] auto create_sprite_animate_group_forever(
+        int wait_updates, const sprite_tiles_item& tiles_item, Args ...graphics_indexes)
+{
+    return sprite_animate_group<sizeof...(Args), MaxSprites>::forever(
+                wait_updates, tiles_item, array<uint16_t, sizeof...(Args)>{{ uint16_t(graphics_indexes)... }});
+}
+
 }
 
 #endif
@@ -29,6 +29,12 @@ namespace bn
      * Each time the tile set of a sprite_ptr must be changed, it is searched for and created if it has not been found,
      * so the tile sets are not cached.
      *
+     * If it has not been found and the current tile set is used by the sprite_ptr alone,
+     * the new one is copied to the VRAM slot of the current one in the next core::update call,
+     * so each sprite_ptr takes the VRAM of a single tile set.
+     *
+     * Sprites showing the same tile set share it.
+     *
      * @tparam MaxSize Maximum number of indexes to sprite tile sets to store.
      *
      * @ingroup sprite
@@ -57,6 +63,14 @@ namespace bn
      */
     template<int MaxSize>
     class sprite_cached_animate_action;
+
+
+    // animation group
+
+    class isprite_animate_group;
+
+    template<int MaxSize, int MaxSprites>
+    class sprite_animate_group;
 }
 
 #endif
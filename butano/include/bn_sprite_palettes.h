@@ -143,6 +143,21 @@ namespace bn::sprite_palettes
      */
     void reload_custom_effect();
 
+    /**
+     * @brief Merges identical BPP4 sprite color palettes and moves them to make room for new ones.
+     *
+     * Only color palettes referenced by sprites alone (not by other smart pointers or H-Blank effects)
+     * are merged or moved.
+     *
+     * A color palette which is a subset of another one is not merged into it,
+     * since it is not known which colors are used by the tiles of each sprite.
+     *
+     * It is called automatically when a sprite color palette can't be created.
+     *
+     * @return `true` if any color palette has been merged or moved; `false` otherwise.
+     */
+    bool repack();
+
     /**
      * @brief Logs the current status of the sprite color palettes manager.
      */
@@ -353,6 +353,9 @@ public:
      * Before creating a new sprite tile set, the sprite_tiles_ptr used by this sprite is removed,
      * so VRAM usage is reduced.
      *
+     * If the sprite_tiles_ptr used by this sprite is not referenced anywhere else,
+     * the new tiles are copied to its VRAM slot in the next core::update call instead of creating a new one.
+     *
      * The new sprite tiles must be compatible with the current color palette, shape and size of the sprite.
      *
      * @param tiles_item It creates the sprite tiles to use by this sprite.
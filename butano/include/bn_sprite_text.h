@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_SPRITE_TEXT_H
+#define BN_SPRITE_TEXT_H
+
+/**
+ * @file
+ * bn::isprite_text and bn::sprite_text implementation header file.
+ *
+ * @ingroup sprite
+ * @ingroup text
+ */
+
+#include "bn_string.h"
+#include "bn_vector.h"
+#include "bn_sprite_ptr.h"
+#include "bn_fixed_point.h"
+
+namespace bn
+{
+
+class sprite_text_generator;
+
+/**
+ * @brief Base class of bn::sprite_text.
+ *
+ * Can be used as a reference type for all bn::sprite_text objects.
+ *
+ * @ingroup sprite
+ * @ingroup text
+ */
+class isprite_text
+{
+
+public:
+    isprite_text(const isprite_text& other) = delete;
+
+    isprite_text& operator=(const isprite_text& other) = delete;
+
+    /**
+     * @brief Returns the sprite_text_generator used to generate the text sprites.
+     *
+     * The sprite_text_generator is not copied but referenced, so it should outlive the isprite_text
+     * to avoid dangling references.
+     */
+    [[nodiscard]] const sprite_text_generator& generator() const
+    {
+        return *_generator;
+    }
+
+    /**
+     * @brief Returns the position of the first text sprite, considering the generator alignment.
+     */
+    [[nodiscard]] const fixed_point& position() const
+    {
+        return _position;
+    }
+
+    /**
+     * @brief Returns the single line of text shown by the text sprites.
+     */
+    [[nodiscard]] string_view text() const
+    {
+        return *_text_ref;
+    }
+
+    /**
+     * @brief Returns the text sprites.
+     */
+    [[nodiscard]] const ivector<sprite_ptr>& sprites() const
+    {
+        return *_sprites_ref;
+    }
+
+    /**
+     * @brief Sets the single line of text to show.
+     *
+     * If the new line of text has the same layout as the current one,
+     * the text sprites are kept and only the characters which have changed are repainted
+     * (see sprite_text_generator::repaint).
+     *
+     * Otherwise, the text sprites are generated again.
+     *
+     * @param text Single line of text to show.
+     */
+    void set_text(const string_view& text);
+
+    /**
+     * @brief Generates the text sprites again.
+     *
+     * It must be called after modifying the sprite_text_generator used to generate the text sprites.
+     */
+    void regenerate();
+
+    /**
+     * @brief Removes the text sprites and the shown line of text.
+     */
+    void clear();
+
+protected:
+    /// @cond DO_NOT_DOCUMENT
+
+    isprite_text(const sprite_text_generator& generator, const fixed_point& position) :
+        _generator(&generator),
+        _position(position)
+    {
+    }
+
+    void _set_refs(ivector<sprite_ptr>& sprites, istring& text)
+    {
+        _sprites_ref = &sprites;
+        _text_ref = &text;
+    }
+
+    /// @endcond
+
+private:
+    const sprite_text_generator* _generator;
+    fixed_point _position;
+    ivector<sprite_ptr>* _sprites_ref = nullptr;
+    istring* _text_ref = nullptr;
+};
+
+
+/**
+ * @brief Keeps the sprites generated by a sprite_text_generator for a single line of text,
+ * so updating the text only repaints the characters which have changed.
+ *
+ * @tparam MaxSprites Maximum number of text sprites.
+ * @tparam MaxSize Maximum number of bytes of the line of text.
+ *
+ * @ingroup sprite
+ * @ingroup text
+ */
+template<int MaxSprites, int MaxSize>
+class sprite_text : public isprite_text
+{
+    static_assert(MaxSprites > 0);
+    static_assert(MaxSize > 0);
+
+public:
+    /**
+     * @brief Constructor.
+     * @param generator sprite_text_generator used to generate the text sprites.
+     *
+     * The sprite_text_generator is not copied but referenced, so it should outlive the sprite_text
+     * to avoid dangling references.
+     *
+     * @param position Position of the first text sprite, considering the generator alignment.
+     */
+    sprite_text(const sprite_text_generator& generator, const fixed_point& position) :
+        isprite_text(generator, position)
+    {
+        this->_set_refs(_sprites, _text);
+    }
+
+    /**
+     * @brief Constructor.
+     * @param generator sprite_text_generator used to generate the text sprites.
+     *
+     * The sprite_text_generator is not copied but referenced, so it should outlive the sprite_text
+     * to avoid dangling references.
+     *
+     * @param position Position of the first text sprite, considering the generator alignment.
+     * @param text Single line of text to show.
+     */
+    sprite_text(const sprite_text_generator& generator, const fixed_point& position, const string_view& text) :
+        sprite_text(generator, position)
+    {
+        this->set_text(text);
+    }
+
+private:
+    vector<sprite_ptr, MaxSprites> _sprites;
+    string<MaxSize> _text;
+};
+
+}
+
+#endif
@@ -31,6 +31,11 @@ class sprite_ptr;
  *
  * Text can be printed in one sprite per character or multiple characters per sprite.
  *
+ * Text sprites can be updated to show another line of text with repaint() (or with bn::sprite_text).
+ * Changed characters reuse the tiles of the font graphics already shown by other sprites
+ * only in one sprite per character mode; otherwise, their tiles are repainted.
+ * Text printed with a variable width font can't be repainted, so it is always generated again.
+ *
  * Also, UTF-8 characters are supported.
  *
  * @ingroup sprite
@@ -490,6 +495,30 @@ public:
     [[nodiscard]] bool generate_top_left_optional(const fixed_point& top_left_position, const string_view& text,
                                                   ivector<sprite_ptr>& output_sprites) const;
 
+    /**
+     * @brief Updates text sprites generated for a single line of text to show another one,
+     * repainting only the characters which have changed.
+     *
+     * Text sprites can be updated only if both lines of text have the same layout:
+     * a fixed width font is used and spaces and tabs are placed at the same positions in both of them.
+     * Text sprites generated with a variable width font are never updated.
+     *
+     * If one_sprite_per_character is `true` (or the font requires it),
+     * changed characters reuse the tiles of the font graphics already shown by other sprites if possible.
+     * This per font glyph cache is not used when multiple characters are drawn on the same sprite:
+     * in that case, the tiles of each modified sprite are copied to a new tiles allocation which is repainted,
+     * so the sprite is updated in the next V-Blank without tearing.
+     * If there's no VRAM available for the copy, the shown tiles are repainted.
+     *
+     * @param old_text Single line of text printed in the given text sprites.
+     * @param new_text Single line of text to print.
+     * @param output_sprites Text sprites generated with this generator for old_text and nothing else.
+     * @return `true` if the text sprites have been updated, otherwise `false`
+     * (in this case, the text sprites are not modified).
+     */
+    [[nodiscard]] bool repaint(const string_view& old_text, const string_view& new_text,
+                               ivector<sprite_ptr>& output_sprites) const;
+
 private:
     sprite_font _font;
     sprite_palette_item _palette_item;
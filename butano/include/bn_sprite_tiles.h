@@ -45,6 +45,54 @@ namespace bn::sprite_tiles
      */
     [[nodiscard]] int available_items_count();
 
+    /**
+     * @brief Returns the maximum number of compressed sprite tiles bytes decompressed to VRAM per frame.
+     *
+     * If it is 0 (the default), compressed sprite tiles are fully decompressed in the next core::update call.
+     */
+    [[nodiscard]] int stream_max_bytes_per_frame();
+
+    /**
+     * @brief Sets the maximum number of compressed sprite tiles bytes decompressed to VRAM per frame.
+     *
+     * If it is greater than 0, compressed sprite tiles are decompressed over several frames
+     * (use sprite_tiles_ptr::loaded to know when they are ready).
+     *
+     * If it is 0, compressed sprite tiles are fully decompressed in the next core::update call.
+     */
+    void set_stream_max_bytes_per_frame(int max_bytes_per_frame);
+
+    /**
+     * @brief Returns the maximum number of sprite tiles relocated in VRAM per frame to reduce fragmentation.
+     *
+     * If it is 0 (the default), sprite tiles are relocated only when they can't be created otherwise.
+     */
+    [[nodiscard]] int compaction_max_tiles_per_frame();
+
+    /**
+     * @brief Sets the maximum number of sprite tiles relocated in VRAM per frame to reduce fragmentation.
+     *
+     * If it is greater than 0, sprite tiles are relocated in each core::update call
+     * until the free sprite tiles are contiguous.
+     *
+     * If it is 0, sprite tiles are relocated only when they can't be created otherwise.
+     */
+    void set_compaction_max_tiles_per_frame(int max_tiles_per_frame);
+
+    /**
+     * @brief Relocates sprite tiles in VRAM to merge free sprite tiles in a single block.
+     *
+     * Only uncompressed sprite tiles with source data referenced by sprites alone
+     * (not by other smart pointers or H-Blank effects) are relocated.
+     *
+     * Relocated sprite tiles are reloaded from their source data in the next core::update call.
+     *
+     * It is called automatically when sprite tiles can't be created.
+     *
+     * @return `true` if any sprite tiles have been relocated; `false` otherwise.
+     */
+    bool compact();
+
     /**
      * @brief Logs the current status of the sprite tiles manager.
      */
@@ -267,6 +267,13 @@ public:
      */
     [[nodiscard]] optional<span<tile>> vram();
 
+    /**
+     * @brief Indicates if the tiles have been fully copied to VRAM or not.
+     *
+     * Compressed tiles can be decompressed over several frames if streaming is enabled.
+     */
+    [[nodiscard]] bool loaded() const;
+
     /**
      * @brief Returns the internal handle.
      */
@@ -302,6 +309,8 @@ public:
 private:
     int16_t _handle;
 
+    friend class sprites_manager_item;
+
     explicit sprite_tiles_ptr(int handle) :
         _handle(int16_t(handle))
     {
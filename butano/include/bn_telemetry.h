@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_TELEMETRY_H
+#define BN_TELEMETRY_H
+
+/**
+ * @file
+ * bn::telemetry header file.
+ *
+ * @ingroup telemetry
+ */
+
+#include "bn_config_doxygen.h"
+#include "bn_config_telemetry.h"
+
+#if BN_CFG_TELEMETRY_ENABLED || BN_DOXYGEN
+    #include "bn_span_fwd.h"
+
+    /**
+     * @brief Telemetry related functions.
+     *
+     * Each bn::core::update call stores a sample with the CPU usage ticks, the V-Blank usage ticks,
+     * the missed frames and the ticks spent in each Butano subsystem.
+     *
+     * Samples are stored in a ring buffer of @ref BN_CFG_TELEMETRY_MAX_SAMPLES elements,
+     * so only the last ones are kept.
+     *
+     * @ingroup telemetry
+     */
+    namespace bn::telemetry
+    {
+        constexpr int cpu_ticks_channel = 0; //!< CPU usage ticks channel index.
+        constexpr int vblank_ticks_channel = 1; //!< V-Blank usage ticks channel index.
+        constexpr int missed_frames_channel = 2; //!< Missed frames channel index.
+
+        /**
+         * @brief Returns the number of channels of each sample
+         * (CPU usage ticks, V-Blank usage ticks, missed frames and one for each Butano subsystem).
+         */
+        [[nodiscard]] int channels_count();
+
+        /**
+         * @brief Returns the name of the specified channel.
+         */
+        [[nodiscard]] const char* channel_name(int channel);
+
+        /**
+         * @brief Returns the number of stored samples.
+         */
+        [[nodiscard]] int samples_count();
+
+        /**
+         * @brief Returns the value of the specified channel in the specified sample.
+         * @param channel Channel index.
+         * @param sample_index Sample index (0 is the oldest stored sample).
+         * @return Channel value.
+         */
+        [[nodiscard]] int value(int channel, int sample_index);
+
+        /**
+         * @brief Returns the specified percentile of the stored values of the given channel.
+         * @param channel Channel index.
+         * @param percent Percentile in the range [0..100].
+         * @return Smallest stored value which is greater or equal than the given percent of the stored values,
+         * or 0 if there are no stored samples.
+         */
+        [[nodiscard]] int percentile(int channel, int percent);
+
+        /**
+         * @brief Returns the maximum stored value of the given channel, or 0 if there are no stored samples.
+         */
+        [[nodiscard]] int max(int channel);
+
+        /**
+         * @brief Counts the stored values of the given channel in buckets of the same size.
+         * @param channel Channel index.
+         * @param bucket_size Size of each bucket.
+         * @param buckets Number of values of each bucket.
+         * Values greater than the last bucket are counted in it.
+         */
+        void histogram(int channel, int bucket_size, span<int> buckets);
+
+        /**
+         * @brief Logs the 50th percentile, the 95th percentile and the maximum value of each channel.
+         */
+        void log();
+
+        /**
+         * @brief Removes all stored samples.
+         */
+        void reset();
+    }
+
+    /// @cond DO_NOT_DOCUMENT
+
+    namespace _bn::telemetry
+    {
+        constexpr const char* engine_sections[] = {
+            "eng_update",
+            "eng_commit",
+            "eng_cameras_update",
+            "eng_sprites_update",
+            "eng_spr_tiles_update",
+            "eng_bgs_update",
+            "eng_bg_blocks_update",
+            "eng_palettes_update",
+            "eng_display_update",
+            "eng_hblank_fx_update",
+            "eng_hblank_fx_commit",
+            "eng_audio_commands",
+            "eng_display_commit",
+            "eng_sprites_commit",
+            "eng_bgs_commit",
+            "eng_palettes_commit",
+            "eng_spr_tiles_unc_commit",
+            "eng_hdma_update",
+            "eng_big_maps_commit",
+            "eng_bg_blocks_unc_commit",
+            "eng_spr_tiles_cmp_commit",
+            "eng_bg_blocks_cmp_commit",
+            "eng_vblank_callback",
+            "eng_audio_commit",
+            "eng_audio_update",
+            "eng_keypad",
+        };
+
+        constexpr int engine_sections_count = int(sizeof(engine_sections) / sizeof(engine_sections[0]));
+
+        [[nodiscard]] consteval int engine_section_index(const char* id)
+        {
+            for(int index = 0; index < engine_sections_count; ++index)
+            {
+                const char* section = engine_sections[index];
+                int char_index = 0;
+
+                while(section[char_index] && section[char_index] == id[char_index])
+                {
+                    ++char_index;
+                }
+
+                if(section[char_index] == id[char_index])
+                {
+                    return index;
+                }
+            }
+
+            return -1;
+        }
+
+        void start(int section_index);
+
+        void stop();
+
+        void add_sample(int cpu_ticks, int vblank_ticks, int missed_frames);
+    }
+
+    /// @endcond
+#endif
+
+#endif
@@ -106,22 +106,34 @@
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: run-length compressed data.
  *   * `"huffman"`: Huffman compressed data.
+ *   * `"lz4"`: LZ4 compressed data (faster to decompress than "lz77").
+ *   * `"rans"`: rANS compressed data (usually smaller than "huffman", but decompressing it uses 5KB of EWRAM heap).
  *   * `"auto"`: uses the option which gives the smallest data size.
  *   * `"auto_no_huffman"`: uses the option which gives the smallest data size, excluding "huffman".
+ *   * `"auto_smallest"`: uses the option which gives the smallest data size, including "lz4" and "rans".
+ *   * `"auto_fast"`: uses "lz4" if it reduces the data size, "none" otherwise.
  * * `"palette_compression"`: optional field which specifies the compression of the colors data:
  *   * `"none"`: uncompressed data (this is the default option).
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: run-length compressed data.
  *   * `"huffman"`: Huffman compressed data.
+ *   * `"lz4"`: LZ4 compressed data (faster to decompress than "lz77").
+ *   * `"rans"`: rANS compressed data (usually smaller than "huffman").
  *   * `"auto"`: uses the option which gives the smallest data size.
  *   * `"auto_no_huffman"`: uses the option which gives the smallest data size, excluding "huffman".
+ *   * `"auto_smallest"`: uses the option which gives the smallest data size, including "lz4" and "rans".
+ *   * `"auto_fast"`: uses "lz4" if it reduces the data size, "none" otherwise.
  * * `"compression"`: optional field which specifies the compression of the tiles and the colors data:
  *   * `"none"`: uncompressed data (this is the default option).
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: run-length compressed data.
  *   * `"huffman"`: Huffman compressed data.
+ *   * `"lz4"`: LZ4 compressed data (faster to decompress than "lz77").
+ *   * `"rans"`: rANS compressed data (usually smaller than "huffman").
  *   * `"auto"`: uses the option which gives the smallest data size.
  *   * `"auto_no_huffman"`: uses the option which gives the smallest data size, excluding "huffman".
+ *   * `"auto_smallest"`: uses the option which gives the smallest data size, including "lz4" and "rans".
+ *   * `"auto_fast"`: uses "lz4" if it reduces the data size, "none" otherwise.
  *
  * If the conversion process has finished successfully,
  * a bn::sprite_item should have been generated in the `build` folder.
@@ -172,8 +184,12 @@
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: run-length compressed data.
  *   * `"huffman"`: Huffman compressed data.
+ *   * `"lz4"`: LZ4 compressed data (faster to decompress than "lz77").
+ *   * `"rans"`: rANS compressed data (usually smaller than "huffman").
  *   * `"auto"`: uses the option which gives the smallest data size.
  *   * `"auto_no_huffman"`: uses the option which gives the smallest data size, excluding "huffman".
+ *   * `"auto_smallest"`: uses the option which gives the smallest data size, including "lz4" and "rans".
+ *   * `"auto_fast"`: uses "lz4" if it reduces the data size, "none" otherwise.
  *
  * If the conversion process has finished successfully,
  * a bn::sprite_tiles_item should have been generated in the `build` folder.
@@ -211,8 +227,12 @@
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: run-length compressed data.
  *   * `"huffman"`: Huffman compressed data.
+ *   * `"lz4"`: LZ4 compressed data (faster to decompress than "lz77").
+ *   * `"rans"`: rANS compressed data (usually smaller than "huffman").
  *   * `"auto"`: uses the option which gives the smallest data size.
  *   * `"auto_no_huffman"`: uses the option which gives the smallest data size, excluding "huffman".
+ *   * `"auto_smallest"`: uses the option which gives the smallest data size, including "lz4" and "rans".
+ *   * `"auto_fast"`: uses "lz4" if it reduces the data size, "none" otherwise.
  *
  * If the conversion process has finished successfully,
  * a bn::sprite_palette_item should have been generated in the `build` folder.
@@ -277,29 +297,45 @@
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: run-length compressed data.
  *   * `"huffman"`: Huffman compressed data.
+ *   * `"lz4"`: LZ4 compressed data (faster to decompress than "lz77").
+ *   * `"rans"`: rANS compressed data (usually smaller than "huffman").
  *   * `"auto"`: uses the option which gives the smallest data size.
  *   * `"auto_no_huffman"`: uses the option which gives the smallest data size, excluding "huffman".
+ *   * `"auto_smallest"`: uses the option which gives the smallest data size, including "lz4" and "rans".
+ *   * `"auto_fast"`: uses "lz4" if it reduces the data size, "none" otherwise.
  * * `"palette_compression"`: optional field which specifies the compression of the colors data:
  *   * `"none"`: uncompressed data (this is the default option).
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: run-length compressed data.
  *   * `"huffman"`: Huffman compressed data.
+ *   * `"lz4"`: LZ4 compressed data (faster to decompress than "lz77").
+ *   * `"rans"`: rANS compressed data (usually smaller than "huffman").
  *   * `"auto"`: uses the option which gives the smallest data size.
  *   * `"auto_no_huffman"`: uses the option which gives the smallest data size, excluding "huffman".
+ *   * `"auto_smallest"`: uses the option which gives the smallest data size, including "lz4" and "rans".
+ *   * `"auto_fast"`: uses "lz4" if it reduces the data size, "none" otherwise.
  * * `"map_compression"`: optional field which specifies the compression of the map data:
  *   * `"none"`: uncompressed data (this is the default option).
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: run-length compressed data.
  *   * `"huffman"`: Huffman compressed data.
+ *   * `"lz4"`: LZ4 compressed data (faster to decompress than "lz77").
+ *   * `"rans"`: rANS compressed data (usually smaller than "huffman").
  *   * `"auto"`: uses the option which gives the smallest data size.
  *   * `"auto_no_huffman"`: uses the option which gives the smallest data size, excluding "huffman".
+ *   * `"auto_smallest"`: uses the option which gives the smallest data size, including "lz4" and "rans".
+ *   * `"auto_fast"`: uses "lz4" if it reduces the data size, "none" otherwise.
  * * `"compression"`: optional field which specifies the compression of the tiles, the colors and the map data:
  *   * `"none"`: uncompressed data (this is the default option).
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: run-length compressed data.
  *   * `"huffman"`: Huffman compressed data.
+ *   * `"lz4"`: LZ4 compressed data (faster to decompress than "lz77").
+ *   * `"rans"`: rANS compressed data (usually smaller than "huffman").
  *   * `"auto"`: uses the option which gives the smallest data size.
  *   * `"auto_no_huffman"`: uses the option which gives the smallest data size, excluding "huffman".
+ *   * `"auto_smallest"`: uses the option which gives the smallest data size, including "lz4" and "rans".
+ *   * `"auto_fast"`: uses "lz4" if it reduces the data size, "none" otherwise.
  *
  * If the conversion process has finished successfully,
  * a bn::regular_bg_item should have been generated in the `build` folder.
@@ -338,8 +374,12 @@
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: run-length compressed data.
  *   * `"huffman"`: Huffman compressed data.
+ *   * `"lz4"`: LZ4 compressed data (faster to decompress than "lz77").
+ *   * `"rans"`: rANS compressed data (usually smaller than "huffman").
  *   * `"auto"`: uses the option which gives the smallest data size.
  *   * `"auto_no_huffman"`: uses the option which gives the smallest data size, excluding "huffman".
+ *   * `"auto_smallest"`: uses the option which gives the smallest data size, including "lz4" and "rans".
+ *   * `"auto_fast"`: uses "lz4" if it reduces the data size, "none" otherwise.
  * * `"generate_palette"`: optional field which specifies if a background palette must be generated (`false` by default).
  * * `"palette_colors_count"`: optional field which specifies the background palette size [1..256].
  * * `"palette_compression"`: optional field which specifies the compression of the colors data:
@@ -347,8 +387,12 @@
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: run-length compressed data.
  *   * `"huffman"`: Huffman compressed data.
+ *   * `"lz4"`: LZ4 compressed data (faster to decompress than "lz77").
+ *   * `"rans"`: rANS compressed data (usually smaller than "huffman").
  *   * `"auto"`: uses the option which gives the smallest data size.
  *   * `"auto_no_huffman"`: uses the option which gives the smallest data size, excluding "huffman".
+ *   * `"auto_smallest"`: uses the option which gives the smallest data size, including "lz4" and "rans".
+ *   * `"auto_fast"`: uses "lz4" if it reduces the data size, "none" otherwise.
  *
  * If the conversion process has finished successfully,
  * a bn::regular_bg_tiles_item should have been generated in the `build` folder.
@@ -398,29 +442,45 @@
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: run-length compressed data.
  *   * `"huffman"`: Huffman compressed data.
+ *   * `"lz4"`: LZ4 compressed data (faster to decompress than "lz77").
+ *   * `"rans"`: rANS compressed data (usually smaller than "huffman").
  *   * `"auto"`: uses the option which gives the smallest data size.
  *   * `"auto_no_huffman"`: uses the option which gives the smallest data size, excluding "huffman".
+ *   * `"auto_smallest"`: uses the option which gives the smallest data size, including "lz4" and "rans".
+ *   * `"auto_fast"`: uses "lz4" if it reduces the data size, "none" otherwise.
  * * `"palette_compression"`: optional field which specifies the compression of the colors data:
  *   * `"none"`: uncompressed data (this is the default option).
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: run-length compressed data.
  *   * `"huffman"`: Huffman compressed data.
+ *   * `"lz4"`: LZ4 compressed data (faster to decompress than "lz77").
+ *   * `"rans"`: rANS compressed data (usually smaller than "huffman").
  *   * `"auto"`: uses the option which gives the smallest data size.
  *   * `"auto_no_huffman"`: uses the option which gives the smallest data size, excluding "huffman".
+ *   * `"auto_smallest"`: uses the option which gives the smallest data size, including "lz4" and "rans".
+ *   * `"auto_fast"`: uses "lz4" if it reduces the data size, "none" otherwise.
  * * `"map_compression"`: optional field which specifies the compression of the map data:
  *   * `"none"`: uncompressed data (this is the default option).
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: run-length compressed data.
  *   * `"huffman"`: Huffman compressed data.
+ *   * `"lz4"`: LZ4 compressed data (faster to decompress than "lz77").
+ *   * `"rans"`: rANS compressed data (usually smaller than "huffman").
  *   * `"auto"`: uses the option which gives the smallest data size.
  *   * `"auto_no_huffman"`: uses the option which gives the smallest data size, excluding "huffman".
+ *   * `"auto_smallest"`: uses the option which gives the smallest data size, including "lz4" and "rans".
+ *   * `"auto_fast"`: uses "lz4" if it reduces the data size, "none" otherwise.
  * * `"compression"`: optional field which specifies the compression of the tiles, the colors and the map data:
  *   * `"none"`: uncompressed data (this is the default option).
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: run-length compressed data.
  *   * `"huffman"`: Huffman compressed data.
+ *   * `"lz4"`: LZ4 compressed data (faster to decompress than "lz77").
+ *   * `"rans"`: rANS compressed data (usually smaller than "huffman").
  *   * `"auto"`: uses the option which gives the smallest data size.
  *   * `"auto_no_huffman"`: uses the option which gives the smallest data size, excluding "huffman".
+ *   * `"auto_smallest"`: uses the option which gives the smallest data size, including "lz4" and "rans".
+ *   * `"auto_fast"`: uses "lz4" if it reduces the data size, "none" otherwise.
  *
  * If the conversion process has finished successfully,
  * a bn::affine_bg_item should have been generated in the `build` folder.
@@ -454,8 +514,12 @@
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: run-length compressed data.
  *   * `"huffman"`: Huffman compressed data.
+ *   * `"lz4"`: LZ4 compressed data (faster to decompress than "lz77").
+ *   * `"rans"`: rANS compressed data (usually smaller than "huffman").
  *   * `"auto"`: uses the option which gives the smallest data size.
  *   * `"auto_no_huffman"`: uses the option which gives the smallest data size, excluding "huffman".
+ *   * `"auto_smallest"`: uses the option which gives the smallest data size, including "lz4" and "rans".
+ *   * `"auto_fast"`: uses "lz4" if it reduces the data size, "none" otherwise.
  * * `"generate_palette"`: optional field which specifies if a background palette must be generated (`false` by default).
  * * `"palette_colors_count"`: optional field which specifies the background palette size [1..256].
  * * `"palette_compression"`: optional field which specifies the compression of the colors data:
@@ -463,8 +527,12 @@
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: run-length compressed data.
  *   * `"huffman"`: Huffman compressed data.
+ *   * `"lz4"`: LZ4 compressed data (faster to decompress than "lz77").
+ *   * `"rans"`: rANS compressed data (usually smaller than "huffman").
  *   * `"auto"`: uses the option which gives the smallest data size.
  *   * `"auto_no_huffman"`: uses the option which gives the smallest data size, excluding "huffman".
+ *   * `"auto_smallest"`: uses the option which gives the smallest data size, including "lz4" and "rans".
+ *   * `"auto_fast"`: uses "lz4" if it reduces the data size, "none" otherwise.
  *
  * If the conversion process has finished successfully,
  * a bn::affine_bg_tiles_item should have been generated in the `build` folder.
@@ -499,22 +567,34 @@
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: run-length compressed data.
  *   * `"huffman"`: Huffman compressed data.
+ *   * `"lz4"`: LZ4 compressed data (faster to decompress than "lz77").
+ *   * `"rans"`: rANS compressed data (usually smaller than "huffman").
  *   * `"auto"`: uses the option which gives the smallest data size.
  *   * `"auto_no_huffman"`: uses the option which gives the smallest data size, excluding "huffman".
+ *   * `"auto_smallest"`: uses the option which gives the smallest data size, including "lz4" and "rans".
+ *   * `"auto_fast"`: uses "lz4" if it reduces the data size, "none" otherwise.
  * * `"palette_compression"`: optional field which specifies the compression of the colors data:
  *   * `"none"`: uncompressed data (this is the default option).
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: run-length compressed data.
  *   * `"huffman"`: Huffman compressed data.
+ *   * `"lz4"`: LZ4 compressed data (faster to decompress than "lz77").
+ *   * `"rans"`: rANS compressed data (usually smaller than "huffman").
  *   * `"auto"`: uses the option which gives the smallest data size.
  *   * `"auto_no_huffman"`: uses the option which gives the smallest data size, excluding "huffman".
+ *   * `"auto_smallest"`: uses the option which gives the smallest data size, including "lz4" and "rans".
+ *   * `"auto_fast"`: uses "lz4" if it reduces the data size, "none" otherwise.
  * * `"compression"`: optional field which specifies the compression of the pixels and the colors data:
  *   * `"none"`: uncompressed data (this is the default option).
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: run-length compressed data.
  *   * `"huffman"`: Huffman compressed data.
+ *   * `"lz4"`: LZ4 compressed data (faster to decompress than "lz77").
+ *   * `"rans"`: rANS compressed data (usually smaller than "huffman").
  *   * `"auto"`: uses the option which gives the smallest data size.
  *   * `"auto_no_huffman"`: uses the option which gives the smallest data size, excluding "huffman".
+ *   * `"auto_smallest"`: uses the option which gives the smallest data size, including "lz4" and "rans".
+ *   * `"auto_fast"`: uses "lz4" if it reduces the data size, "none" otherwise.
  *
  * If the conversion process has finished successfully,
  * a bn::palette_bitmap_item should have been generated in the `build` folder.
@@ -551,8 +631,12 @@
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: run-length compressed data.
  *   * `"huffman"`: Huffman compressed data.
+ *   * `"lz4"`: LZ4 compressed data (faster to decompress than "lz77").
+ *   * `"rans"`: rANS compressed data (usually smaller than "huffman").
  *   * `"auto"`: uses the option which gives the smallest data size.
  *   * `"auto_no_huffman"`: uses the option which gives the smallest data size, excluding "huffman".
+ *   * `"auto_smallest"`: uses the option which gives the smallest data size, including "lz4" and "rans".
+ *   * `"auto_fast"`: uses "lz4" if it reduces the data size, "none" otherwise.
  *
  * If the conversion process has finished successfully,
  * a bn::palette_bitmap_pixels_item should have been generated in the `build` folder.
@@ -587,8 +671,12 @@
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: run-length compressed data.
  *   * `"huffman"`: Huffman compressed data.
+ *   * `"lz4"`: LZ4 compressed data (faster to decompress than "lz77").
+ *   * `"rans"`: rANS compressed data (usually smaller than "huffman").
  *   * `"auto"`: uses the option which gives the smallest data size.
  *   * `"auto_no_huffman"`: uses the option which gives the smallest data size, excluding "huffman".
+ *   * `"auto_smallest"`: uses the option which gives the smallest data size, including "lz4" and "rans".
+ *   * `"auto_fast"`: uses "lz4" if it reduces the data size, "none" otherwise.
  *
  * If the conversion process has finished successfully,
  * a bn::direct_bitmap_item should have been generated in the `build` folder.
@@ -628,8 +716,12 @@
  *   * `"lz77"`: LZ77 compressed data.
  *   * `"run_length"`: run-length compressed data.
  *   * `"huffman"`: Huffman compressed data.
+ *   * `"lz4"`: LZ4 compressed data (faster to decompress than "lz77").
+ *   * `"rans"`: rANS compressed data (usually smaller than "huffman").
  *   * `"auto"`: uses the option which gives the smallest data size.
  *   * `"auto_no_huffman"`: uses the option which gives the smallest data size, excluding "huffman".
+ *   * `"auto_smallest"`: uses the option which gives the smallest data size, including "lz4" and "rans".
+ *   * `"auto_fast"`: uses "lz4" if it reduces the data size, "none" otherwise.
  *
  * If the conversion process has finished successfully,
  * a bn::bg_palette_item should have been generated in the `build` folder.
@@ -646,6 +738,51 @@
  * @endcode
  *
  *
+ * @subsection import_palette_animation Palette animations
+ *
+ * Palette animations store the keyframes in the color palette of the `*.bmp` file, one after another.
+ * The image pixels are ignored.
+ *
+ * An example of the `*.json` files required for palette animations is the following:
+ *
+ * @code{.json}
+ * {
+ *     "type": "palette_animation",
+ *     "first_color_index": 4,
+ *     "colors_count": 4,
+ *     "keyframes": 3,
+ *     "durations": [60, 30, 60]
+ * }
+ * @endcode
+ *
+ * The fields for palette animations are the following:
+ * * `"type"`: must be `"palette_animation"` for palette animations.
+ * * `"colors_count"`: number of colors of each keyframe [1..128].
+ * * `"keyframes"`: number of keyframes stored in the color palette of the `*.bmp` file [2..].
+ * * `"durations"`: number of frames from each keyframe to the next one.
+ *   It can be a single number or an array with one item per keyframe (one less if the animation doesn't loop).
+ * * `"first_color_index"`: optional field which specifies the index of the first animated color
+ *   of the target color palette (0 by default).
+ * * `"interpolation"`: optional field which specifies how the colors between keyframes are generated:
+ *   * `"linear"`: colors are linearly interpolated (this is the default option).
+ *   * `"step"`: colors change at once when the next keyframe is reached.
+ * * `"loop"`: optional field which specifies if the animation must be played forever (`true` by default).
+ *
+ * If the conversion process has finished successfully,
+ * a bn::palette_animation_item should have been generated in the `build` folder.
+ *
+ * For example, from two files named `water.bmp` and `water.json`,
+ * a header file named `bn_palette_animation_items_water.h` is generated in the `build` folder.
+ *
+ * You can use this header to animate a sprite or a background palette without game code intervention:
+ *
+ * @code{.cpp}
+ * #include "bn_palette_animation_items_water.h"
+ *
+ * bg_palette.set_animation(bn::palette_animation_items::water);
+ * @endcode
+ *
+ *
  * @section import_audio Audio
  *
  * By default audio files played with Direct Sound channels go into the `audio` folder of your project,
@@ -394,6 +394,14 @@
  * It can be enabled or disabled by overloading the definition of @ref BN_CFG_PROFILER_ENABLED.
  */
 
+/**
+ * @defgroup telemetry Telemetry
+ *
+ * Per-frame CPU usage samples of Butano subsystems stored in a ring buffer.
+ *
+ * It can be enabled or disabled by overloading the definition of @ref BN_CFG_TELEMETRY_ENABLED.
+ */
+
 /**
  * @defgroup std Standard library
  *
@@ -48,6 +48,18 @@ affine_bg_map_item affine_bg_map_item::decompress(span<affine_bg_map_cell> decom
         result._compression = compression_type::NONE;
         break;
 
+    case compression_type::LZ4:
+        hw::decompress::lz4(_cells_ptr, decompressed_cells_ptr);
+        result._cells_ptr = decompressed_cells_ptr;
+        result._compression = compression_type::NONE;
+        break;
+
+    case compression_type::RANS:
+        hw::decompress::rans(_cells_ptr, decompressed_cells_ptr);
+        result._cells_ptr = decompressed_cells_ptr;
+        result._compression = compression_type::NONE;
+        break;
+
     default:
         BN_ERROR("Unknown compression type: ", int(_compression));
         break;
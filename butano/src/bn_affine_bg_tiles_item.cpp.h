@@ -31,18 +31,35 @@ affine_bg_tiles_item affine_bg_tiles_item::decompress(span<tile> decompressed_ti
         hw::decompress::lz77(_tiles_ref.data(), dest_tiles_ptr);
         result._tiles_ref = span<const tile>(dest_tiles_ptr, source_tiles_count);
         result._compression = compression_type::NONE;
+        result._content_hash = 0;
         break;
 
     case compression_type::RUN_LENGTH:
         hw::decompress::rl_wram(_tiles_ref.data(), dest_tiles_ptr);
         result._tiles_ref = span<const tile>(dest_tiles_ptr, source_tiles_count);
         result._compression = compression_type::NONE;
+        result._content_hash = 0;
         break;
 
     case compression_type::HUFFMAN:
         hw::decompress::huff(_tiles_ref.data(), dest_tiles_ptr);
         result._tiles_ref = span<const tile>(dest_tiles_ptr, source_tiles_count);
         result._compression = compression_type::NONE;
+        result._content_hash = 0;
+        break;
+
+    case compression_type::LZ4:
+        hw::decompress::lz4(_tiles_ref.data(), dest_tiles_ptr);
+        result._tiles_ref = span<const tile>(dest_tiles_ptr, source_tiles_count);
+        result._compression = compression_type::NONE;
+        result._content_hash = 0;
+        break;
+
+    case compression_type::RANS:
+        hw::decompress::rans(_tiles_ref.data(), dest_tiles_ptr);
+        result._tiles_ref = span<const tile>(dest_tiles_ptr, source_tiles_count);
+        result._compression = compression_type::NONE;
+        result._content_hash = 0;
         break;
 
     default:
@@ -174,4 +174,9 @@ optional<span<tile>> affine_bg_tiles_ptr::vram()
     return bg_blocks_manager::tiles_vram(_handle);
 }
 
+bool affine_bg_tiles_ptr::loaded() const
+{
+    return ! bg_blocks_manager::must_commit(_handle);
+}
+
 }
@@ -68,13 +68,10 @@ void* best_fit_allocator::alloc(size_type bytes)
 
     if(new_item_size > _sizeof_free_item)
     {
-        item->size = bytes;
-
-        item_type* new_item = item->next();
+        auto new_item = reinterpret_cast<item_type*>(reinterpret_cast<uint8_t*>(item) + bytes);
         new_item->previous = item;
         new_item->size = new_item_size;
         new_item->used = false;
-        new_item->free_items = item->free_items;
 
         item_type* new_next_item = new_item->next();
 
@@ -83,37 +80,12 @@ void* best_fit_allocator::alloc(size_type bytes)
             new_next_item->previous = new_item;
         }
 
-        if(item_type* previous_free_item = item->free_items.previous)
-        {
-            previous_free_item->free_items.next = new_item;
-        }
-        else
-        {
-            _first_free_item = new_item;
-        }
-
-        if(item_type* next_free_item = item->free_items.next)
-        {
-            next_free_item->free_items.previous = new_item;
-        }
+        _replace_free_item(item, new_item);
+        item->size = bytes;
     }
     else
     {
-        item_type* next_free_item = item->free_items.next;
-
-        if(item_type* previous_free_item = item->free_items.previous)
-        {
-            previous_free_item->free_items.next = item->free_items.next;
-        }
-        else
-        {
-            _first_free_item = next_free_item;
-        }
-
-        if(next_free_item)
-        {
-            next_free_item->free_items.previous = item->free_items.previous;
-        }
+        _remove_free_item(item);
     }
 
     item->used = true;
@@ -200,19 +172,24 @@ void best_fit_allocator::free(void* ptr)
         _free_check(item);
     #endif
 
-    bool item_linked = false;
     item->used = false;
-    item->free_items.previous = nullptr;
-    item->free_items.next = nullptr;
     _free_bytes_count += item->size;
 
+    // Indicates if the freed item is already stored in the free lists:
+    bool listed = false;
+
     if(item_type* previous_item = item->previous)
     {
         if(! previous_item->used)
         {
+            #if BN_CFG_BEST_FIT_ALLOCATOR_SEGREGATED_FREE_LISTS
+                _remove_free_item(previous_item);
+            #else
+                listed = true;
+            #endif
+
             previous_item->size += item->size;
             item = previous_item;
-            item_linked = true;
         }
     }
 
@@ -223,31 +200,19 @@ void best_fit_allocator::free(void* ptr)
     {
         if(! next_item->used)
         {
-            item_linked = true;
-
-            if(item_type* previous_free_item = next_item->free_items.previous)
-            {
-                if(previous_free_item == item)
+            #if BN_CFG_BEST_FIT_ALLOCATOR_SEGREGATED_FREE_LISTS
+                _remove_free_item(next_item);
+            #else
+                if(listed)
                 {
-                    item->free_items.next = next_item->free_items.next;
+                    _remove_free_item(next_item);
                 }
                 else
                 {
-                    previous_free_item->free_items.next = item;
-                    item->free_items.previous = previous_free_item;
+                    _replace_free_item(next_item, item);
+                    listed = true;
                 }
-            }
-
-            if(item_type* next_free_item = next_item->free_items.next)
-            {
-                next_free_item->free_items.previous = item;
-                item->free_items.next = next_free_item;
-            }
-
-            if(next_item == _first_free_item)
-            {
-                _first_free_item = nullptr;
-            }
+            #endif
 
             item->size += next_item->size;
             next_item = item->next();
@@ -259,44 +224,9 @@ void best_fit_allocator::free(void* ptr)
         }
     }
 
-    if(item_type* first_free_item = _first_free_item)
+    if(! listed)
     {
-        if(! item_linked)
-        {
-            item_type* free_item = first_free_item;
-            item_type* previous_free_item = nullptr;
-
-            while(free_item)
-            {
-                if(free_item < item)
-                {
-                    previous_free_item = free_item;
-                }
-                else
-                {
-                    free_item->free_items.previous = item;
-                    item->free_items.next = free_item;
-                    break;
-                }
-
-                free_item = free_item->free_items.next;
-            }
-
-            if(previous_free_item)
-            {
-                previous_free_item->free_items.next = item;
-                item->free_items.previous = previous_free_item;
-            }
-        }
-
-        if(first_free_item > item)
-        {
-            _first_free_item = item;
-        }
-    }
-    else
-    {
-        _first_free_item = item;
+        _insert_free_item(item);
     }
 
     #if BN_CFG_BEST_FIT_ALLOCATOR_SANITY_CHECK_ENABLED
@@ -309,6 +239,14 @@ void best_fit_allocator::reset(void* start, size_type bytes)
     BN_ASSERT(bytes >= 0 && bytes % size_type(sizeof(int)) == 0, "Invalid bytes: ", bytes);
     BN_BASIC_ASSERT(empty(), "Allocator is not empty");
 
+    #if BN_CFG_BEST_FIT_ALLOCATOR_SEGREGATED_FREE_LISTS
+        memory::clear(_free_lists);
+        memory::clear(_second_level_bitmaps);
+        _first_level_bitmap = 0;
+    #else
+        _first_free_item = nullptr;
+    #endif
+
     if(bytes >= _sizeof_free_item)
     {
         BN_BASIC_ASSERT(start, "Start is null");
@@ -329,18 +267,15 @@ void best_fit_allocator::reset(void* start, size_type bytes)
         first_item->previous = nullptr;
         first_item->size = bytes;
         first_item->used = false;
-        first_item->free_items.previous = nullptr;
-        first_item->free_items.next = nullptr;
 
         _start_ptr = static_cast<uint8_t*>(start);
-        _first_free_item = first_item;
         _total_bytes_count = bytes;
         _free_bytes_count = bytes;
+        _insert_free_item(first_item);
     }
     else
     {
         _start_ptr = nullptr;
-        _first_free_item = nullptr;
         _total_bytes_count = 0;
         _free_bytes_count = 0;
     }
@@ -374,39 +309,237 @@ void best_fit_allocator::log_status() const
     #endif
 }
 
-best_fit_allocator::item_type* best_fit_allocator::_best_free_item(size_type bytes)
-{
-    item_type* free_item = _first_free_item;
-    item_type* best_free_item = nullptr;
-    size_type best_free_item_bytes = numeric_limits<size_type>::max();
+#if BN_CFG_BEST_FIT_ALLOCATOR_SEGREGATED_FREE_LISTS
+    void best_fit_allocator::_free_list_indexes(unsigned bytes, int& first_level, int& second_level)
+    {
+        int bits = 31 - __builtin_clz(bytes);
+        first_level = bits - _min_size_bits;
+        second_level = int(bytes >> (bits - _second_level_bits)) & (_second_level_count - 1);
+    }
 
-    while(free_item)
+    void best_fit_allocator::_insert_free_item(item_type* item)
     {
-        size_type free_item_bytes = free_item->size;
+        int first_level;
+        int second_level;
+        _free_list_indexes(unsigned(item->size), first_level, second_level);
 
-        if(free_item_bytes == bytes)
+        item_type*& first_free_item = _free_lists[first_level][second_level];
+        item->free_items.previous = nullptr;
+        item->free_items.next = first_free_item;
+
+        if(first_free_item)
         {
-            return free_item;
+            first_free_item->free_items.previous = item;
         }
 
-        if(free_item_bytes > bytes && free_item_bytes < best_free_item_bytes)
+        first_free_item = item;
+        _first_level_bitmap |= 1U << first_level;
+        _second_level_bitmaps[first_level] |= uint8_t(1 << second_level);
+    }
+
+    void best_fit_allocator::_remove_free_item(item_type* item)
+    {
+        item_type* previous_free_item = item->free_items.previous;
+        item_type* next_free_item = item->free_items.next;
+
+        if(next_free_item)
         {
-            best_free_item = free_item;
-            best_free_item_bytes = free_item_bytes;
+            next_free_item->free_items.previous = previous_free_item;
         }
 
-        free_item = free_item->free_items.next;
+        if(previous_free_item)
+        {
+            previous_free_item->free_items.next = next_free_item;
+        }
+        else
+        {
+            int first_level;
+            int second_level;
+            _free_list_indexes(unsigned(item->size), first_level, second_level);
+            _free_lists[first_level][second_level] = next_free_item;
+
+            if(! next_free_item)
+            {
+                unsigned second_level_bitmap = _second_level_bitmaps[first_level] & ~(1U << second_level);
+                _second_level_bitmaps[first_level] = uint8_t(second_level_bitmap);
+
+                if(! second_level_bitmap)
+                {
+                    _first_level_bitmap &= ~(1U << first_level);
+                }
+            }
+        }
     }
 
-    return best_free_item;
-}
+    void best_fit_allocator::_replace_free_item(item_type* item, item_type* new_item)
+    {
+        _remove_free_item(item);
+        _insert_free_item(new_item);
+    }
+
+    best_fit_allocator::item_type* best_fit_allocator::_best_free_item(size_type bytes)
+    {
+        // Search from the next size class, so any item of the first non empty list fits:
+        auto unsigned_bytes = unsigned(bytes);
+        int bits = 31 - __builtin_clz(unsigned_bytes);
+        int first_level;
+        int second_level;
+        _free_list_indexes(unsigned_bytes + (1U << (bits - _second_level_bits)) - 1, first_level, second_level);
+
+        if(first_level < _first_level_count)
+        {
+            unsigned second_level_bitmap = _second_level_bitmaps[first_level] & (~0U << second_level);
+
+            if(! second_level_bitmap)
+            {
+                if(unsigned first_level_bitmap = _first_level_bitmap & (~0U << (first_level + 1)))
+                {
+                    first_level = __builtin_ctz(first_level_bitmap);
+                    second_level_bitmap = _second_level_bitmaps[first_level];
+                }
+            }
+
+            if(second_level_bitmap)
+            {
+                return _free_lists[first_level][__builtin_ctz(second_level_bitmap)];
+            }
+        }
+
+        // Items of the requested size class can still fit:
+        _free_list_indexes(unsigned_bytes, first_level, second_level);
+
+        item_type* free_item = _free_lists[first_level][second_level];
+        item_type* best_free_item = nullptr;
+        size_type best_free_item_bytes = numeric_limits<size_type>::max();
+
+        while(free_item)
+        {
+            size_type free_item_bytes = free_item->size;
+
+            if(free_item_bytes == bytes)
+            {
+                return free_item;
+            }
+
+            if(free_item_bytes > bytes && free_item_bytes < best_free_item_bytes)
+            {
+                best_free_item = free_item;
+                best_free_item_bytes = free_item_bytes;
+            }
+
+            free_item = free_item->free_items.next;
+        }
+
+        return best_free_item;
+    }
+
+#else
+    void best_fit_allocator::_insert_free_item(item_type* item)
+    {
+        // Free items are sorted by address:
+        item_type* free_item = _first_free_item;
+        item_type* previous_free_item = nullptr;
+
+        while(free_item && free_item < item)
+        {
+            previous_free_item = free_item;
+            free_item = free_item->free_items.next;
+        }
+
+        item->free_items.previous = previous_free_item;
+        item->free_items.next = free_item;
+
+        if(free_item)
+        {
+            free_item->free_items.previous = item;
+        }
+
+        if(previous_free_item)
+        {
+            previous_free_item->free_items.next = item;
+        }
+        else
+        {
+            _first_free_item = item;
+        }
+    }
+
+    void best_fit_allocator::_remove_free_item(item_type* item)
+    {
+        item_type* previous_free_item = item->free_items.previous;
+        item_type* next_free_item = item->free_items.next;
+
+        if(next_free_item)
+        {
+            next_free_item->free_items.previous = previous_free_item;
+        }
+
+        if(previous_free_item)
+        {
+            previous_free_item->free_items.next = next_free_item;
+        }
+        else
+        {
+            _first_free_item = next_free_item;
+        }
+    }
+
+    void best_fit_allocator::_replace_free_item(item_type* item, item_type* new_item)
+    {
+        item_type* previous_free_item = item->free_items.previous;
+        item_type* next_free_item = item->free_items.next;
+        new_item->free_items.previous = previous_free_item;
+        new_item->free_items.next = next_free_item;
+
+        if(next_free_item)
+        {
+            next_free_item->free_items.previous = new_item;
+        }
+
+        if(previous_free_item)
+        {
+            previous_free_item->free_items.next = new_item;
+        }
+        else
+        {
+            _first_free_item = new_item;
+        }
+    }
+
+    best_fit_allocator::item_type* best_fit_allocator::_best_free_item(size_type bytes)
+    {
+        item_type* free_item = _first_free_item;
+        item_type* best_free_item = nullptr;
+        size_type best_free_item_bytes = numeric_limits<size_type>::max();
+
+        while(free_item)
+        {
+            size_type free_item_bytes = free_item->size;
+
+            if(free_item_bytes == bytes)
+            {
+                return free_item;
+            }
+
+            if(free_item_bytes > bytes && free_item_bytes < best_free_item_bytes)
+            {
+                best_free_item = free_item;
+                best_free_item_bytes = free_item_bytes;
+            }
+
+            free_item = free_item->free_items.next;
+        }
+
+        return best_free_item;
+    }
+
+#endif
 
 #if BN_CFG_BEST_FIT_ALLOCATOR_SANITY_CHECK_ENABLED
     void best_fit_allocator::_sanity_check() const
     {
         const item_type* item = _begin_item();
         const item_type* end_item = _end_item();
-        const item_type* first_free_item = nullptr;
         size_type real_used_bytes = 0;
         size_type num_free_items = 0;
 
@@ -436,33 +569,63 @@ best_fit_allocator::item_type* best_fit_allocator::_best_free_item(size_type byt
             else
             {
                 ++num_free_items;
-
-                if(! first_free_item)
-                {
-                    first_free_item = item;
-                }
             }
 
             item = next_item;
         }
 
-        BN_ASSERT(first_free_item == _first_free_item);
         BN_ASSERT(real_used_bytes == used_bytes(), real_used_bytes, " - ", used_bytes());
 
-        item_type* free_item = _first_free_item;
         size_type num_list_free_items = 0;
 
-        while(free_item)
-        {
-            ++num_list_free_items;
+        #if BN_CFG_BEST_FIT_ALLOCATOR_SEGREGATED_FREE_LISTS
+            for(int first_level = 0; first_level < _first_level_count; ++first_level)
+            {
+                for(int second_level = 0; second_level < _second_level_count; ++second_level)
+                {
+                    item_type* free_item = _free_lists[first_level][second_level];
+                    bool first_level_bit = _first_level_bitmap & (1U << first_level);
+                    bool second_level_bit = _second_level_bitmaps[first_level] & (1U << second_level);
+                    BN_ASSERT(second_level_bit == bool(free_item), first_level, " - ", second_level);
+                    BN_ASSERT(first_level_bit == bool(_second_level_bitmaps[first_level]), first_level);
+                    BN_ASSERT(! free_item || ! free_item->free_items.previous, first_level, " - ", second_level);
+
+                    while(free_item)
+                    {
+                        ++num_list_free_items;
+
+                        BN_ASSERT(! free_item->used);
+
+                        int item_first_level;
+                        int item_second_level;
+                        _free_list_indexes(unsigned(free_item->size), item_first_level, item_second_level);
+                        BN_ASSERT(item_first_level == first_level && item_second_level == second_level,
+                                  first_level, " - ", second_level);
+
+                        item_type* next_free_item = free_item->free_items.next;
+                        BN_ASSERT(! next_free_item || next_free_item->free_items.previous == free_item);
+
+                        free_item = next_free_item;
+                    }
+                }
+            }
+        #else
+            item_type* free_item = _first_free_item;
+            BN_ASSERT(! free_item || ! free_item->free_items.previous);
+
+            while(free_item)
+            {
+                ++num_list_free_items;
 
-            BN_ASSERT(! free_item->used);
+                BN_ASSERT(! free_item->used);
 
-            item_type* next_free_item = free_item->free_items.next;
-            BN_ASSERT(! next_free_item || next_free_item->free_items.previous == free_item);
+                item_type* next_free_item = free_item->free_items.next;
+                BN_ASSERT(! next_free_item || next_free_item->free_items.previous == free_item);
+                BN_ASSERT(! next_free_item || next_free_item > free_item);
 
-            free_item = next_free_item;
-        }
+                free_item = next_free_item;
+            }
+        #endif
 
         BN_ASSERT(num_free_items == num_list_free_items);
     }
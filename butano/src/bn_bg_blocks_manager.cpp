@@ -6,13 +6,18 @@
 #include "bn_bg_blocks_manager.h"
 
 #include "bn_limits.h"
+#include "bn_algorithm.h"
 #include "bn_string_view.h"
 #include "bn_bgs_manager.h"
+#include "bn_unordered_map.h"
+#include "bn_hblank_effects_manager.h"
+#include "bn_identity_hasher.h"
 #include "bn_config_bg_blocks.h"
 #include "bn_affine_bg_big_map_canvas_size.h"
 #include "../hw/include/bn_hw_dma.h"
 #include "../hw/include/bn_hw_memory.h"
 #include "../hw/include/bn_hw_bg_blocks.h"
+#include "../hw/include/bn_hw_decompress.h"
 
 #include "bn_bg_maps.cpp.h"
 #include "bn_bg_tiles.cpp.h"
@@ -124,6 +129,14 @@ namespace
             hw::decompress::huff(source_ptr, destination_ptr);
             break;
 
+        case compression_type::LZ4:
+            hw::decompress::lz4(source_ptr, destination_ptr);
+            break;
+
+        case compression_type::RANS:
+            hw::decompress::rans(source_ptr, destination_ptr);
+            break;
+
         default:
             BN_ERROR("Unknown compression type: ", int(compression));
             break;
@@ -172,11 +185,52 @@ namespace
         }
     }
 
+    void _hw_relocate(int source_block, int destination_block, int blocks_count, bool use_dma)
+    {
+        constexpr int words_per_block = hw::bg_blocks::half_words_per_block() / 2;
+
+        // Items are always moved to lower blocks, so copying them block by block never reads overwritten data:
+        for(int index = 0; index < blocks_count; ++index)
+        {
+            const uint16_t* source_vram_ptr = hw::bg_blocks::vram(source_block + index);
+            uint16_t* destination_vram_ptr = hw::bg_blocks::vram(destination_block + index);
+
+            if(use_dma)
+            {
+                hw::dma::copy_words(source_vram_ptr, words_per_block, destination_vram_ptr);
+            }
+            else
+            {
+                hw::memory::copy_words(source_vram_ptr, words_per_block, destination_vram_ptr);
+            }
+        }
+    }
+
+    void _hw_offset_cells(uint16_t offset, int half_words, uint16_t* vram_ptr)
+    {
+        if(offset && half_words)
+        {
+            bn_hw_bg_blocks_commit_half_words(vram_ptr, unsigned(half_words), offset, vram_ptr);
+        }
+    }
+
 
     constexpr int max_items = BN_CFG_BG_BLOCKS_MAX_ITEMS;
     constexpr int max_overwrite_tile_items = BN_CFG_BG_BLOCKS_MAX_OVERWRITE_TILES;
     constexpr int max_list_items = max_items + 1;
 
+    constexpr int max_tiles_map_items = [](){
+        int minimum = max_items * 2;
+        int result = 2;
+
+        while(result < minimum)
+        {
+            result *= 2;
+        }
+
+        return result;
+    }();
+
 
     enum class status_type
     {
@@ -200,19 +254,24 @@ namespace
 
     public:
         const uint16_t* data = nullptr;
+        const uint16_t* equal_data = nullptr; // Only used if is_tiles == true.
+        unsigned content_hash = 0; // Only used if is_tiles == true.
         unsigned usages = 0;
         optional<regular_bg_tiles_ptr> regular_tiles;
         optional<affine_bg_tiles_ptr> affine_tiles;
         optional<bg_palette_ptr> palette;
         uint16_t width = 0; // If is_tiles == true, it stores half_words.
         uint16_t height = 0;
+        uint16_t cells_offset_delta = 0; // Only used if offset_cells == true.
         uint8_t start_block = 0;
         uint8_t blocks_count = 0;
         uint8_t next_index = max_list_items;
+        uint8_t relocation_start_block = 0; // Only used if relocate == true.
+        uint8_t next_same_key_id = max_list_items; // Only used if is_tiles == true.
 
     private:
         uint8_t _status: 2 = uint8_t(status_type::FREE);
-        uint8_t _compression: 2 = uint8_t(compression_type::NONE);
+        uint8_t _compression: 3 = uint8_t(compression_type::NONE);
         uint8_t _big_map_canvas_size: 2 = uint8_t(affine_bg_big_map_canvas_size::NORMAL);
         bool is_bpp_8: 1 = false;
 
@@ -221,6 +280,9 @@ namespace
         bool is_big: 1 = false;
         bool is_affine: 1 = false;
         bool commit: 1 = false;
+        bool pinned: 1 = false; // Relocation disabled.
+        bool relocate: 1 = false; // VRAM data must be moved from relocation_start_block.
+        bool offset_cells: 1 = false; // Map cells in VRAM must be offset by cells_offset_delta.
 
         [[nodiscard]] status_type status() const
         {
@@ -391,6 +453,16 @@ namespace
             return iterator(_items[index].next_index, *this);
         }
 
+        void swap_after(int index)
+        {
+            auto first_index = int(_items[index].next_index);
+            auto second_index = int(_items[first_index].next_index);
+            auto next_index = int(_items[second_index].next_index);
+            _join(index, second_index);
+            _join(second_index, first_index);
+            _join(first_index, next_index);
+        }
+
     private:
         item_type _items[max_list_items];
         alignas(int) int8_t _free_indices_array[max_items];
@@ -487,23 +559,35 @@ namespace
     };
 
 
+    using tiles_map_type = unordered_map<unsigned, uint8_t, max_tiles_map_items, identity_hasher>;
+
+
     class static_data
     {
 
     public:
         items_list items;
+        tiles_map_type tiles_map;
         alignas(int) uint8_t to_commit_uncompressed_items_array[max_items];
         alignas(int) uint8_t to_commit_compressed_items_array[max_items];
+        alignas(int) uint8_t to_relocate_items_array[max_items];
         overwrite_tile_item_type overwrite_tile_items[max_overwrite_tile_items];
         affine_bg_big_map_canvas_info new_affine_big_map_canvas_info;
+        hw::decompress::stream tiles_stream;
+        int tiles_stream_max_bytes_per_frame = 0;
+        int tiles_stream_item_id = -1;
         int free_blocks_count = 0;
         int to_remove_blocks_count = 0;
         int to_commit_uncompressed_items_count = 0;
         int to_commit_compressed_items_count = 0;
+        int to_relocate_items_count = 0;
         int overwrite_tile_items_count = 0;
         bool allow_tiles_offset = true;
         bool check_commit = false;
         bool delay_commit = false;
+        bool compaction_enabled = false;
+        bool compaction_pending = false;
+        bool check_tiles_stream = false;
     };
 
     alignas(static_data) BN_DATA_EWRAM_BSS char data_buffer[sizeof(static_data)];
@@ -538,6 +622,7 @@ namespace
     struct create_data
     {
         const uint16_t* data_ptr;
+        unsigned content_hash;
         int blocks_count;
         int width;
         int height;
@@ -552,26 +637,26 @@ namespace
         bool check_padding;
 
         static create_data from_regular_tiles(
-                const uint16_t* data_ptr, int half_words, bpp_mode bpp, compression_type compression,
-                bool allow_offset)
+                const uint16_t* data_ptr, unsigned content_hash, int half_words, bpp_mode bpp,
+                compression_type compression, bool allow_offset)
         {
             int blocks_count = _ceil_half_words_to_blocks(half_words);
             create_type create_type = allow_offset ?
                     create_type::REGULAR_TILES_WITH_OFFSET : create_type::TILES_WITHOUT_OFFSET;
 
-            return create_data{ data_ptr, blocks_count, half_words, 1, nullopt, nullopt, nullopt,
+            return create_data{ data_ptr, content_hash, blocks_count, half_words, 1, nullopt, nullopt, nullopt,
                         create_type, bpp, compression, false, false, true };
         }
 
         static create_data from_affine_tiles(
-                const uint16_t* data_ptr, int half_words, compression_type compression,
+                const uint16_t* data_ptr, unsigned content_hash, int half_words, compression_type compression,
                 bool allow_offset)
         {
             int blocks_count = _ceil_half_words_to_blocks(half_words);
             create_type create_type = allow_offset ?
                     create_type::AFFINE_TILES_WITH_OFFSET : create_type::TILES_WITHOUT_OFFSET;
 
-            return create_data{ data_ptr, blocks_count, half_words, 1, nullopt, nullopt, nullopt,
+            return create_data{ data_ptr, content_hash, blocks_count, half_words, 1, nullopt, nullopt, nullopt,
                         create_type, bpp_mode::BPP_8, compression, false, true, true };
         }
 
@@ -581,7 +666,7 @@ namespace
             create_type create_type = create_type::TILES_WITHOUT_OFFSET;
             compression_type compression = compression_type::NONE;
 
-            return create_data{ nullptr, blocks_count, half_words, 1, nullopt, nullopt, nullopt,
+            return create_data{ nullptr, 0, blocks_count, half_words, 1, nullopt, nullopt, nullopt,
                         create_type, bpp_mode::BPP_8, compression, false, true, false };
         }
 
@@ -593,7 +678,7 @@ namespace
             int height = dimensions.height();
             int blocks_count = _new_regular_map_blocks_count(width, height, big);
 
-            return create_data{ data_ptr, blocks_count, width, height, move(tiles), nullopt, move(palette),
+            return create_data{ data_ptr, 0, blocks_count, width, height, move(tiles), nullopt, move(palette),
                         create_type::MAP, bpp, compression, big, false, false };
         }
 
@@ -605,7 +690,7 @@ namespace
             int height = dimensions.height();
             int blocks_count = _new_affine_map_blocks_count(width, height, big);
 
-            return create_data{ data_ptr, blocks_count, width, height, nullopt, move(tiles), move(palette),
+            return create_data{ data_ptr, 0, blocks_count, width, height, nullopt, move(tiles), move(palette),
                         create_type::MAP, bpp_mode::BPP_8, compression, big, true, false };
         }
 
@@ -709,6 +794,33 @@ namespace
     #endif
 
 
+    #if BN_CFG_LOG_ENABLED
+        void _log_fragmentation_status()
+        {
+            static_data& data = data_ref();
+            int free_items_count = 0;
+            int max_free_blocks_count = 0;
+
+            for(const item_type& item : data.items)
+            {
+                if(item.status() == status_type::FREE)
+                {
+                    ++free_items_count;
+                    max_free_blocks_count = max(max_free_blocks_count, int(item.blocks_count));
+                }
+            }
+
+            int free_blocks_count = data.free_blocks_count;
+            int fragmentation = free_blocks_count ? 100 - ((max_free_blocks_count * 100) / free_blocks_count) : 0;
+            BN_LOG("free_items_count: ", free_items_count);
+            BN_LOG("max_free_blocks_count: ", max_free_blocks_count);
+            BN_LOG("fragmentation: ", fragmentation, '%');
+            BN_LOG("compaction_enabled: ", (data.compaction_enabled ? "true" : "false"));
+            BN_LOG("compaction_pending: ", (data.compaction_pending ? "true" : "false"));
+        }
+    #endif
+
+
     #if BN_CFG_BG_BLOCKS_LOG_ENABLED
         void _log_status()
         {
@@ -768,6 +880,7 @@ namespace
 
             BN_LOG("free_blocks_count: ", data.free_blocks_count);
             BN_LOG("to_remove_blocks_count: ", data.to_remove_blocks_count);
+            _log_fragmentation_status();
             BN_LOG("allow_tiles_offset: ", (data.allow_tiles_offset ? "true" : "false"));
             BN_LOG("check_commit: ", (data.check_commit ? "true" : "false"));
             BN_LOG("delay_commit: ", (data.delay_commit ? "true" : "false"));
@@ -788,45 +901,196 @@ namespace
             BN_BG_BLOCKS_SANITY_CHECK
     #endif
 
-    [[nodiscard]] int _find_tiles_impl(
-            const uint16_t* tiles_data, compression_type compression, int half_words, bpp_mode bpp, bool affine)
+    [[nodiscard]] unsigned _tiles_key(const uint16_t* tiles_data, unsigned content_hash, compression_type compression)
+    {
+        // Uncompressed tiles with content hash are indexed by it, so items which reference different copies
+        // of the same tiles share VRAM.
+        // Hash keys have the lowest bit set and pointer keys don't (tiles data is aligned),
+        // so they can't collide:
+        if(content_hash && compression == compression_type::NONE)
+        {
+            return (content_hash << 1) | 1;
+        }
+
+        return unsigned(uintptr_t(tiles_data)) & ~1U;
+    }
+
+    [[nodiscard]] unsigned _tiles_key(const item_type& item)
+    {
+        return _tiles_key(item.data, item.content_hash, item.compression());
+    }
+
+    [[nodiscard]] bool _tiles_indexable(const item_type& item)
+    {
+        return item.is_tiles && item.data;
+    }
+
+    [[nodiscard]] bool _tiles_match(item_type& item, const uint16_t* tiles_data, unsigned tiles_key,
+                                    compression_type compression, int half_words, bpp_mode bpp, bool affine)
+    {
+        if(! _tiles_indexable(item) || _tiles_key(item) != tiles_key || compression != item.compression() ||
+                half_words != item.width || bpp != item.bpp() || affine != item.is_affine)
+        {
+            return false;
+        }
+
+        if(item.data == tiles_data || item.equal_data == tiles_data)
+        {
+            return true;
+        }
+
+        // Hash collisions can't make different tiles share VRAM,
+        // so tiles data with the same hash is fully compared the first time only:
+        if(! equal(tiles_data, tiles_data + half_words, item.data))
+        {
+            return false;
+        }
+
+        item.equal_data = tiles_data;
+        return true;
+    }
+
+    // Items with the same key are chained from the indexed one,
+    // so the key stays indexed until all of them are unindexed:
+    void _index_tiles(int id)
     {
         static_data& data = data_ref();
+        item_type& item = data.items.item(id);
 
-        for(auto iterator = data.items.begin(), end = data.items.end(); iterator != end; ++iterator)
+        if(_tiles_indexable(item))
         {
-            item_type& item = *iterator;
+            unsigned tiles_key = _tiles_key(item);
+            tiles_map_type& tiles_map = data.tiles_map;
+            auto tiles_map_iterator = tiles_map.find(tiles_key);
 
-            if(item.data == tiles_data && item.is_tiles && compression == item.compression() &&
-                    half_words == item.width && bpp == item.bpp() && affine == item.is_affine)
+            if(tiles_map_iterator == tiles_map.end())
             {
-                switch(item.status())
-                {
+                item.next_same_key_id = max_list_items;
+                tiles_map.insert(tiles_key, uint8_t(id));
+            }
+            else
+            {
+                item.next_same_key_id = tiles_map_iterator->second;
+                tiles_map_iterator->second = uint8_t(id);
+            }
+        }
+    }
 
-                case status_type::FREE:
-                    BN_ERROR("Invalid item state");
-                    break;
+    void _unindex_tiles(int id)
+    {
+        static_data& data = data_ref();
+        item_type& item = data.items.item(id);
 
-                case status_type::USED:
-                    ++item.usages;
-                    break;
+        if(_tiles_indexable(item))
+        {
+            tiles_map_type& tiles_map = data.tiles_map;
+            auto tiles_map_iterator = tiles_map.find(_tiles_key(item));
 
-                case status_type::TO_REMOVE:
-                    item.usages = 1;
-                    item.set_status(status_type::USED);
-                    data.to_remove_blocks_count -= item.blocks_count;
-                    break;
+            if(tiles_map_iterator != tiles_map.end())
+            {
+                int next_id = item.next_same_key_id;
+                int previous_id = tiles_map_iterator->second;
 
-                default:
-                    BN_ERROR("Invalid item status: ", int(item.status()));
-                    break;
+                if(previous_id == id)
+                {
+                    if(next_id == max_list_items)
+                    {
+                        tiles_map.erase(tiles_map_iterator);
+                    }
+                    else
+                    {
+                        tiles_map_iterator->second = uint8_t(next_id);
+                    }
                 }
+                else
+                {
+                    // Items which are not indexed anymore (like split padding items) are not found:
+                    while(previous_id != max_list_items)
+                    {
+                        item_type& previous_item = data.items.item(previous_id);
 
-                BN_BG_BLOCKS_LOG("TILES FOUND. start_block: ", item.start_block);
-                BN_BG_BLOCKS_LOG_STATUS();
+                        if(previous_item.next_same_key_id == id)
+                        {
+                            previous_item.next_same_key_id = uint8_t(next_id);
+                            break;
+                        }
 
-                return iterator.id();
+                        previous_id = previous_item.next_same_key_id;
+                    }
+                }
+            }
+
+            item.next_same_key_id = max_list_items;
+        }
+    }
+
+    [[nodiscard]] int _find_tiles_id(const uint16_t* tiles_data, unsigned tiles_key, compression_type compression,
+                                     int half_words, bpp_mode bpp, bool affine)
+    {
+        static_data& data = data_ref();
+        auto tiles_map_iterator = data.tiles_map.find(tiles_key);
+
+        if(tiles_map_iterator == data.tiles_map.end())
+        {
+            return -1;
+        }
+
+        // Only items with the same key are checked:
+        int id = tiles_map_iterator->second;
+
+        while(id != max_list_items)
+        {
+            item_type& item = data.items.item(id);
+
+            if(_tiles_match(item, tiles_data, tiles_key, compression, half_words, bpp, affine))
+            {
+                return id;
             }
+
+            id = item.next_same_key_id;
+        }
+
+        return -1;
+    }
+
+    [[nodiscard]] int _find_tiles_impl(
+            const uint16_t* tiles_data, unsigned content_hash, compression_type compression, int half_words,
+            bpp_mode bpp, bool affine)
+    {
+        static_data& data = data_ref();
+        int id = _find_tiles_id(tiles_data, _tiles_key(tiles_data, content_hash, compression), compression,
+                                half_words, bpp, affine);
+
+        if(id >= 0)
+        {
+            item_type& item = data.items.item(id);
+
+            switch(item.status())
+            {
+
+            case status_type::FREE:
+                BN_ERROR("Invalid item state");
+                break;
+
+            case status_type::USED:
+                ++item.usages;
+                break;
+
+            case status_type::TO_REMOVE:
+                item.usages = 1;
+                item.set_status(status_type::USED);
+                data.to_remove_blocks_count -= item.blocks_count;
+                break;
+
+            default:
+                BN_ERROR("Invalid item status: ", int(item.status()));
+                break;
+            }
+
+            BN_BG_BLOCKS_LOG("TILES FOUND. start_block: ", item.start_block);
+            BN_BG_BLOCKS_LOG_STATUS();
+
+            return id;
         }
 
         BN_BG_BLOCKS_LOG("TILES NOT FOUND");
@@ -971,6 +1235,80 @@ namespace
         return -1;
     }
 
+    [[nodiscard]] bool _streamed(const item_type& item)
+    {
+        if(! item.is_tiles || ! data_ref().tiles_stream_max_bytes_per_frame)
+        {
+            return false;
+        }
+
+        compression_type compression = item.compression();
+        return compression == compression_type::LZ77 || compression == compression_type::RUN_LENGTH ||
+                compression == compression_type::HUFFMAN;
+    }
+
+    void _cancel_stream(int id)
+    {
+        static_data& data = data_ref();
+
+        if(data.tiles_stream_item_id == id)
+        {
+            data.tiles_stream_item_id = -1;
+        }
+    }
+
+    [[nodiscard]] int _next_stream_item_id()
+    {
+        static_data& data = data_ref();
+
+        for(auto iterator = data.items.begin(), end = data.items.end(); iterator != end; ++iterator)
+        {
+            const item_type& item = *iterator;
+
+            if(item.commit && item.status() == status_type::USED && _streamed(item))
+            {
+                return iterator.id();
+            }
+        }
+
+        return -1;
+    }
+
+    void _update_stream()
+    {
+        static_data& data = data_ref();
+        hw::decompress::stream& tiles_stream = data.tiles_stream;
+        int remaining_bytes = data.tiles_stream_max_bytes_per_frame;
+
+        while(remaining_bytes > 0)
+        {
+            int id = data.tiles_stream_item_id;
+
+            if(id < 0)
+            {
+                id = _next_stream_item_id();
+
+                if(id < 0)
+                {
+                    data.check_tiles_stream = false;
+                    return;
+                }
+
+                const item_type& item = data.items.item(id);
+                tiles_stream.init(item.data, hw::bg_blocks::vram(item.start_block));
+                data.tiles_stream_item_id = id;
+            }
+
+            remaining_bytes -= tiles_stream.decompress(remaining_bytes);
+
+            if(tiles_stream.done())
+            {
+                data.items.item(id).commit = false;
+                data.tiles_stream_item_id = -1;
+            }
+        }
+    }
+
     void _commit_item(const item_type& item, bool use_dma)
     {
         const uint16_t* source_data_ptr = item.data;
@@ -1076,6 +1414,9 @@ namespace
     [[nodiscard]] int _create_item(int id, int padding_blocks_count, bool delay_commit, create_data&& create_data)
     {
         static_data& data = data_ref();
+        _unindex_tiles(id);
+        _cancel_stream(id);
+
         item_type* item = &data.items.item(id);
         int blocks_count = create_data.blocks_count;
 
@@ -1151,6 +1492,8 @@ namespace
 
         const uint16_t* data_ptr = create_data.data_ptr;
         item->data = data_ptr;
+        item->equal_data = nullptr;
+        item->content_hash = create_data.content_hash;
         item->blocks_count = uint8_t(blocks_count);
         item->set_compression(create_data.compression);
         item->set_big_map_canvas_size(data.new_affine_big_map_canvas_info.canvas_size());
@@ -1165,12 +1508,15 @@ namespace
         item->set_bpp(create_data.bpp);
         item->is_big = create_data.is_big;
         item->is_affine = create_data.is_affine;
+        item->pinned = false;
+        item->relocate = false;
+        item->offset_cells = false;
 
         bool commit_item = false;
 
         if(data_ptr)
         {
-            if(delay_commit)
+            if(delay_commit || _streamed(*item))
             {
                 commit_item = true;
                 data.check_commit = true;
@@ -1182,6 +1528,7 @@ namespace
         }
 
         item->commit = commit_item;
+        _index_tiles(id);
 
         return id;
     }
@@ -1327,12 +1674,261 @@ namespace
             if(adjacent_item_status == status_type::TO_REMOVE)
             {
                 data.free_blocks_count += adjacent_item.blocks_count;
+                _unindex_tiles(adjacent_id);
+                _cancel_stream(adjacent_id);
             }
         }
 
         return remove;
     }
 
+    [[nodiscard]] bool _map_uses_tiles(const item_type& map_item, int tiles_id)
+    {
+        if(map_item.is_tiles || map_item.status() != status_type::USED)
+        {
+            return false;
+        }
+
+        if(map_item.is_affine)
+        {
+            const affine_bg_tiles_ptr* affine_tiles = map_item.affine_tiles.get();
+            return affine_tiles && affine_tiles->handle() == tiles_id;
+        }
+
+        const regular_bg_tiles_ptr* regular_tiles = map_item.regular_tiles.get();
+        return regular_tiles && regular_tiles->handle() == tiles_id;
+    }
+
+    [[nodiscard]] bool _valid_tiles_start_block(const item_type& item, int start_block)
+    {
+        int alignment_blocks_count = hw::bg_blocks::tiles_alignment_blocks_count();
+        int extra_blocks_count = start_block % alignment_blocks_count;
+
+        if(item.start_block % alignment_blocks_count == 0)
+        {
+            // Tiles created without offset must stay aligned:
+            return ! extra_blocks_count;
+        }
+
+        int max_blocks_count;
+
+        if(item.is_affine)
+        {
+            max_blocks_count = hw::bg_blocks::max_affine_tiles_blocks_count();
+        }
+        else
+        {
+            max_blocks_count = item.bpp() == bpp_mode::BPP_4 ?
+                        hw::bg_blocks::max_bpp_4_regular_tiles_blocks_count() :
+                        hw::bg_blocks::max_bpp_8_regular_tiles_blocks_count();
+        }
+
+        return item.blocks_count + extra_blocks_count <= max_blocks_count;
+    }
+
+    [[nodiscard]] int _relocation_blocks_count(int id, int start_block)
+    {
+        static_data& data = data_ref();
+        const item_type& item = data.items.item(id);
+
+        if(item.status() != status_type::USED || ! item.data || item.is_big || item.pinned)
+        {
+            return 0;
+        }
+
+        if(! item.is_tiles)
+        {
+            return item.blocks_count;
+        }
+
+        if(! _valid_tiles_start_block(item, start_block))
+        {
+            return 0;
+        }
+
+        int result = item.blocks_count;
+
+        for(const item_type& map_item : data.items)
+        {
+            if(_map_uses_tiles(map_item, id))
+            {
+                // Maps which can't be reloaded from their source data keep their tiles in place:
+                if(! map_item.data || map_item.is_big)
+                {
+                    return 0;
+                }
+
+                // Map cells are offset in VRAM, so they are counted as if they were copied:
+                result += map_item.blocks_count;
+            }
+        }
+
+        return result;
+    }
+
+    void _relocate_item(int previous_id, int free_id, int id)
+    {
+        static_data& data = data_ref();
+        item_type& free_item = data.items.item(free_id);
+        item_type& item = data.items.item(id);
+        int old_start_block = item.start_block;
+        int new_start_block = free_item.start_block;
+
+        BN_BG_BLOCKS_LOG("RELOCATE: ", id, " - ", old_start_block, " - ", new_start_block);
+
+        if(item.is_tiles)
+        {
+            int alignment_blocks_count = hw::bg_blocks::tiles_alignment_blocks_count();
+            int old_tiles_cbb = old_start_block / alignment_blocks_count;
+            int new_tiles_cbb = new_start_block / alignment_blocks_count;
+
+            for(item_type& map_item : data.items)
+            {
+                if(_map_uses_tiles(map_item, id))
+                {
+                    if(new_tiles_cbb != old_tiles_cbb)
+                    {
+                        if(map_item.is_affine)
+                        {
+                            bgs_manager::update_affine_map_tiles_cbb(map_item.start_block, new_tiles_cbb);
+                        }
+                        else
+                        {
+                            bgs_manager::update_regular_map_tiles_cbb(map_item.start_block, new_tiles_cbb);
+                        }
+                    }
+
+                    // Map cells store the tiles offset, so they are updated in VRAM:
+                    if(! map_item.commit)
+                    {
+                        int tiles_offset_delta;
+                        uint16_t cells_offset_delta;
+
+                        if(map_item.is_affine)
+                        {
+                            tiles_offset_delta = _tiles_offset(new_start_block, bpp_mode::BPP_8) -
+                                    _tiles_offset(old_start_block, bpp_mode::BPP_8);
+                            cells_offset_delta = uint16_t(tiles_offset_delta * 0x0101);
+                        }
+                        else
+                        {
+                            bpp_mode bpp = map_item.bpp();
+                            tiles_offset_delta = _tiles_offset(new_start_block, bpp) -
+                                    _tiles_offset(old_start_block, bpp);
+                            cells_offset_delta = uint16_t(tiles_offset_delta);
+                        }
+
+                        if(map_item.offset_cells)
+                        {
+                            cells_offset_delta += map_item.cells_offset_delta;
+                        }
+
+                        map_item.cells_offset_delta = cells_offset_delta;
+                        map_item.offset_cells = true;
+                    }
+                }
+            }
+        }
+        else
+        {
+            if(item.is_affine)
+            {
+                bgs_manager::update_affine_map_sbb(old_start_block, new_start_block);
+            }
+            else
+            {
+                bgs_manager::update_regular_map_sbb(old_start_block, new_start_block);
+            }
+        }
+
+        _cancel_stream(id);
+        data.items.swap_after(previous_id);
+        item.start_block = uint8_t(new_start_block);
+        free_item.start_block = uint8_t(new_start_block + item.blocks_count);
+
+        // Items pending to be committed from their source data are committed in their new blocks.
+        // Otherwise, their VRAM data is moved in the next commit, instead of reloading it from ROM:
+        if(! item.commit && ! item.relocate)
+        {
+            item.relocation_start_block = uint8_t(old_start_block);
+            item.relocate = true;
+        }
+
+        data.check_commit = true;
+
+        // Old blocks can still be displayed until the next commit:
+        data.delay_commit = true;
+
+        // H-Blank effects attributes store the SBB and CBB of the backgrounds:
+        hblank_effects_manager::reload_bg_attributes();
+
+        int next_id = free_item.next_index;
+
+        if(next_id != max_list_items)
+        {
+            const item_type& next_item = data.items.item(next_id);
+
+            if(next_item.status() == status_type::FREE)
+            {
+                free_item.blocks_count += next_item.blocks_count;
+                data.items.erase_after(free_id);
+            }
+        }
+    }
+
+    void _compact(int max_blocks_count)
+    {
+        static_data& data = data_ref();
+        int relocated_blocks_count = 0;
+        bool relocated = true;
+
+        while(relocated)
+        {
+            relocated = false;
+
+            auto end = data.items.end();
+            auto previous_iterator = data.items.before_begin();
+            auto iterator = data.items.begin();
+
+            while(iterator != end && ! relocated)
+            {
+                if(iterator->status() == status_type::FREE)
+                {
+                    auto next_iterator = iterator;
+                    ++next_iterator;
+
+                    if(next_iterator != end)
+                    {
+                        int next_id = next_iterator.id();
+
+                        if(int blocks_count = _relocation_blocks_count(next_id, iterator->start_block))
+                        {
+                            // Items bigger than the limit are relocated alone:
+                            if(relocated_blocks_count && relocated_blocks_count + blocks_count > max_blocks_count)
+                            {
+                                return;
+                            }
+
+                            _relocate_item(previous_iterator.id(), iterator.id(), next_id);
+                            relocated_blocks_count += blocks_count;
+                            relocated = true;
+                        }
+                    }
+                }
+
+                previous_iterator = iterator;
+                ++iterator;
+            }
+
+            if(relocated_blocks_count >= max_blocks_count)
+            {
+                return;
+            }
+        }
+
+        data.compaction_pending = false;
+    }
+
     [[nodiscard]] int _fix_map_x(int map_x, int map_width)
     {
         map_x %= map_width;
@@ -1447,6 +2043,49 @@ void set_allow_tiles_offset(bool allow_tiles_offset)
     data_ref().allow_tiles_offset = allow_tiles_offset;
 }
 
+bool compaction_enabled()
+{
+    return data_ref().compaction_enabled;
+}
+
+void set_compaction_enabled(bool compaction_enabled)
+{
+    static_data& data = data_ref();
+    data.compaction_enabled = compaction_enabled;
+    data.compaction_pending = compaction_enabled;
+}
+
+int stream_max_bytes_per_frame()
+{
+    return data_ref().tiles_stream_max_bytes_per_frame;
+}
+
+void set_stream_max_bytes_per_frame(int max_bytes_per_frame)
+{
+    BN_ASSERT(max_bytes_per_frame >= 0, "Invalid max bytes per frame: ", max_bytes_per_frame);
+
+    static_data& data = data_ref();
+    data.tiles_stream_max_bytes_per_frame = max_bytes_per_frame;
+    data.tiles_stream_item_id = -1;
+    data.check_commit = true;
+}
+
+void compact()
+{
+    static_data& data = data_ref();
+
+    BN_BG_BLOCKS_LOG("bg_blocks_manager - COMPACT");
+
+    if(data.to_remove_blocks_count)
+    {
+        update();
+    }
+
+    _compact(numeric_limits<int>::max());
+
+    BN_BG_BLOCKS_LOG_STATUS();
+}
+
 #if BN_CFG_LOG_ENABLED
     void log_status()
     {
@@ -1499,6 +2138,7 @@ void set_allow_tiles_offset(bool allow_tiles_offset)
 
             BN_LOG("free_blocks_count: ", data.free_blocks_count);
             BN_LOG("to_remove_blocks_count: ", data.to_remove_blocks_count);
+            _log_fragmentation_status();
         #endif
     }
 #endif
@@ -1514,7 +2154,8 @@ int find_regular_tiles(const regular_bg_tiles_item& tiles_item)
     BN_BG_BLOCKS_LOG("bg_blocks_manager - FIND REGULAR TILES: ", tiles_data, " - ", tiles_count, " - ",
                      int(bpp), " - ", int(compression));
 
-    return _find_tiles_impl(tiles_data, compression, _tiles_to_half_words(tiles_count), bpp, false);
+    return _find_tiles_impl(tiles_data, tiles_item.content_hash(), compression, _tiles_to_half_words(tiles_count),
+                            bpp, false);
 }
 
 int find_affine_tiles(const affine_bg_tiles_item& tiles_item)
@@ -1527,7 +2168,8 @@ int find_affine_tiles(const affine_bg_tiles_item& tiles_item)
     BN_BG_BLOCKS_LOG("bg_blocks_manager - FIND AFFINE TILES: ", tiles_data, " - ", tiles_count, " - ",
                      int(compression));
 
-    return _find_tiles_impl(tiles_data, compression, _tiles_to_half_words(tiles_count), bpp_mode::BPP_8, true);
+    return _find_tiles_impl(tiles_data, tiles_item.content_hash(), compression, _tiles_to_half_words(tiles_count),
+                            bpp_mode::BPP_8, true);
 }
 
 int find_regular_map(const regular_bg_map_item& map_item, const regular_bg_map_cell* data_ptr,
@@ -1563,7 +2205,8 @@ int create_regular_tiles(const regular_bg_tiles_item& tiles_item, bool allow_off
                      tiles_data, " - ", tiles_count, " - ", _ceil_half_words_to_blocks(half_words), " - ",
                      int(bpp), " - ", int(compression), " - ", (allow_offset ? "allow offset" : "forbid offset"));
 
-    int result = _find_tiles_impl(tiles_data, compression, half_words, bpp, false);
+    unsigned content_hash = tiles_item.content_hash();
+    int result = _find_tiles_impl(tiles_data, content_hash, compression, half_words, bpp, false);
 
     if(result >= 0)
     {
@@ -1573,7 +2216,8 @@ int create_regular_tiles(const regular_bg_tiles_item& tiles_item, bool allow_off
     BN_ASSERT(regular_bg_tiles_item::valid_tiles_count(tiles_count, bpp),
               "Invalid tiles count: ", tiles_count, " - ", int(bpp));
 
-    result = _create_impl(create_data::from_regular_tiles(tiles_data, half_words, bpp, compression, allow_offset));
+    result = _create_impl(create_data::from_regular_tiles(tiles_data, content_hash, half_words, bpp, compression,
+                                                                  allow_offset));
 
     if(result >= 0)
     {
@@ -1614,7 +2258,8 @@ int create_affine_tiles(const affine_bg_tiles_item& tiles_item, bool allow_offse
                      tiles_data, " - ", tiles_count, " - ", _ceil_half_words_to_blocks(half_words), " - ",
                      int(compression), " - ", (allow_offset ? "allow offset" : "forbid offset"));
 
-    int result = _find_tiles_impl(tiles_data, compression, half_words, bpp_mode::BPP_8, true);
+    unsigned content_hash = tiles_item.content_hash();
+    int result = _find_tiles_impl(tiles_data, content_hash, compression, half_words, bpp_mode::BPP_8, true);
 
     if(result >= 0)
     {
@@ -1623,7 +2268,8 @@ int create_affine_tiles(const affine_bg_tiles_item& tiles_item, bool allow_offse
 
     BN_ASSERT(affine_bg_tiles_item::valid_tiles_count(tiles_count), "Invalid tiles count: ", tiles_count);
 
-    result = _create_impl(create_data::from_affine_tiles(tiles_data, half_words, compression, allow_offset));
+    result = _create_impl(create_data::from_affine_tiles(tiles_data, content_hash, half_words, compression,
+                                                                 allow_offset));
 
     if(result >= 0)
     {
@@ -1783,7 +2429,7 @@ int allocate_regular_tiles(int tiles_count, bpp_mode bpp, bool allow_offset, boo
               "Invalid tiles count: ", tiles_count, " - ", int(bpp));
 
     int result = _allocate_impl(
-            create_data::from_regular_tiles(nullptr, half_words, bpp, compression_type::NONE, allow_offset));
+            create_data::from_regular_tiles(nullptr, 0, half_words, bpp, compression_type::NONE, allow_offset));
 
     if(result >= 0)
     {
@@ -1822,7 +2468,7 @@ int allocate_affine_tiles(int tiles_count, bool allow_offset, bool optional)
     BN_ASSERT(affine_bg_tiles_item::valid_tiles_count(tiles_count), "Invalid tiles count: ", tiles_count);
 
     int result = _allocate_impl(
-            create_data::from_affine_tiles(nullptr, half_words, compression_type::NONE, allow_offset));
+            create_data::from_affine_tiles(nullptr, 0, half_words, compression_type::NONE, allow_offset));
 
     if(result >= 0)
     {
@@ -2160,22 +2806,33 @@ void set_regular_tiles_ref(int id, const regular_bg_tiles_item& tiles_item)
     BN_BASIC_ASSERT(tiles_item.bpp() == item.bpp(),
                     "Tiles BPP does not match item BPP: ", int(tiles_item.bpp()), " - ", int(item.bpp()));
 
-    if(item_data != data_ptr)
+    unsigned content_hash = tiles_item.content_hash();
+
+    if(item_data != data_ptr || content_hash != item.content_hash)
     {
         BN_BASIC_ASSERT(item_data, "Item has no data");
 
+        _unindex_tiles(id);
+        _cancel_stream(id);
         item.data = data_ptr;
+        item.equal_data = nullptr;
+        item.content_hash = content_hash;
         item.set_compression(compression);
         item.commit = true;
         data.check_commit = true;
+        _index_tiles(id);
 
         BN_BG_BLOCKS_LOG_STATUS();
     }
     else if(compression != item.compression())
     {
+        // Compression is part of the tiles key:
+        _unindex_tiles(id);
+        _cancel_stream(id);
         item.set_compression(compression);
         item.commit = true;
         data.check_commit = true;
+        _index_tiles(id);
 
         BN_BG_BLOCKS_LOG_STATUS();
     }
@@ -2196,22 +2853,33 @@ void set_affine_tiles_ref(int id, const affine_bg_tiles_item& tiles_item)
     BN_BASIC_ASSERT(tiles_ref.size() == item.tiles_count(),
                     "Tiles count does not match item tiles count: ", tiles_ref.size(), " - ", item.tiles_count());
 
-    if(item_data != data_ptr)
+    unsigned content_hash = tiles_item.content_hash();
+
+    if(item_data != data_ptr || content_hash != item.content_hash)
     {
         BN_BASIC_ASSERT(item_data, "Item has no data");
 
+        _unindex_tiles(id);
+        _cancel_stream(id);
         item.data = data_ptr;
+        item.equal_data = nullptr;
+        item.content_hash = content_hash;
         item.set_compression(compression);
         item.commit = true;
         data.check_commit = true;
+        _index_tiles(id);
 
         BN_BG_BLOCKS_LOG_STATUS();
     }
     else if(compression != item.compression())
     {
+        // Compression is part of the tiles key:
+        _unindex_tiles(id);
+        _cancel_stream(id);
         item.set_compression(compression);
         item.commit = true;
         data.check_commit = true;
+        _index_tiles(id);
 
         BN_BG_BLOCKS_LOG_STATUS();
     }
@@ -2251,6 +2919,7 @@ void set_regular_map_cells_ref(int id, const regular_bg_map_item& map_item, cons
     }
     else if(compression != item.compression())
     {
+        _cancel_stream(id);
         item.set_compression(compression);
         item.commit = true;
         data.check_commit = true;
@@ -2295,6 +2964,7 @@ void set_affine_map_cells_ref(int id, const affine_bg_map_item& map_item, const
     }
     else if(compression != item.compression())
     {
+        _cancel_stream(id);
         item.set_compression(compression);
         item.commit = true;
         data.check_commit = true;
@@ -2312,6 +2982,7 @@ void reload(int id)
 
     BN_BASIC_ASSERT(item.data, "Item has no data");
 
+    _cancel_stream(id);
     item.commit = true;
     data.check_commit = true;
 
@@ -2338,6 +3009,9 @@ void overwrite_tile(int id, int tile_index, const tile& tiles_ref)
 
     overwrite_tile_item_type& overwrite_tile_item = data.overwrite_tile_items[data.overwrite_tile_items_count];
     ++data.overwrite_tile_items_count;
+
+    // Overwritten tiles would be lost if the item were relocated:
+    item.pinned = true;
     overwrite_tile_item = { source_ptr, uint16_t(tile_index), uint8_t(id), uint8_t(words_count) };
 }
 
@@ -3047,6 +3721,14 @@ void update()
 {
     static_data& data = data_ref();
 
+    if(data.compaction_pending && data.compaction_enabled && ! data.to_remove_blocks_count)
+    {
+        constexpr int max_blocks_count = BN_CFG_BG_BLOCKS_COMPACTION_MAX_BYTES_PER_FRAME /
+                (hw::bg_blocks::half_words_per_block() * 2);
+
+        _compact(max(max_blocks_count, 1));
+    }
+
     if(data.to_remove_blocks_count || data.check_commit)
     {
         data.to_remove_blocks_count = 0;
@@ -3062,6 +3744,7 @@ void update()
 
         int commit_uncompressed_items_count = 0;
         int commit_compressed_items_count = 0;
+        int relocate_items_count = 0;
 
         while(iterator != end)
         {
@@ -3070,12 +3753,20 @@ void update()
 
             if(item_status == status_type::TO_REMOVE)
             {
+                _unindex_tiles(iterator.id());
+                _cancel_stream(iterator.id());
                 item.data = nullptr;
+                item.equal_data = nullptr;
+                item.content_hash = 0;
                 item.width = 0;
                 item.height = 0;
                 item.set_status(status_type::FREE);
                 item.commit = false;
+                item.pinned = false;
+                item.relocate = false;
+                item.offset_cells = false;
                 data.free_blocks_count += item.blocks_count;
+                data.compaction_pending = true;
 
                 auto next_iterator = iterator;
                 ++next_iterator;
@@ -3104,7 +3795,15 @@ void update()
             }
             else if(item.commit)
             {
-                if(item.compression() == compression_type::NONE)
+                // Items committed from their source data don't need to be relocated in VRAM:
+                item.relocate = false;
+                item.offset_cells = false;
+
+                if(_streamed(item))
+                {
+                    data.check_tiles_stream = true;
+                }
+                else if(item.compression() == compression_type::NONE)
                 {
                     data.to_commit_uncompressed_items_array[commit_uncompressed_items_count] = uint8_t(iterator.id());
                     ++commit_uncompressed_items_count;
@@ -3115,6 +3814,11 @@ void update()
                     ++commit_compressed_items_count;
                 }
             }
+            else if(item.relocate || item.offset_cells)
+            {
+                data.to_relocate_items_array[relocate_items_count] = uint8_t(iterator.id());
+                ++relocate_items_count;
+            }
 
             before_previous_iterator = previous_iterator;
             previous_iterator = iterator;
@@ -3123,6 +3827,7 @@ void update()
 
         data.to_commit_uncompressed_items_count = commit_uncompressed_items_count;
         data.to_commit_compressed_items_count = commit_compressed_items_count;
+        data.to_relocate_items_count = relocate_items_count;
 
         BN_BG_BLOCKS_LOG_STATUS();
     }
@@ -3130,10 +3835,57 @@ void update()
     data.delay_commit = false;
 }
 
+bool must_commit()
+{
+    const static_data& data = data_ref();
+    return data.to_commit_uncompressed_items_count || data.overwrite_tile_items_count ||
+            data.to_commit_compressed_items_count || data.to_relocate_items_count || data.check_tiles_stream;
+}
+
 void commit_uncompressed(bool use_dma)
 {
     static_data& data = data_ref();
 
+    if(int relocate_items_count = data.to_relocate_items_count)
+    {
+        BN_BG_BLOCKS_LOG("bg_blocks_manager - COMMIT RELOCATED");
+
+        data.to_relocate_items_count = 0;
+
+        // Relocated items are moved before committing other items, since they can be placed in their old blocks:
+        for(int index = 0; index < relocate_items_count; ++index)
+        {
+            int item_index = data.to_relocate_items_array[index];
+            item_type& item = data.items.item(item_index);
+
+            if(item.relocate)
+            {
+                item.relocate = false;
+                _hw_relocate(item.relocation_start_block, item.start_block, item.blocks_count, use_dma);
+            }
+        }
+
+        for(int index = 0; index < relocate_items_count; ++index)
+        {
+            int item_index = data.to_relocate_items_array[index];
+            item_type& item = data.items.item(item_index);
+
+            if(item.offset_cells)
+            {
+                item.offset_cells = false;
+
+                int half_words = item.width * item.height;
+
+                if(item.is_affine)
+                {
+                    half_words /= 2;
+                }
+
+                _hw_offset_cells(item.cells_offset_delta, half_words, hw::bg_blocks::vram(item.start_block));
+            }
+        }
+    }
+
     if(int commit_items_count = data.to_commit_uncompressed_items_count)
     {
         BN_BG_BLOCKS_LOG("bg_blocks_manager - COMMIT UNCOMPRESSED");
@@ -3200,6 +3952,11 @@ void commit_compressed()
 
         BN_BG_BLOCKS_LOG_STATUS();
     }
+
+    if(data.check_tiles_stream)
+    {
+        _update_stream();
+    }
 }
 
 }
@@ -56,6 +56,16 @@ namespace bn::bg_blocks_manager
 
     void set_allow_tiles_offset(bool allow_tiles_offset);
 
+    [[nodiscard]] bool compaction_enabled();
+
+    void set_compaction_enabled(bool compaction_enabled);
+
+    void compact();
+
+    [[nodiscard]] int stream_max_bytes_per_frame();
+
+    void set_stream_max_bytes_per_frame(int max_bytes_per_frame);
+
     #if BN_CFG_LOG_ENABLED
         void log_status();
     #endif
@@ -222,6 +232,8 @@ namespace bn::bg_blocks_manager
 
     void update();
 
+    [[nodiscard]] bool must_commit();
+
     void commit_uncompressed(bool use_dma);
 
     void commit_compressed();
@@ -332,4 +332,24 @@ void bg_palette_ptr::set_rotate_range(int start, int size)
     palettes_manager::bg_palettes_bank().set_rotate_range(_id, start, size);
 }
 
+bool bg_palette_ptr::has_animation() const
+{
+    return palettes_manager::bg_palettes_bank().has_animation(_id);
+}
+
+bool bg_palette_ptr::animation_done() const
+{
+    return palettes_manager::bg_palettes_bank().animation_done(_id);
+}
+
+void bg_palette_ptr::set_animation(const palette_animation_item& animation_item)
+{
+    palettes_manager::bg_palettes_bank().set_animation(_id, animation_item);
+}
+
+void bg_palette_ptr::remove_animation()
+{
+    palettes_manager::bg_palettes_bank().remove_animation(_id);
+}
+
 }
@@ -40,6 +40,31 @@ void set_allow_offset(bool allow_offset)
     bg_blocks_manager::set_allow_tiles_offset(allow_offset);
 }
 
+bool compaction_enabled()
+{
+    return bg_blocks_manager::compaction_enabled();
+}
+
+void set_compaction_enabled(bool compaction_enabled)
+{
+    bg_blocks_manager::set_compaction_enabled(compaction_enabled);
+}
+
+void compact()
+{
+    bg_blocks_manager::compact();
+}
+
+int stream_max_bytes_per_frame()
+{
+    return bg_blocks_manager::stream_max_bytes_per_frame();
+}
+
+void set_stream_max_bytes_per_frame(int max_bytes_per_frame)
+{
+    bg_blocks_manager::set_stream_max_bytes_per_frame(max_bytes_per_frame);
+}
+
 void log_status()
 {
     #if BN_CFG_LOG_ENABLED
@@ -1807,6 +1807,34 @@ void update_regular_map_bpp(int map_id, bpp_mode bpp)
     }
 }
 
+void update_regular_map_sbb(int map_id, int map_sbb)
+{
+    for(item_type* item : data_ref().items_vector)
+    {
+        regular_bg_map_ptr* item_regular_map = item->regular_map.get();
+
+        if(item_regular_map && item_regular_map->id() == map_id)
+        {
+            hw::bgs::set_map_sbb(map_sbb, item->hw_cnt);
+            _update_item_hw_cnt(*item);
+        }
+    }
+}
+
+void update_affine_map_sbb(int map_id, int map_sbb)
+{
+    for(item_type* item : data_ref().items_vector)
+    {
+        affine_bg_map_ptr* item_affine_map = item->affine_map.get();
+
+        if(item_affine_map && item_affine_map->id() == map_id)
+        {
+            hw::bgs::set_map_sbb(map_sbb, item->hw_cnt);
+            _update_item_hw_cnt(*item);
+        }
+    }
+}
+
 void reload()
 {
     data_ref().commit = true;
@@ -2044,6 +2072,19 @@ void commit(bool use_dma)
     }
 }
 
+bool must_commit_big_maps()
+{
+    for(const item_type* item : data_ref().items_vector)
+    {
+        if(item->commit_big_map)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 void commit_big_maps()
 {
     for(item_type* item : data_ref().items_vector)
@@ -228,6 +228,10 @@ namespace bgs_manager
 
     void update_regular_map_bpp(int map_id, bpp_mode bpp);
 
+    void update_regular_map_sbb(int map_id, int map_sbb);
+
+    void update_affine_map_sbb(int map_id, int map_sbb);
+
     void reload();
 
     void fill_hblank_effect_regular_positions(int base_position, const fixed* positions_ptr, uint16_t* dest_ptr);
@@ -251,6 +255,8 @@ namespace bgs_manager
 
     void commit(bool use_dma);
 
+    [[nodiscard]] bool must_commit_big_maps();
+
     void commit_big_maps();
 
     void stop();
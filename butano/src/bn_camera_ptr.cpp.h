@@ -132,4 +132,14 @@ void camera_ptr::set_position(const fixed_point& position)
     cameras_manager::set_position(_id, position);
 }
 
+bool camera_ptr::sprites_culling_enabled() const
+{
+    return cameras_manager::sprites_culling_enabled(_id);
+}
+
+void camera_ptr::set_sprites_culling_enabled(bool sprites_culling_enabled)
+{
+    cameras_manager::set_sprites_culling_enabled(_id, sprites_culling_enabled);
+}
+
 }
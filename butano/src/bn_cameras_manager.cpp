@@ -6,6 +6,7 @@
 #include "bn_cameras_manager.h"
 
 #include "bn_limits.h"
+#include "bn_display.h"
 #include "bn_config_cameras.h"
 #include "bn_bgs_manager.h"
 #include "bn_sprites_manager.h"
@@ -23,13 +24,44 @@ namespace
 
     static_assert(max_items > 0 && max_items <= numeric_limits<uint8_t>::max());
 
+    constexpr culling_cells all_culling_cells = {
+        numeric_limits<int>::min(), numeric_limits<int>::min(),
+        numeric_limits<int>::max(), numeric_limits<int>::max()
+    };
+
 
     class item_type
     {
 
     public:
         fixed_point position;
+        culling_cells last_visible_sprites_cells = all_culling_cells;
         unsigned usages = 0;
+        bool sprites_culling_enabled = false;
+
+        void init(const fixed_point& _position)
+        {
+            position = _position;
+            last_visible_sprites_cells = all_culling_cells;
+            usages = 1;
+            sprites_culling_enabled = false;
+        }
+
+        [[nodiscard]] culling_cells visible_sprites_cells() const
+        {
+            // Sprites are on screen only if their center is closer than their half size (64 pixels at most)
+            // to the display borders:
+            constexpr int max_sprite_half_size = 64 + 1;
+            constexpr int half_width = (display::width() / 2) + max_sprite_half_size;
+            constexpr int half_height = (display::height() / 2) + max_sprite_half_size;
+
+            int x = position.x().right_shift_integer();
+            int y = position.y().right_shift_integer();
+            return {
+                (x - half_width) >> sprites_culling_cell_shift, (y - half_height) >> sprites_culling_cell_shift,
+                (x + half_width) >> sprites_culling_cell_shift, (y + half_height) >> sprites_culling_cell_shift
+            };
+        }
     };
 
 
@@ -38,6 +70,8 @@ namespace
 
     public:
         item_type items[max_items];
+        culling_cells sprites_culling_cells[max_items];
+        unsigned sprites_culling_buckets_mask = 0;
         alignas(int) uint8_t free_item_indexes_array[max_items];
         uint16_t free_item_indexes_size = max_items;
         bool update = false;
@@ -82,8 +116,7 @@ int create(const fixed_point& position)
 
     int item_index = data.free_item_indexes_array[data.free_item_indexes_size];
     item_type& new_item = data.items[item_index];
-    new_item.position = position;
-    new_item.usages = 1;
+    new_item.init(position);
     return item_index;
 }
 
@@ -100,8 +133,7 @@ int create_optional(const fixed_point& position)
 
     int item_index = data.free_item_indexes_array[data.free_item_indexes_size];
     item_type& new_item = data.items[item_index];
-    new_item.position = position;
-    new_item.usages = 1;
+    new_item.init(position);
     return item_index;
 }
 
@@ -166,6 +198,36 @@ void set_position(int id, const fixed_point& position)
     }
 }
 
+bool sprites_culling_enabled(int id)
+{
+    const item_type& item = data_ref().items[id];
+    return item.sprites_culling_enabled;
+}
+
+void set_sprites_culling_enabled(int id, bool enabled)
+{
+    static_data& data = data_ref();
+    item_type& item = data.items[id];
+
+    if(item.sprites_culling_enabled != enabled)
+    {
+        item.sprites_culling_enabled = enabled;
+        item.last_visible_sprites_cells = all_culling_cells;
+        data.update = true;
+        sprites_manager::update_camera_sprites_culling(id);
+    }
+}
+
+const culling_cells* sprites_culling_cells()
+{
+    return data_ref().sprites_culling_cells;
+}
+
+unsigned sprites_culling_buckets_mask()
+{
+    return data_ref().sprites_culling_buckets_mask;
+}
+
 void update()
 {
     static_data& data = data_ref();
@@ -174,6 +236,43 @@ void update()
     {
         data.update = false;
 
+        unsigned buckets_mask = 0;
+
+        for(int index = 0; index < max_items; ++index)
+        {
+            item_type& item = data.items[index];
+            culling_cells& sprites_cells = data.sprites_culling_cells[index];
+
+            if(item.usages && item.sprites_culling_enabled)
+            {
+                // Sprites in cells entering or leaving the display must be evaluated:
+                culling_cells visible_sprites_cells = item.visible_sprites_cells();
+                const culling_cells& last_visible_sprites_cells = item.last_visible_sprites_cells;
+                sprites_cells.min_x = min(visible_sprites_cells.min_x, last_visible_sprites_cells.min_x);
+                sprites_cells.min_y = min(visible_sprites_cells.min_y, last_visible_sprites_cells.min_y);
+                sprites_cells.max_x = max(visible_sprites_cells.max_x, last_visible_sprites_cells.max_x);
+                sprites_cells.max_y = max(visible_sprites_cells.max_y, last_visible_sprites_cells.max_y);
+                item.last_visible_sprites_cells = visible_sprites_cells;
+
+                // Grid cells are wrapped, so there's no need to visit more cells than buckets:
+                int last_x = min(sprites_cells.max_x, sprites_cells.min_x + sprites_culling_bucket_columns - 1);
+                int last_y = min(sprites_cells.max_y, sprites_cells.min_y + sprites_culling_bucket_rows - 1);
+
+                for(int y = sprites_cells.min_y; y <= last_y; ++y)
+                {
+                    for(int x = sprites_cells.min_x; x <= last_x; ++x)
+                    {
+                        buckets_mask |= 1U << sprites_culling_bucket(x, y);
+                    }
+                }
+            }
+            else
+            {
+                sprites_cells = all_culling_cells;
+            }
+        }
+
+        data.sprites_culling_buckets_mask = buckets_mask;
         display_manager::update_cameras();
         sprites_manager::update_cameras();
         bgs_manager::update_cameras();
@@ -11,6 +11,38 @@
 
 namespace bn::cameras_manager
 {
+    constexpr int sprites_culling_cell_shift = 8;
+    constexpr int sprites_culling_bucket_columns = 8;
+    constexpr int sprites_culling_bucket_rows = 4;
+    constexpr int sprites_culling_buckets_count = sprites_culling_bucket_columns * sprites_culling_bucket_rows;
+
+    static_assert(sprites_culling_buckets_count <= 32);
+
+
+    [[nodiscard]] constexpr int sprites_culling_bucket(int cell_x, int cell_y)
+    {
+        // Grid cells are wrapped, so each bucket holds the sprites of cells far away from each other:
+        return (cell_x & (sprites_culling_bucket_columns - 1)) +
+                ((cell_y & (sprites_culling_bucket_rows - 1)) * sprites_culling_bucket_columns);
+    }
+
+
+    class culling_cells
+    {
+
+    public:
+        int min_x;
+        int min_y;
+        int max_x;
+        int max_y;
+
+        [[nodiscard]] bool contains(int cell_x, int cell_y) const
+        {
+            return cell_x >= min_x && cell_x <= max_x && cell_y >= min_y && cell_y <= max_y;
+        }
+    };
+
+
     void init();
 
     [[nodiscard]] int used_items_count();
@@ -33,6 +65,14 @@ namespace bn::cameras_manager
 
     void set_position(int id, const fixed_point& position);
 
+    [[nodiscard]] bool sprites_culling_enabled(int id);
+
+    void set_sprites_culling_enabled(int id, bool enabled);
+
+    [[nodiscard]] const culling_cells* sprites_culling_cells();
+
+    [[nodiscard]] unsigned sprites_culling_buckets_mask();
+
     void update();
 }
 
@@ -18,12 +18,14 @@
 #include "bn_link_manager.h"
 #include "bn_gpio_manager.h"
 #include "bn_audio_manager.h"
+#include "bn_config_core.h"
 #include "bn_config_assert.h"
 #include "bn_keypad_manager.h"
 #include "bn_memory_manager.h"
 #include "bn_display_manager.h"
 #include "bn_sprites_manager.h"
 #include "bn_cameras_manager.h"
+#include "bn_profiler_engine.h"
 #include "bn_palettes_manager.h"
 #include "bn_bg_blocks_manager.h"
 #include "bn_sprite_tiles_manager.h"
@@ -36,6 +38,7 @@
 #include "../hw/include/bn_hw_timer.h"
 #include "../hw/include/bn_hw_game_pak.h"
 #include "../hw/include/bn_hw_hblank_effects.h"
+#include "../hw/include/bn_hw_pipelined_commit.h"
 
 #if BN_CFG_ASSERT_ENABLED
     #include "bn_assert_callback_type.h"
@@ -51,62 +54,6 @@
     #endif
 #endif
 
-#if BN_CFG_PROFILER_ENABLED && BN_CFG_PROFILER_LOG_ENGINE
-    #if BN_CFG_PROFILER_LOG_ENGINE_DETAILED
-        #define BN_PROFILER_ENGINE_GENERAL_START(id) \
-            do \
-            { \
-            } while(false)
-
-        #define BN_PROFILER_ENGINE_GENERAL_STOP() \
-            do \
-            { \
-            } while(false)
-
-        #define BN_PROFILER_ENGINE_DETAILED_START(id) \
-            BN_PROFILER_START(id)
-
-        #define BN_PROFILER_ENGINE_DETAILED_STOP() \
-            BN_PROFILER_STOP()
-    #else
-        #define BN_PROFILER_ENGINE_GENERAL_START(id) \
-            BN_PROFILER_START(id)
-
-        #define BN_PROFILER_ENGINE_GENERAL_STOP() \
-            BN_PROFILER_STOP()
-
-        #define BN_PROFILER_ENGINE_DETAILED_START(id) \
-            do \
-            { \
-            } while(false)
-
-        #define BN_PROFILER_ENGINE_DETAILED_STOP() \
-            do \
-            { \
-            } while(false)
-    #endif
-#else
-    #define BN_PROFILER_ENGINE_GENERAL_START(id) \
-        do \
-        { \
-        } while(false)
-
-    #define BN_PROFILER_ENGINE_GENERAL_STOP() \
-        do \
-        { \
-        } while(false)
-
-    #define BN_PROFILER_ENGINE_DETAILED_START(id) \
-        do \
-        { \
-        } while(false)
-
-    #define BN_PROFILER_ENGINE_DETAILED_STOP() \
-        do \
-        { \
-        } while(false)
-#endif
-
 namespace bn::core
 {
 
@@ -141,6 +88,11 @@ namespace
         bool slow_game_pak = false;
         volatile bool waiting_for_vblank = false;
         volatile bool vblank_intr_active = false;
+        #if BN_CFG_CORE_PIPELINED_COMMIT
+            volatile int commit_ticks = 0;
+            bool commit_use_dma = false;
+            volatile bool commit_pending = false;
+        #endif
     };
 
     alignas(static_data) BN_DATA_EWRAM_BSS char data_buffer[sizeof(static_data)];
@@ -191,12 +143,8 @@ namespace
         disable(disable_vblank_irq);
     }
 
-    [[nodiscard]] ticks update_impl()
+    void _update_managers()
     {
-        ticks result;
-
-        BN_PROFILER_ENGINE_GENERAL_START("eng_update");
-
         BN_PROFILER_ENGINE_DETAILED_START("eng_cameras_update");
         cameras_manager::update();
         BN_PROFILER_ENGINE_DETAILED_STOP();
@@ -228,101 +176,245 @@ namespace
         BN_PROFILER_ENGINE_DETAILED_START("eng_hblank_fx_update");
         hblank_effects_manager::update();
         BN_PROFILER_ENGINE_DETAILED_STOP();
+    }
 
-        static_data& data = data_ref();
-        bool use_dma = data.dma_enabled && ! link_manager::active();
+    #if BN_CFG_CORE_PIPELINED_COMMIT
+        bool _commit_staged(bool use_dma)
+        {
+            hblank_effects_manager::disable();
+            hw::pipelined_commit::commit(use_dma);
 
-        BN_PROFILER_ENGINE_GENERAL_STOP();
+            bool hdma_running = hdma_manager::commit_entries(use_dma);
+            bool hblank_effects_running = hblank_effects_manager::commit();
+            return use_dma && ! hdma_running && ! hblank_effects_running;
+        }
 
-        BN_BARRIER;
-        result.cpu_usage_ticks = data.cpu_usage_timer.elapsed_ticks();
+        [[nodiscard]] ticks update_impl()
+        {
+            ticks result;
+            static_data& data = data_ref();
 
-        hw::core::wait_for_vblank(data.waiting_for_vblank);
+            // Wait until the previous frame has been committed:
+            BN_BARRIER;
+            result.cpu_usage_ticks = data.cpu_usage_timer.elapsed_ticks();
 
-        BN_BARRIER;
-        data.cpu_usage_timer.restart();
+            hw::core::wait_for_vblank_reset(data.commit_pending);
 
-        BN_PROFILER_ENGINE_GENERAL_START("eng_commit");
+            BN_BARRIER;
+            data.cpu_usage_timer.restart();
 
-        BN_BARRIER;
-        result.missed_frames = data.missed_frames;
-        data.missed_frames = 0;
+            BN_BARRIER;
+            result.vblank_usage_ticks = data.commit_ticks;
+            result.missed_frames = data.missed_frames;
+            data.missed_frames = 0;
 
-        BN_PROFILER_ENGINE_DETAILED_START("eng_hblank_fx_commit");
-        hblank_effects_manager::disable();
-        BN_PROFILER_ENGINE_DETAILED_STOP();
+            BN_PROFILER_ENGINE_DETAILED_START("eng_audio_commands");
+            audio_manager::execute_commands();
+            BN_PROFILER_ENGINE_DETAILED_STOP();
 
-        BN_PROFILER_ENGINE_DETAILED_START("eng_audio_commands");
-        audio_manager::execute_commands();
-        BN_PROFILER_ENGINE_DETAILED_STOP();
+            BN_PROFILER_ENGINE_DETAILED_START("eng_audio_commit");
+            audio_manager::delayed_commit();
+            BN_PROFILER_ENGINE_DETAILED_STOP();
 
-        BN_PROFILER_ENGINE_DETAILED_START("eng_display_commit");
-        display_manager::commit();
-        BN_PROFILER_ENGINE_DETAILED_STOP();
+            BN_PROFILER_ENGINE_DETAILED_START("eng_vblank_callback");
+            if(vblank_callback_type vblank_callback = data.vblank_callback)
+            {
+                vblank_callback();
+            }
+            BN_PROFILER_ENGINE_DETAILED_STOP();
 
-        BN_PROFILER_ENGINE_DETAILED_START("eng_sprites_commit");
-        sprites_manager::commit(use_dma);
-        BN_PROFILER_ENGINE_DETAILED_STOP();
+            BN_PROFILER_ENGINE_GENERAL_START("eng_update");
+            _update_managers();
+            BN_PROFILER_ENGINE_GENERAL_STOP();
 
-        BN_PROFILER_ENGINE_DETAILED_START("eng_bgs_commit");
-        bgs_manager::commit(use_dma);
-        BN_PROFILER_ENGINE_DETAILED_STOP();
+            BN_PROFILER_ENGINE_GENERAL_START("eng_commit");
 
-        BN_PROFILER_ENGINE_DETAILED_START("eng_palettes_commit");
-        palettes_manager::commit(use_dma);
-        BN_PROFILER_ENGINE_DETAILED_STOP();
+            // Stage commit data (sprites, palettes and registers are copied to shadow buffers):
+            bool use_dma = data.dma_enabled && ! link_manager::active();
+            bool must_commit_vram = display_manager::must_commit_bitmap_page() ||
+                    sprite_tiles_manager::must_commit() || bg_blocks_manager::must_commit() ||
+                    bgs_manager::must_commit_big_maps();
 
-        BN_PROFILER_ENGINE_DETAILED_START("eng_spr_tiles_unc_commit");
-        sprite_tiles_manager::commit_uncompressed(use_dma);
-        BN_PROFILER_ENGINE_DETAILED_STOP();
+            BN_PROFILER_ENGINE_DETAILED_START("eng_display_commit");
+            display_manager::commit();
+            BN_PROFILER_ENGINE_DETAILED_STOP();
 
-        BN_PROFILER_ENGINE_DETAILED_START("eng_hdma_update");
-        hdma_manager::update();
-        BN_PROFILER_ENGINE_DETAILED_STOP();
+            BN_PROFILER_ENGINE_DETAILED_START("eng_sprites_commit");
+            sprites_manager::commit(use_dma);
+            BN_PROFILER_ENGINE_DETAILED_STOP();
 
-        hdma_manager::commit_interrupt_handler();
+            BN_PROFILER_ENGINE_DETAILED_START("eng_bgs_commit");
+            bgs_manager::commit(use_dma);
+            BN_PROFILER_ENGINE_DETAILED_STOP();
 
-        bool hdma_running = hdma_manager::commit_entries(use_dma);
+            BN_PROFILER_ENGINE_DETAILED_START("eng_palettes_commit");
+            palettes_manager::commit(use_dma);
+            BN_PROFILER_ENGINE_DETAILED_STOP();
 
-        BN_PROFILER_ENGINE_DETAILED_START("eng_hblank_fx_commit");
-        bool hblank_effects_running = hblank_effects_manager::commit();
-        BN_PROFILER_ENGINE_DETAILED_STOP();
+            BN_PROFILER_ENGINE_DETAILED_START("eng_hdma_update");
+            hdma_manager::update();
+            BN_PROFILER_ENGINE_DETAILED_STOP();
 
-        BN_PROFILER_ENGINE_DETAILED_START("eng_big_maps_commit");
-        bgs_manager::commit_big_maps();
-        BN_PROFILER_ENGINE_DETAILED_STOP();
+            hdma_manager::commit_interrupt_handler();
 
-        use_dma = use_dma && ! hdma_running && ! hblank_effects_running;
+            if(must_commit_vram)
+            {
+                // VRAM uploads and bitmap page flips can modify VRAM used by the displayed frame,
+                // so they are not pipelined:
+                BN_BARRIER;
+                result.cpu_usage_ticks += data.cpu_usage_timer.elapsed_ticks();
 
-        BN_PROFILER_ENGINE_DETAILED_START("eng_bg_blocks_unc_commit");
-        bg_blocks_manager::commit_uncompressed(use_dma);
-        BN_PROFILER_ENGINE_DETAILED_STOP();
+                hw::core::wait_for_vblank(data.waiting_for_vblank);
 
-        BN_PROFILER_ENGINE_DETAILED_START("eng_spr_tiles_cmp_commit");
-        sprite_tiles_manager::commit_compressed();
-        BN_PROFILER_ENGINE_DETAILED_STOP();
+                BN_BARRIER;
+                data.cpu_usage_timer.restart();
 
-        BN_PROFILER_ENGINE_DETAILED_START("eng_bg_blocks_cmp_commit");
-        bg_blocks_manager::commit_compressed();
-        BN_PROFILER_ENGINE_DETAILED_STOP();
+                BN_PROFILER_ENGINE_DETAILED_START("eng_hblank_fx_commit");
+                use_dma = _commit_staged(use_dma);
+                BN_PROFILER_ENGINE_DETAILED_STOP();
+
+                BN_PROFILER_ENGINE_DETAILED_START("eng_spr_tiles_unc_commit");
+                sprite_tiles_manager::commit_uncompressed(use_dma);
+                BN_PROFILER_ENGINE_DETAILED_STOP();
 
-        BN_PROFILER_ENGINE_DETAILED_START("eng_vblank_callback");
-        if(vblank_callback_type vblank_callback = data.vblank_callback)
+                BN_PROFILER_ENGINE_DETAILED_START("eng_big_maps_commit");
+                bgs_manager::commit_big_maps();
+                BN_PROFILER_ENGINE_DETAILED_STOP();
+
+                BN_PROFILER_ENGINE_DETAILED_START("eng_bg_blocks_unc_commit");
+                bg_blocks_manager::commit_uncompressed(use_dma);
+                BN_PROFILER_ENGINE_DETAILED_STOP();
+
+                BN_PROFILER_ENGINE_DETAILED_START("eng_spr_tiles_cmp_commit");
+                sprite_tiles_manager::commit_compressed();
+                BN_PROFILER_ENGINE_DETAILED_STOP();
+
+                BN_PROFILER_ENGINE_DETAILED_START("eng_bg_blocks_cmp_commit");
+                bg_blocks_manager::commit_compressed();
+                BN_PROFILER_ENGINE_DETAILED_STOP();
+
+                result.vblank_usage_ticks = data.cpu_usage_timer.elapsed_ticks();
+            }
+            else
+            {
+                // Commit in the next V-Blank interrupt:
+                data.commit_use_dma = use_dma;
+                BN_BARRIER;
+                data.commit_pending = true;
+            }
+
+            BN_PROFILER_ENGINE_GENERAL_STOP();
+
+            return result;
+        }
+
+        void _wait_for_commit()
         {
-            vblank_callback();
+            hw::core::wait_for_vblank_reset(data_ref().commit_pending);
         }
-        BN_PROFILER_ENGINE_DETAILED_STOP();
+    #else
+        [[nodiscard]] ticks update_impl()
+        {
+            ticks result;
 
-        result.vblank_usage_ticks = data.cpu_usage_timer.elapsed_ticks();
+            BN_PROFILER_ENGINE_GENERAL_START("eng_update");
+            _update_managers();
 
-        BN_PROFILER_ENGINE_DETAILED_START("eng_audio_commit");
-        audio_manager::delayed_commit();
-        BN_PROFILER_ENGINE_DETAILED_STOP();
+            static_data& data = data_ref();
+            bool use_dma = data.dma_enabled && ! link_manager::active();
 
-        BN_PROFILER_ENGINE_GENERAL_STOP();
+            BN_PROFILER_ENGINE_GENERAL_STOP();
 
-        return result;
-    }
+            BN_BARRIER;
+            result.cpu_usage_ticks = data.cpu_usage_timer.elapsed_ticks();
+
+            hw::core::wait_for_vblank(data.waiting_for_vblank);
+
+            BN_BARRIER;
+            data.cpu_usage_timer.restart();
+
+            BN_PROFILER_ENGINE_GENERAL_START("eng_commit");
+
+            BN_BARRIER;
+            result.missed_frames = data.missed_frames;
+            data.missed_frames = 0;
+
+            BN_PROFILER_ENGINE_DETAILED_START("eng_hblank_fx_commit");
+            hblank_effects_manager::disable();
+            BN_PROFILER_ENGINE_DETAILED_STOP();
+
+            BN_PROFILER_ENGINE_DETAILED_START("eng_audio_commands");
+            audio_manager::execute_commands();
+            BN_PROFILER_ENGINE_DETAILED_STOP();
+
+            BN_PROFILER_ENGINE_DETAILED_START("eng_display_commit");
+            display_manager::commit();
+            BN_PROFILER_ENGINE_DETAILED_STOP();
+
+            BN_PROFILER_ENGINE_DETAILED_START("eng_sprites_commit");
+            sprites_manager::commit(use_dma);
+            BN_PROFILER_ENGINE_DETAILED_STOP();
+
+            BN_PROFILER_ENGINE_DETAILED_START("eng_bgs_commit");
+            bgs_manager::commit(use_dma);
+            BN_PROFILER_ENGINE_DETAILED_STOP();
+
+            BN_PROFILER_ENGINE_DETAILED_START("eng_palettes_commit");
+            palettes_manager::commit(use_dma);
+            BN_PROFILER_ENGINE_DETAILED_STOP();
+
+            BN_PROFILER_ENGINE_DETAILED_START("eng_spr_tiles_unc_commit");
+            sprite_tiles_manager::commit_uncompressed(use_dma);
+            BN_PROFILER_ENGINE_DETAILED_STOP();
+
+            BN_PROFILER_ENGINE_DETAILED_START("eng_hdma_update");
+            hdma_manager::update();
+            BN_PROFILER_ENGINE_DETAILED_STOP();
+
+            hdma_manager::commit_interrupt_handler();
+
+            bool hdma_running = hdma_manager::commit_entries(use_dma);
+
+            BN_PROFILER_ENGINE_DETAILED_START("eng_hblank_fx_commit");
+            bool hblank_effects_running = hblank_effects_manager::commit();
+            BN_PROFILER_ENGINE_DETAILED_STOP();
+
+            BN_PROFILER_ENGINE_DETAILED_START("eng_big_maps_commit");
+            bgs_manager::commit_big_maps();
+            BN_PROFILER_ENGINE_DETAILED_STOP();
+
+            use_dma = use_dma && ! hdma_running && ! hblank_effects_running;
+
+            BN_PROFILER_ENGINE_DETAILED_START("eng_bg_blocks_unc_commit");
+            bg_blocks_manager::commit_uncompressed(use_dma);
+            BN_PROFILER_ENGINE_DETAILED_STOP();
+
+            BN_PROFILER_ENGINE_DETAILED_START("eng_spr_tiles_cmp_commit");
+            sprite_tiles_manager::commit_compressed();
+            BN_PROFILER_ENGINE_DETAILED_STOP();
+
+            BN_PROFILER_ENGINE_DETAILED_START("eng_bg_blocks_cmp_commit");
+            bg_blocks_manager::commit_compressed();
+            BN_PROFILER_ENGINE_DETAILED_STOP();
+
+            BN_PROFILER_ENGINE_DETAILED_START("eng_vblank_callback");
+            if(vblank_callback_type vblank_callback = data.vblank_callback)
+            {
+                vblank_callback();
+            }
+            BN_PROFILER_ENGINE_DETAILED_STOP();
+
+            result.vblank_usage_ticks = data.cpu_usage_timer.elapsed_ticks();
+
+            BN_PROFILER_ENGINE_DETAILED_START("eng_audio_commit");
+            audio_manager::delayed_commit();
+            BN_PROFILER_ENGINE_DETAILED_STOP();
+
+            BN_PROFILER_ENGINE_GENERAL_STOP();
+
+            return result;
+        }
+    #endif
 
     void _vblank_intr()
     {
@@ -341,6 +433,18 @@ namespace
 
             data.waiting_for_vblank = false;
         }
+        #if BN_CFG_CORE_PIPELINED_COMMIT
+            else if(data.commit_pending)
+            {
+                timer commit_timer;
+                audio_manager::update();
+                audio_manager::vblank_commit();
+
+                _commit_staged(data.commit_use_dma);
+                data.commit_ticks = commit_timer.elapsed_ticks();
+                data.commit_pending = false;
+            }
+        #endif
         else
         {
             hdma_manager::commit_entries(false);
@@ -483,6 +587,18 @@ void update()
     BN_PROFILER_ENGINE_DETAILED_START("eng_keypad");
     keypad_manager::update();
     BN_PROFILER_ENGINE_DETAILED_STOP();
+
+    #if BN_CFG_PROFILER_ENABLED && BN_CFG_PROFILER_TRACE_ENABLED
+        _bn::profiler::flush_trace();
+    #endif
+
+    #if BN_CFG_TELEMETRY_ENABLED
+        const ticks& last_ticks = data.last_ticks;
+        _bn::telemetry::add_sample(last_ticks.cpu_usage_ticks, last_ticks.vblank_usage_ticks,
+                                   last_ticks.missed_frames);
+    #endif
+
+    memory_manager::reset_frame();
 }
 
 void sleep(keypad::key_type wake_up_key)
@@ -653,6 +769,11 @@ core_lock::core_lock()
     // Update core before disabling irqs:
     core::update();
 
+    #if BN_CFG_CORE_PIPELINED_COMMIT
+        // Wait until the last update has been committed:
+        core::_wait_for_commit();
+    #endif
+
     // Sleep gpio:
     gpio_manager::sleep();
 
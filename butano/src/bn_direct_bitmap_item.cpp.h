@@ -44,6 +44,18 @@ direct_bitmap_item direct_bitmap_item::decompress(span<bn::color> decompressed_c
         result._compression = compression_type::NONE;
         break;
 
+    case compression_type::LZ4:
+        hw::decompress::lz4(_colors_ptr, dest_colors_ptr);
+        result._colors_ptr = dest_colors_ptr;
+        result._compression = compression_type::NONE;
+        break;
+
+    case compression_type::RANS:
+        hw::decompress::rans(_colors_ptr, dest_colors_ptr);
+        result._colors_ptr = dest_colors_ptr;
+        result._compression = compression_type::NONE;
+        break;
+
     default:
         BN_ERROR("Unknown compression type: ", int(_compression));
         break;
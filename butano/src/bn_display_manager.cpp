@@ -52,6 +52,7 @@ namespace
         bool commit = true;
         bool commit_display = true;
         bool bitmap_page_flipped = false;
+        bool commit_bitmap_page = false;
         bool sprites_visible = true;
         bool green_swap_enabled = false;
         bool update_mosaic = true;
@@ -157,6 +158,7 @@ void flip_bitmap_page_later()
 {
     static_data& data = data_ref();
     data.bitmap_page_flipped = ! data.bitmap_page_flipped;
+    data.commit_bitmap_page = true;
     data.commit_display = true;
     data.commit = true;
 }
@@ -172,6 +174,11 @@ void flip_bitmap_page_now()
     }
 }
 
+bool must_commit_bitmap_page()
+{
+    return data_ref().commit_bitmap_page;
+}
+
 void on_bitmap_painter_created(void** painter_page_ptr)
 {
     static_data& data = data_ref();
@@ -1124,6 +1131,7 @@ void commit()
         {
             hw::display::commit_display(data.display_cnt);
             data.commit_display = false;
+            data.commit_bitmap_page = false;
 
             if(void** bitmap_painter_page_ptr = data.bitmap_painter_page_ptr)
             {
@@ -31,6 +31,8 @@ namespace bn::display_manager
 
     void flip_bitmap_page_now();
 
+    [[nodiscard]] bool must_commit_bitmap_page();
+
     void on_bitmap_painter_created(void** painter_page_ptr);
 
     void on_bitmap_painter_destroyed();
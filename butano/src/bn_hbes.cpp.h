@@ -20,4 +20,9 @@ int available_count()
     return hblank_effects_manager::available_count();
 }
 
+int estimated_hblank_cycles()
+{
+    return hblank_effects_manager::estimated_hblank_cycles();
+}
+
 }
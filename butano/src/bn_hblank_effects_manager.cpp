@@ -5,7 +5,9 @@
 
 #include "bn_hblank_effects_manager.h"
 
+#include "bn_bit.h"
 #include "bn_vector.h"
+#include "bn_hdma_manager.h"
 #include "../hw/include/bn_hw_hblank_effects.h"
 
 #include "bn_bg_palette_color_hbe_handler.h"
@@ -108,11 +110,21 @@ namespace
 {
     constexpr int max_items = BN_CFG_HBES_MAX_ITEMS;
 
-    static_assert(max_items > 0 && max_items <= 8);
+    static_assert(max_items > 0 && max_items <= 16);
 
     constexpr int max_uint32_output_values = hw::hblank_effects::max_uint32_entries();
     constexpr int max_uint16_output_values = max(max_items - max_uint32_output_values, 1);
 
+    constexpr int max_hdma_items = BN_CFG_HBES_MAX_HDMA_ITEMS;
+
+    static_assert(max_hdma_items >= 0 && max_hdma_items <= 2);
+
+    // HDMA reads one line past the last one:
+    constexpr int output_values_lines = max_hdma_items ? display::height() + 1 : display::height();
+
+    constexpr int low_priority_hdma_channel = 1;
+    constexpr int high_priority_hdma_channel = 2;
+
     using hw_entries = hw::hblank_effects::entries;
 
     [[nodiscard]] bool _is_uint32(handler_type handler)
@@ -256,8 +268,8 @@ namespace
     {
 
     public:
-        alignas(int) uint16_t a[display::height()];
-        alignas(int) uint16_t b[display::height()];
+        alignas(int) uint16_t a[output_values_lines];
+        alignas(int) uint16_t b[output_values_lines];
         bool a_active = false;
     };
 
@@ -265,8 +277,8 @@ namespace
     {
 
     public:
-        alignas(int) uint16_t a[display::height() * 2];
-        alignas(int) uint16_t b[display::height() * 2];
+        alignas(int) uint16_t a[output_values_lines * 2];
+        alignas(int) uint16_t b[output_values_lines * 2];
         bool a_active = false;
     };
 
@@ -637,6 +649,32 @@ namespace
             }
         }
 
+        void setup_hdma(int hdma_channel) const
+        {
+            const uint16_t* src;
+            int elements;
+
+            if(uint16_output_values)
+            {
+                src = uint16_output_values->a_active ? uint16_output_values->a : uint16_output_values->b;
+                elements = 1;
+            }
+            else
+            {
+                src = uint32_output_values->a_active ? uint32_output_values->a : uint32_output_values->b;
+                elements = _is_uint32(handler) ? 2 : 1;
+            }
+
+            if(hdma_channel == low_priority_hdma_channel)
+            {
+                hdma_manager::low_priority_hbe_start(*src, elements, *output_register);
+            }
+            else
+            {
+                hdma_manager::high_priority_hbe_start(*src, elements, *output_register);
+            }
+        }
+
         void show()
         {
             switch(handler)
@@ -1075,6 +1113,8 @@ namespace
         vector<int8_t, max_uint32_output_values> free_uint32_output_values_indexes;
         int8_t first_visible_item_index = max_items - 1;
         int8_t last_visible_item_index = 0;
+        int16_t estimated_cycles = 0;
+        int8_t hdma_channels = 0;
         bool visible_entries = false;
         bool entries_a_active = false;
         bool update = false;
@@ -1101,6 +1141,207 @@ namespace
     static_internal_data internal_data;
 
 
+    // Adjacent 16-bit entries are merged into 32-bit entries only if they can exceed the H-Blank length:
+    constexpr int max_merged_entries =
+            hw::hblank_effects::cycles(max_items - max_uint32_output_values, max_uint32_output_values, false) >
+            hw::hblank_effects::max_cycles() ? max_uint32_output_values : 0;
+
+    template<int MaxMergedEntries>
+    class merged_entries_type
+    {
+
+    public:
+        void merge(hw_entries& entries, bool entries_a)
+        {
+            uint32_t (&values)[MaxMergedEntries][output_values_lines] = entries_a ? _values_a : _values_b;
+            int merged_entries_count = 0;
+            int index = 0;
+
+            while(index < entries.uint16_entries_count && entries.uint32_entries_count < max_uint32_output_values)
+            {
+                int adjacent_index = _adjacent_index(entries, index);
+
+                if(adjacent_index >= 0)
+                {
+                    const hw::hblank_effects::uint16_entry& low_entry = entries.uint16_entries[index];
+                    const hw::hblank_effects::uint16_entry& high_entry = entries.uint16_entries[adjacent_index];
+                    uint32_t* merged_values = values[merged_entries_count];
+                    ++merged_entries_count;
+
+                    for(int line = 0; line < output_values_lines; ++line)
+                    {
+                        merged_values[line] = low_entry.src[line] | (uint32_t(high_entry.src[line]) << 16);
+                    }
+
+                    hw::hblank_effects::uint32_entry& uint32_entry =
+                            entries.uint32_entries[entries.uint32_entries_count];
+                    uint32_entry.src = merged_values;
+                    uint32_entry.dest = reinterpret_cast<volatile uint32_t*>(low_entry.dest);
+                    ++entries.uint32_entries_count;
+
+                    _remove_entry(entries, max(index, adjacent_index));
+                    _remove_entry(entries, min(index, adjacent_index));
+                }
+                else
+                {
+                    ++index;
+                }
+            }
+        }
+
+    private:
+        // Merged tables are sized like the output values tables, so they have the extra line read by HDMA too:
+        alignas(int) uint32_t _values_a[MaxMergedEntries][output_values_lines];
+        alignas(int) uint32_t _values_b[MaxMergedEntries][output_values_lines];
+
+        [[nodiscard]] static int _adjacent_index(const hw_entries& entries, int index)
+        {
+            volatile uint16_t* dest = entries.uint16_entries[index].dest;
+
+            if(uintptr_t(dest) % 4 == 0)
+            {
+                for(int other_index = 0, limit = entries.uint16_entries_count; other_index < limit; ++other_index)
+                {
+                    if(entries.uint16_entries[other_index].dest == dest + 1)
+                    {
+                        return other_index;
+                    }
+                }
+            }
+
+            return -1;
+        }
+
+        static void _remove_entry(hw_entries& entries, int index)
+        {
+            int last_index = entries.uint16_entries_count - 1;
+            entries.uint16_entries[index] = entries.uint16_entries[last_index];
+            entries.uint16_entries_count = last_index;
+        }
+    };
+
+    template<>
+    class merged_entries_type<0>
+    {
+
+    public:
+        void merge(hw_entries&, bool)
+        {
+        }
+    };
+
+    BN_DATA_EWRAM_BSS merged_entries_type<max_merged_entries> merged_entries;
+
+
+    [[nodiscard]] unsigned _line_changes_mask(const hw_entries& entries, int line)
+    {
+        unsigned result = 0;
+
+        for(int index = 0, limit = entries.uint16_entries_count; index < limit; ++index)
+        {
+            const uint16_t* src = entries.uint16_entries[index].src;
+
+            if(src[line] != src[line - 1])
+            {
+                result |= 1U << index;
+            }
+        }
+
+        for(int index = 0, limit = entries.uint32_entries_count; index < limit; ++index)
+        {
+            const uint32_t* src = entries.uint32_entries[index].src;
+
+            if(src[line] != src[line - 1])
+            {
+                result |= 1U << (index + hw::hblank_effects::uint32_entries_mask_shift());
+            }
+        }
+
+        return result;
+    }
+
+    void _update_sparse_lines(hw_entries& entries)
+    {
+        constexpr int max_sparse_lines = hw::hblank_effects::max_sparse_lines();
+
+        if constexpr(max_sparse_lines > 0)
+        {
+            int sparse_lines_count = 0;
+
+            for(int line = 1; line < display::height(); ++line)
+            {
+                if(unsigned mask = _line_changes_mask(entries, line))
+                {
+                    if(sparse_lines_count == max_sparse_lines)
+                    {
+                        // Too many changes, so values are written in every H-Blank:
+                        entries.sparse_lines_count = 0;
+                        return;
+                    }
+
+                    // New values are written in the H-Blank of the previous line:
+                    entries.sparse_lines[sparse_lines_count] = uint8_t(line - 1);
+                    entries.sparse_masks[sparse_lines_count] = mask;
+                    ++sparse_lines_count;
+                }
+            }
+
+            entries.sparse_lines[sparse_lines_count] = uint8_t(hw::hblank_effects::last_vcount());
+            entries.sparse_lines_count = sparse_lines_count + 1;
+        }
+        else
+        {
+            entries.sparse_lines_count = 0;
+        }
+    }
+
+
+    [[nodiscard]] int _estimated_cycles(const hw_entries& entries)
+    {
+        int sparse_lines_count = entries.sparse_lines_count;
+
+        if(! sparse_lines_count)
+        {
+            return hw::hblank_effects::cycles(entries.uint16_entries_count, entries.uint32_entries_count, false);
+        }
+
+        int result = 0;
+        constexpr unsigned uint16_entries_mask = (1U << hw::hblank_effects::uint32_entries_mask_shift()) - 1;
+
+        for(int index = 0, limit = sparse_lines_count - 1; index < limit; ++index)
+        {
+            unsigned mask = entries.sparse_masks[index];
+            int uint16_entries_count = popcount(mask & uint16_entries_mask);
+            int uint32_entries_count = popcount(mask >> hw::hblank_effects::uint32_entries_mask_shift());
+            result = max(result, hw::hblank_effects::cycles(uint16_entries_count, uint32_entries_count, true));
+        }
+
+        return result;
+    }
+
+    [[nodiscard]] int _available_hdma_channels()
+    {
+        int result = 0;
+
+        if constexpr(max_hdma_items > 0)
+        {
+            if(hdma_manager::low_priority_available())
+            {
+                result |= low_priority_hdma_channel;
+            }
+
+            if constexpr(max_hdma_items > 1)
+            {
+                if(hdma_manager::high_priority_available())
+                {
+                    result |= high_priority_hdma_channel;
+                }
+            }
+        }
+
+        return result;
+    }
+
     void _update_visible_item_index(int item_index)
     {
         static_external_data& data = external_data_ref();
@@ -1231,6 +1472,11 @@ int available_count()
     return external_data_ref().free_item_indexes.size();
 }
 
+int estimated_hblank_cycles()
+{
+    return external_data_ref().estimated_cycles;
+}
+
 void enable()
 {
     if(external_data_ref().enabled)
@@ -1254,6 +1500,8 @@ void stop()
     static_external_data& external_data = external_data_ref();
     external_data.first_visible_item_index = max_items - 1;
     external_data.last_visible_item_index = 0;
+    external_data.estimated_cycles = 0;
+    external_data.hdma_channels = 0;
     external_data.update = false;
     external_data.commit = false;
     external_data.enabled = false;
@@ -1347,6 +1595,34 @@ void reload_values_ref(int id)
     }
 }
 
+void reload_bg_attributes()
+{
+    static_external_data& external_data = external_data_ref();
+
+    for(item_type& item : external_data.items)
+    {
+        if(item.usages)
+        {
+            switch(item.handler)
+            {
+
+            case handler_type::REGULAR_BG_ATTRIBUTES:
+            case handler_type::AFFINE_BG_ATTRIBUTES:
+                item.update = true;
+
+                if(item.visible)
+                {
+                    external_data.update = true;
+                }
+                break;
+
+            default:
+                break;
+            }
+        }
+    }
+}
+
 [[nodiscard]] bool visible(int id)
 {
     const item_type& item = external_data_ref().items[id];
@@ -1421,6 +1697,17 @@ void update()
         }
     }
 
+    if constexpr(max_hdma_items > 0)
+    {
+        int hdma_channels = _available_hdma_channels();
+
+        if(external_data.hdma_channels != hdma_channels)
+        {
+            external_data.hdma_channels = int8_t(hdma_channels);
+            update = true;
+        }
+    }
+
     if(update)
     {
         hw_entries* entries;
@@ -1440,17 +1727,57 @@ void update()
         entries->uint16_entries_count = 0;
         entries->uint32_entries_count = 0;
 
+        int hdma_channels = external_data.hdma_channels;
+
         for(int item_index = first_visible_item_index; item_index <= last_visible_item_index; ++item_index)
         {
             const item_type& item = external_data.items[item_index];
 
             if(item.visible && item.on_screen)
             {
-                item.setup_entry(*entries);
-                visible_entries = true;
+                if(hdma_channels)
+                {
+                    // Free HDMA channels are used instead of H-Blank interrupts when possible:
+                    int hdma_channel = hdma_channels & low_priority_hdma_channel ?
+                                low_priority_hdma_channel : high_priority_hdma_channel;
+                    item.setup_hdma(hdma_channel);
+                    hdma_channels &= ~hdma_channel;
+                }
+                else
+                {
+                    item.setup_entry(*entries);
+                    visible_entries = true;
+                }
             }
         }
 
+        if(hdma_channels & low_priority_hdma_channel)
+        {
+            hdma_manager::low_priority_hbe_stop();
+        }
+
+        if(hdma_channels & high_priority_hdma_channel)
+        {
+            hdma_manager::high_priority_hbe_stop();
+        }
+
+        int estimated_cycles = 0;
+
+        if(visible_entries)
+        {
+            // Items committed with HDMA are not in the entries, so merged tables are only read by _intr:
+            if(hw::hblank_effects::cycles(entries->uint16_entries_count, entries->uint32_entries_count, false) >
+                    hw::hblank_effects::max_cycles())
+            {
+                merged_entries.merge(*entries, external_data.entries_a_active);
+            }
+
+            _update_sparse_lines(*entries);
+            estimated_cycles = _estimated_cycles(*entries);
+        }
+
+        external_data.estimated_cycles = int16_t(estimated_cycles);
+
         external_data.visible_entries = visible_entries;
         external_data.commit = true;
     }
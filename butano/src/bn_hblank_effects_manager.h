@@ -62,6 +62,8 @@ namespace bn::hblank_effects_manager
 
     [[nodiscard]] int available_count();
 
+    [[nodiscard]] int estimated_hblank_cycles();
+
     void enable();
 
     void disable();
@@ -83,6 +85,8 @@ namespace bn::hblank_effects_manager
 
     void reload_values_ref(int id);
 
+    void reload_bg_attributes();
+
     [[nodiscard]] bool visible(int id);
 
     void set_visible(int id, bool visible);
@@ -24,8 +24,10 @@ namespace
 
     public:
         const uint16_t* source_ptr = nullptr;
+        const uint16_t* initial_copy_source_ptr = nullptr;
         uint16_t* destination_ptr = nullptr;
         int elements = 0;
+        bool hbe = false;
     };
 
     class entry
@@ -39,7 +41,14 @@ namespace
 
         [[nodiscard]] bool running() const
         {
-            return _next_state().elements;
+            const state& next_state = _next_state();
+            return next_state.elements && ! next_state.hbe;
+        }
+
+        [[nodiscard]] bool hbe_running() const
+        {
+            const state& current_state = _states[_current_state_index];
+            return current_state.elements && current_state.hbe;
         }
 
         void disable()
@@ -51,18 +60,56 @@ namespace
         {
             state& next_state = _next_state();
             next_state.source_ptr = &source_ref;
+            next_state.initial_copy_source_ptr = &source_ref + ((display::height() - 1) * elements);
             next_state.destination_ptr = &destination_ref;
             next_state.elements = elements;
+            next_state.hbe = false;
             _updated = true;
         }
 
         void stop()
         {
             state& next_state = _next_state();
-            next_state.elements = 0;
+
+            if(! next_state.hbe)
+            {
+                next_state.elements = 0;
+                _updated = true;
+            }
+        }
+
+        void hbe_start(const uint16_t& source_ref, int elements, uint16_t& destination_ref)
+        {
+            state& next_state = _next_state();
+            BN_BASIC_ASSERT(next_state.hbe || ! next_state.elements, "HDMA channel used by bn::hdma");
+
+            if(next_state.hbe && next_state.source_ptr == &source_ref + elements &&
+                    next_state.destination_ptr == &destination_ref && next_state.elements == elements)
+            {
+                return;
+            }
+
+            // H-Blank effects values of a line are written in the H-Blank of the previous line:
+            next_state.source_ptr = &source_ref + elements;
+            next_state.initial_copy_source_ptr = &source_ref;
+            next_state.destination_ptr = &destination_ref;
+            next_state.elements = elements;
+            next_state.hbe = true;
             _updated = true;
         }
 
+        void hbe_stop()
+        {
+            state& next_state = _next_state();
+
+            if(next_state.hbe)
+            {
+                next_state.elements = 0;
+                next_state.hbe = false;
+                _updated = true;
+            }
+        }
+
         void force_stop()
         {
             _states[0].elements = 0;
@@ -96,7 +143,7 @@ namespace
             if(int elements = current_state.elements)
             {
                 const uint16_t* source_ptr = current_state.source_ptr;
-                const uint16_t* initial_copy_source_ptr = source_ptr + ((display::height() - 1) * elements);
+                const uint16_t* initial_copy_source_ptr = current_state.initial_copy_source_ptr;
                 uint16_t* destination_ptr = current_state.destination_ptr;
 
                 if(use_dma)
@@ -108,7 +155,7 @@ namespace
                     hw::memory::copy_half_words(initial_copy_source_ptr, elements, destination_ptr);
                 }
 
-                if(raise_irq)
+                if(raise_irq && ! current_state.hbe)
                 {
                     hw::dma::start_hdma_irq(_channel, source_ptr, elements, destination_ptr);
                 }
@@ -218,6 +265,21 @@ void low_priority_stop()
     data_ref().low_priority_entry.stop();
 }
 
+bool low_priority_available()
+{
+    return hw::audio::dma_channel_free(hw::dma::low_priority_channel()) && ! low_priority_running();
+}
+
+void low_priority_hbe_start(const uint16_t& source_ref, int elements, uint16_t& destination_ref)
+{
+    data_ref().low_priority_entry.hbe_start(source_ref, elements, destination_ref);
+}
+
+void low_priority_hbe_stop()
+{
+    data_ref().low_priority_entry.hbe_stop();
+}
+
 bool high_priority_running()
 {
     return data_ref().high_priority_entry.running();
@@ -235,6 +297,21 @@ void high_priority_stop()
     data_ref().high_priority_entry.stop();
 }
 
+bool high_priority_available()
+{
+    return hw::audio::dma_channel_free(hw::dma::high_priority_channel()) && ! high_priority_running();
+}
+
+void high_priority_hbe_start(const uint16_t& source_ref, int elements, uint16_t& destination_ref)
+{
+    data_ref().high_priority_entry.hbe_start(source_ref, elements, destination_ref);
+}
+
+void high_priority_hbe_stop()
+{
+    data_ref().high_priority_entry.hbe_stop();
+}
+
 hdma::interrupt_handler_type high_priority_interrupt_handler()
 {
     return data_ref().new_high_priority_interrupt_handler;
@@ -270,7 +347,7 @@ bool commit_entries(bool use_dma)
     hdma::interrupt_handler_type high_priority_interrupt_handler = data.current_high_priority_interrupt_handler;
     bool running = data.high_priority_entry.commit(use_dma, high_priority_interrupt_handler);
 
-    if(running && high_priority_interrupt_handler)
+    if(running && high_priority_interrupt_handler && ! data.high_priority_entry.hbe_running())
     {
         if(! data.high_priority_irq_enabled)
         {
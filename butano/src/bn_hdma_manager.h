@@ -24,12 +24,24 @@ namespace bn::hdma_manager
 
     void low_priority_stop();
 
+    [[nodiscard]] bool low_priority_available();
+
+    void low_priority_hbe_start(const uint16_t& source_ref, int elements, uint16_t& destination_ref);
+
+    void low_priority_hbe_stop();
+
     [[nodiscard]] bool high_priority_running();
 
     void high_priority_start(const uint16_t& source_ref, int elements, uint16_t& destination_ref);
 
     void high_priority_stop();
 
+    [[nodiscard]] bool high_priority_available();
+
+    void high_priority_hbe_start(const uint16_t& source_ref, int elements, uint16_t& destination_ref);
+
+    void high_priority_hbe_stop();
+
     [[nodiscard]] hdma::interrupt_handler_type high_priority_interrupt_handler();
 
     void set_high_priority_interrupt_handler(hdma::interrupt_handler_type interrupt_handler);
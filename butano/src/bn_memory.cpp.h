@@ -125,6 +125,20 @@ void unsafe_set_words(unsigned value, int words, void* destination)
     bn::hw::memory::set_words(value, words, destination);
 }
 
+void* frame_container_alloc(int bytes, bool iwram)
+{
+    void* result = iwram ? bn::memory_manager::frame_iwram_alloc(bytes) : bn::memory_manager::frame_ewram_alloc(bytes);
+    BN_BASIC_ASSERT(result, "Frame allocation failed. Size in bytes: ", bytes);
+
+    bn::memory_manager::increase_frame_containers();
+    return result;
+}
+
+void frame_container_free()
+{
+    bn::memory_manager::decrease_frame_containers();
+}
+
 }
 
 
@@ -168,6 +182,46 @@ void log_alloc_ewram_status()
     #endif
 }
 
+void* frame_iwram_alloc(int bytes)
+{
+    return memory_manager::frame_iwram_alloc(bytes);
+}
+
+void* frame_ewram_alloc(int bytes)
+{
+    return memory_manager::frame_ewram_alloc(bytes);
+}
+
+int used_frame_iwram()
+{
+    return memory_manager::used_frame_iwram();
+}
+
+int available_frame_iwram()
+{
+    return memory_manager::available_frame_iwram();
+}
+
+int max_used_frame_iwram()
+{
+    return memory_manager::max_used_frame_iwram();
+}
+
+int used_frame_ewram()
+{
+    return memory_manager::used_frame_ewram();
+}
+
+int available_frame_ewram()
+{
+    return memory_manager::available_frame_ewram();
+}
+
+int max_used_frame_ewram()
+{
+    return memory_manager::max_used_frame_ewram();
+}
+
 int used_stack_iwram()
 {
     return hw::memory::used_stack_iwram(hw::memory::stack_address());
@@ -259,6 +313,14 @@ void decompress(compression_type compression, const void* source_ptr, int bytes,
         hw::decompress::huff(source_ptr, destination_ptr);
         break;
 
+    case compression_type::LZ4:
+        hw::decompress::lz4(source_ptr, destination_ptr);
+        break;
+
+    case compression_type::RANS:
+        hw::decompress::rans(source_ptr, destination_ptr);
+        break;
+
     default:
         BN_ERROR("Unknown compression type: ", int(compression));
         break;
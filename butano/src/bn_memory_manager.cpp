@@ -5,6 +5,8 @@
 
 #include "bn_memory_manager.h"
 
+#include "bn_algorithm.h"
+#include "bn_config_memory.h"
 #include "bn_best_fit_allocator.h"
 #include "../hw/include/bn_hw_memory.h"
 
@@ -17,11 +19,88 @@ namespace bn::memory_manager
 
 namespace
 {
+    static_assert(BN_CFG_MEMORY_FRAME_IWRAM_BYTES >= 0 && BN_CFG_MEMORY_FRAME_IWRAM_BYTES % 8 == 0);
+    static_assert(BN_CFG_MEMORY_FRAME_EWRAM_BYTES >= 0 && BN_CFG_MEMORY_FRAME_EWRAM_BYTES % 8 == 0);
+
+    #if BN_CFG_MEMORY_FRAME_IWRAM_BYTES
+        alignas(uint64_t) uint8_t frame_iwram_buffer[BN_CFG_MEMORY_FRAME_IWRAM_BYTES];
+    #else
+        constexpr uint8_t* frame_iwram_buffer = nullptr;
+    #endif
+
+    #if BN_CFG_MEMORY_FRAME_EWRAM_BYTES
+        alignas(uint64_t) BN_DATA_EWRAM_BSS uint8_t frame_ewram_buffer[BN_CFG_MEMORY_FRAME_EWRAM_BYTES];
+    #else
+        constexpr uint8_t* frame_ewram_buffer = nullptr;
+    #endif
+
+
+    class frame_arena
+    {
+
+    public:
+        frame_arena(uint8_t* data, int size) :
+            _data(data),
+            _size(size)
+        {
+        }
+
+        [[nodiscard]] int used_bytes() const
+        {
+            return _used_bytes;
+        }
+
+        [[nodiscard]] int available_bytes() const
+        {
+            return _size - _used_bytes;
+        }
+
+        [[nodiscard]] int max_used_bytes() const
+        {
+            return _max_used_bytes;
+        }
+
+        [[nodiscard]] void* alloc(int bytes)
+        {
+            BN_ASSERT(bytes >= 0, "Invalid bytes: ", bytes);
+
+            bytes = (bytes + 7) & ~7;
+
+            if(bytes > available_bytes())
+            {
+                return nullptr;
+            }
+
+            uint8_t* result = _data + _used_bytes;
+            _used_bytes += bytes;
+            _max_used_bytes = max(_max_used_bytes, _used_bytes);
+            return result;
+        }
+
+        void reset()
+        {
+            _used_bytes = 0;
+        }
+
+    private:
+        uint8_t* _data;
+        int _size;
+        int _used_bytes = 0;
+        int _max_used_bytes = 0;
+    };
+
+
     class static_data
     {
 
     public:
         best_fit_allocator allocator;
+        frame_arena frame_iwram_arena = frame_arena(frame_iwram_buffer, BN_CFG_MEMORY_FRAME_IWRAM_BYTES);
+        frame_arena frame_ewram_arena = frame_arena(frame_ewram_buffer, BN_CFG_MEMORY_FRAME_EWRAM_BYTES);
+
+        #if BN_CFG_ASSERT_ENABLED
+            int frame_containers = 0;
+        #endif
     };
 
     alignas(static_data) BN_DATA_EWRAM_BSS char data_buffer[sizeof(static_data)];
@@ -78,4 +157,70 @@ int available_alloc_ewram()
     }
 #endif
 
+void* frame_iwram_alloc(int bytes)
+{
+    return data_ref().frame_iwram_arena.alloc(bytes);
+}
+
+void* frame_ewram_alloc(int bytes)
+{
+    return data_ref().frame_ewram_arena.alloc(bytes);
+}
+
+int used_frame_iwram()
+{
+    return data_ref().frame_iwram_arena.used_bytes();
+}
+
+int available_frame_iwram()
+{
+    return data_ref().frame_iwram_arena.available_bytes();
+}
+
+int max_used_frame_iwram()
+{
+    return data_ref().frame_iwram_arena.max_used_bytes();
+}
+
+int used_frame_ewram()
+{
+    return data_ref().frame_ewram_arena.used_bytes();
+}
+
+int available_frame_ewram()
+{
+    return data_ref().frame_ewram_arena.available_bytes();
+}
+
+int max_used_frame_ewram()
+{
+    return data_ref().frame_ewram_arena.max_used_bytes();
+}
+
+void increase_frame_containers()
+{
+    #if BN_CFG_ASSERT_ENABLED
+        ++data_ref().frame_containers;
+    #endif
+}
+
+void decrease_frame_containers()
+{
+    #if BN_CFG_ASSERT_ENABLED
+        --data_ref().frame_containers;
+    #endif
+}
+
+void reset_frame()
+{
+    static_data& data = data_ref();
+
+    #if BN_CFG_ASSERT_ENABLED
+        BN_ASSERT(! data.frame_containers, "Frame containers used after frame arena reset: ", data.frame_containers);
+    #endif
+
+    data.frame_iwram_arena.reset();
+    data.frame_ewram_arena.reset();
+}
+
 }
@@ -27,6 +27,28 @@ namespace bn::memory_manager
     #if BN_CFG_LOG_ENABLED
         void log_alloc_ewram_status();
     #endif
+
+    [[nodiscard]] void* frame_iwram_alloc(int bytes);
+
+    [[nodiscard]] void* frame_ewram_alloc(int bytes);
+
+    [[nodiscard]] int used_frame_iwram();
+
+    [[nodiscard]] int available_frame_iwram();
+
+    [[nodiscard]] int max_used_frame_iwram();
+
+    [[nodiscard]] int used_frame_ewram();
+
+    [[nodiscard]] int available_frame_ewram();
+
+    [[nodiscard]] int max_used_frame_ewram();
+
+    void increase_frame_containers();
+
+    void decrease_frame_containers();
+
+    void reset_frame();
 }
 
 #endif
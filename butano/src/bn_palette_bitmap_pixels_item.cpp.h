@@ -44,6 +44,18 @@ palette_bitmap_pixels_item palette_bitmap_pixels_item::decompress(span<uint8_t>
         result._compression = compression_type::NONE;
         break;
 
+    case compression_type::LZ4:
+        hw::decompress::lz4(_pixels_ptr, dest_pixels_ptr);
+        result._pixels_ptr = dest_pixels_ptr;
+        result._compression = compression_type::NONE;
+        break;
+
+    case compression_type::RANS:
+        hw::decompress::rans(_pixels_ptr, dest_pixels_ptr);
+        result._pixels_ptr = dest_pixels_ptr;
+        result._compression = compression_type::NONE;
+        break;
+
     default:
         BN_ERROR("Unknown compression type: ", int(_compression));
         break;
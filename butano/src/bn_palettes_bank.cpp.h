@@ -247,6 +247,16 @@ int palettes_bank::create_bpp_8(const span<const color>& colors, compression_typ
                 dest_colors_span = span<const color>(dest_colors_array, colors_count);
                 break;
 
+            case compression_type::LZ4:
+                hw::decompress::lz4(colors.data(), dest_colors_array);
+                dest_colors_span = span<const color>(dest_colors_array, colors_count);
+                break;
+
+            case compression_type::RANS:
+                hw::decompress::rans(colors.data(), dest_colors_array);
+                dest_colors_span = span<const color>(dest_colors_array, colors_count);
+                break;
+
             default:
                 BN_ERROR("Unknown compression type: ", int(compression));
                 break;
@@ -287,18 +297,81 @@ void palettes_bank::decrease_usages(int id)
 
     if(! pal.usages) [[unlikely]]
     {
-        for(int slot = pal.slots_count - 1; slot >= 0; --slot)
+        _release(id);
+    }
+}
+
+bool palettes_bank::repack_bpp_4(unsigned movable_ids_mask, int8_t* new_ids)
+{
+    int palettes_count = hw::palettes::count();
+    int first_bpp_4_index = _bpp_8_slots_count();
+    bool result = false;
+
+    for(int index = 0; index < palettes_count; ++index)
+    {
+        new_ids[index] = int8_t(index);
+    }
+
+    // Merge identical palettes (movable palettes are merged into the highest identical one).
+    // Subset palettes are not merged, since which color indexes are used by the sprite tiles is unknown:
+    for(int index = first_bpp_4_index; index < palettes_count; ++index)
+    {
+        palette& pal = _palettes[index];
+
+        if(pal.usages && (movable_ids_mask & (1U << index)))
         {
-            _palettes[id + slot].locked = false;
+            for(int other_index = palettes_count - 1; other_index >= first_bpp_4_index; --other_index)
+            {
+                if(other_index != index && _same_bpp_4_palettes(index, other_index))
+                {
+                    uint16_t hash = pal.hash;
+                    _palettes[other_index].usages += pal.usages;
+                    _release(index);
+
+                    // Keep the merged palette findable, so it is not created again:
+                    _bpp_4_indexes_map.insert_or_assign(hash, int16_t(other_index));
+                    new_ids[index] = int8_t(other_index);
+                    result = true;
+                    break;
+                }
+            }
         }
+    }
 
-        if(! pal.bpp_8)
+    // Move movable palettes to the highest free slots, so free slots are contiguous:
+    int lowest_index = first_bpp_4_index;
+
+    for(int slot = palettes_count - 1; slot > lowest_index; --slot)
+    {
+        const palette& slot_pal = _palettes[slot];
+
+        if(! slot_pal.usages && ! slot_pal.locked)
         {
-            _erase_bpp_4_indexes_map_index(pal.hash);
-        }
+            for(int index = lowest_index; index < slot; ++index)
+            {
+                const palette& pal = _palettes[index];
 
-        pal = palette();
+                if(pal.usages && ! pal.bpp_8 && pal.slots_count == 1 && (movable_ids_mask & (1U << index)))
+                {
+                    _relocate_bpp_4(index, slot);
+
+                    for(int id = 0; id < palettes_count; ++id)
+                    {
+                        if(new_ids[id] == index)
+                        {
+                            new_ids[id] = int8_t(slot);
+                        }
+                    }
+
+                    lowest_index = index + 1;
+                    result = true;
+                    break;
+                }
+            }
+        }
     }
+
+    return result;
 }
 
 bpp_mode palettes_bank::bpp(int id) const
@@ -332,7 +405,7 @@ void palettes_bank::set_colors(int id, const span<const color>& colors)
 
         if(old_hash != new_hash)
         {
-            _erase_bpp_4_indexes_map_index(old_hash);
+            _erase_bpp_4_indexes_map_index(old_hash, id);
             _bpp_4_indexes_map.insert_or_assign(new_hash, int16_t(id));
             pal.hash = new_hash;
         }
@@ -359,15 +432,7 @@ void palettes_bank::set_color(int id, int color_index, color color)
 
         if(! pal.bpp_8 && color_index < hash_colors)
         {
-            uint16_t old_hash = pal.hash;
-            uint16_t new_hash = colors_hash(span<const bn::color>(colors_data, colors_count));
-
-            if(old_hash != new_hash)
-            {
-                _erase_bpp_4_indexes_map_index(old_hash);
-                _bpp_4_indexes_map.insert_or_assign(new_hash, int16_t(id));
-                pal.hash = new_hash;
-            }
+            _update_hash(id);
         }
     }
 }
@@ -496,6 +561,53 @@ void palettes_bank::set_rotate_range(int id, int start, int size)
     }
 }
 
+bool palettes_bank::animation_done(int id) const
+{
+    const palette& pal = _palettes[id];
+
+    if(! pal.animation_frames_ptr)
+    {
+        return true;
+    }
+
+    return ! pal.animation_loop && pal.animation_frame_index == pal.animation_frames_count - 1;
+}
+
+void palettes_bank::set_animation(int id, const palette_animation_item& animation_item)
+{
+    palette& pal = _palettes[id];
+    const span<const palette_animation_item::frame>& frames = animation_item.frames_ref();
+
+    if(! pal.animation_frames_ptr)
+    {
+        ++_animations_count;
+    }
+
+    pal.animation_colors_ptr = animation_item.colors_ref().data();
+    pal.animation_frames_ptr = frames.data();
+    pal.animation_frames_count = int16_t(frames.size());
+    pal.animation_frame_index = 0;
+    pal.animation_loop = animation_item.loop();
+    _apply_animation_frame(id, frames[0]);
+    pal.update = true;
+    _update = true;
+}
+
+void palettes_bank::remove_animation(int id)
+{
+    palette& pal = _palettes[id];
+
+    if(pal.animation_frames_ptr)
+    {
+        pal.animation_colors_ptr = nullptr;
+        pal.animation_frames_ptr = nullptr;
+        pal.animation_frames_count = 0;
+        pal.animation_frame_index = 0;
+        pal.animation_loop = false;
+        --_animations_count;
+    }
+}
+
 void palettes_bank::reload(int id)
 {
     palette& pal = _palettes[id];
@@ -651,11 +763,18 @@ void palettes_bank::reload_custom_effect()
 
 void palettes_bank::update()
 {
-    int first_index = numeric_limits<int>::max();
-    int last_index = 0;
+    int first_color = numeric_limits<int>::max();
+    int last_color = 0;
+
+    if(_animations_count)
+    {
+        _update_animations(first_color, last_color);
+    }
 
     if(_update)
     {
+        int first_index = numeric_limits<int>::max();
+        int last_index = 0;
         bool update_global_effects = _update_global_effects || _global_effects_enabled;
         _update = false;
         _global_effects_updated = _update_global_effects;
@@ -707,24 +826,26 @@ void palettes_bank::update()
                     hw::palettes::colors_per_palette();
             _apply_global_effects(all_colors_count, all_colors_ptr);
         }
+
+        if(first_index != numeric_limits<int>::max())
+        {
+            int colors_per_palette = hw::palettes::colors_per_palette();
+            first_color = min(first_color, first_index * colors_per_palette);
+            last_color = max(last_color, ((last_index + _palettes[last_index].slots_count) * colors_per_palette) - 1);
+        }
     }
 
-    _first_index_to_commit = first_index;
-    _last_index_to_commit = last_index;
+    _first_color_to_commit = first_color;
+    _last_color_to_commit = last_color;
 }
 
 palettes_bank::commit_data palettes_bank::retrieve_commit_data() const
 {
     commit_data result;
 
-    if(_first_index_to_commit != numeric_limits<int>::max())
+    if(int first_color = _first_color_to_commit; first_color != numeric_limits<int>::max())
     {
-        int first_index = _first_index_to_commit;
-        int last_index = _last_index_to_commit;
-        int colors_offset = first_index * hw::palettes::colors_per_palette();
-        int colors_count = (last_index - first_index + _palettes[last_index].slots_count) *
-                hw::palettes::colors_per_palette();
-        result = { _final_colors, colors_offset, colors_count };
+        result = { _final_colors, first_color, _last_color_to_commit - first_color + 1 };
     }
     else
     {
@@ -738,8 +859,8 @@ palettes_bank::commit_data palettes_bank::retrieve_commit_data() const
 
 void palettes_bank::reset_commit_data()
 {
-    _first_index_to_commit = numeric_limits<int>::max();
-    _last_index_to_commit = 0;
+    _first_color_to_commit = numeric_limits<int>::max();
+    _last_color_to_commit = 0;
     _global_effects_updated = false;
 }
 
@@ -786,6 +907,32 @@ void palettes_bank::fill_hblank_effect_colors(const color* source_colors_ptr, ui
     return bn_hw_palettes_different_words(four_words_count, u32_colors, u32_stored_colors) == 0;
 }
 
+bool palettes_bank::_same_bpp_4_palettes(int id, int other_id) const
+{
+    const palette& pal = _palettes[id];
+    const palette& other_pal = _palettes[other_id];
+
+    if(! pal.usages || ! other_pal.usages || pal.bpp_8 || other_pal.bpp_8 || pal.slots_count != 1 ||
+            other_pal.slots_count != 1 || pal.hash != other_pal.hash)
+    {
+        return false;
+    }
+
+    if(pal.animation_frames_ptr || other_pal.animation_frames_ptr || pal.inverted != other_pal.inverted ||
+            pal.grayscale_intensity != other_pal.grayscale_intensity ||
+            pal.hue_shift_intensity != other_pal.hue_shift_intensity ||
+            pal.fade_intensity != other_pal.fade_intensity || pal.fade_color != other_pal.fade_color ||
+            pal.rotate_count != other_pal.rotate_count || pal.rotate_range_start != other_pal.rotate_range_start ||
+            pal.rotate_range_size != other_pal.rotate_range_size)
+    {
+        return false;
+    }
+
+    int colors_per_palette = hw::palettes::colors_per_palette();
+    span<const color> colors(_initial_colors + (id * colors_per_palette), colors_per_palette);
+    return _same_colors(colors, other_id);
+}
+
 int palettes_bank::_bpp_8_slots_count() const
 {
     const palette& first_pal = _palettes[0];
@@ -824,6 +971,81 @@ void palettes_bank::_on_global_effect_updated(bool active)
             fixed_t<5>(_contrast).data() || fixed_t<5>(_intensity).data() ||
             fixed_t<5>(_grayscale_intensity).data() || fixed_t<5>(_hue_shift_intensity).data() ||
             fixed_t<5>(_fade_intensity).data();
+    _update_global_lut();
+}
+
+void palettes_bank::_update_global_lut()
+{
+    int brightness = fixed_t<5>(_brightness).data();
+    int contrast = fixed_t<5>(_contrast).data();
+    int intensity = fixed_t<5>(_intensity).data();
+
+    // Invert can be composed only if it isn't applied after a hue shift:
+    bool inverted = _inverted && ! fixed_t<5>(_hue_shift_intensity).data();
+    unsigned key = 0;
+
+    if(brightness || contrast || intensity || inverted)
+    {
+        key = 1 | (unsigned(brightness) << 1) | (unsigned(contrast) << 7) | (unsigned(intensity) << 13) |
+                (unsigned(inverted) << 19);
+    }
+
+    if(_global_lut_key != key)
+    {
+        _global_lut_key = key;
+
+        if(key)
+        {
+            hw::palettes::build_lut(brightness, contrast, intensity, inverted, _global_lut);
+        }
+    }
+}
+
+void palettes_bank::_release(int id)
+{
+    palette& pal = _palettes[id];
+
+    if(pal.animation_frames_ptr)
+    {
+        --_animations_count;
+    }
+
+    for(int slot = pal.slots_count - 1; slot >= 0; --slot)
+    {
+        _palettes[id + slot].locked = false;
+    }
+
+    if(! pal.bpp_8)
+    {
+        _erase_bpp_4_indexes_map_index(pal.hash, id);
+    }
+
+    pal = palette();
+}
+
+void palettes_bank::_relocate_bpp_4(int id, int new_id)
+{
+    palette& pal = _palettes[id];
+    palette& new_pal = _palettes[new_id];
+    int colors_per_palette = hw::palettes::colors_per_palette();
+    copy_colors(_initial_colors + (id * colors_per_palette), colors_per_palette,
+                _initial_colors + (new_id * colors_per_palette));
+
+    auto bpp_4_indexes_map_it = _bpp_4_indexes_map.find(pal.hash);
+
+    if(bpp_4_indexes_map_it == _bpp_4_indexes_map.end())
+    {
+        _bpp_4_indexes_map.insert(pal.hash, int16_t(new_id));
+    }
+    else if(bpp_4_indexes_map_it->second == id)
+    {
+        bpp_4_indexes_map_it->second = int16_t(new_id);
+    }
+
+    new_pal = pal;
+    new_pal.update = true;
+    pal = palette();
+    _update = true;
 }
 
 void palettes_bank::_set_colors_bpp_impl(int id, const span<const color>& colors)
@@ -834,12 +1056,118 @@ void palettes_bank::_set_colors_bpp_impl(int id, const span<const color>& colors
     _update = true;
 }
 
+void palettes_bank::_update_hash(int id)
+{
+    palette& pal = _palettes[id];
+    const color* colors_data = _initial_colors + (id * hw::palettes::colors_per_palette());
+    uint16_t old_hash = pal.hash;
+    uint16_t new_hash = colors_hash(span<const color>(colors_data, colors_count(id)));
+
+    if(old_hash != new_hash)
+    {
+        _erase_bpp_4_indexes_map_index(old_hash, id);
+        _bpp_4_indexes_map.insert_or_assign(new_hash, int16_t(id));
+        pal.hash = new_hash;
+    }
+}
+
+void palettes_bank::_apply_animation_frame(int id, const palette_animation_item::frame& frame)
+{
+    const palette& pal = _palettes[id];
+    int first_color_index = frame.first_color_index;
+    int frame_colors_count = frame.colors_count;
+    BN_ASSERT(first_color_index + frame_colors_count <= colors_count(id),
+              "Invalid animation frame: ", first_color_index, " - ", frame_colors_count, " - ", colors_count(id));
+
+    color* colors_data = _initial_colors + (id * hw::palettes::colors_per_palette());
+    hw::memory::copy_half_words(pal.animation_colors_ptr + frame.colors_offset, frame_colors_count,
+                                colors_data + first_color_index);
+
+    if(! pal.bpp_8 && first_color_index < hash_colors)
+    {
+        _update_hash(id);
+    }
+}
+
+void palettes_bank::_update_animations(int& first_color, int& last_color)
+{
+    // Palettes which are going to be fully updated anyway can't be updated partially:
+    bool update_all = _update && (_update_global_effects || _global_effects_enabled);
+    int colors_per_palette = hw::palettes::colors_per_palette();
+
+    for(int index = 0, limit = hw::palettes::count(); index < limit; )
+    {
+        palette& pal = _palettes[index];
+
+        if(pal.animation_frames_ptr)
+        {
+            int frame_index = pal.animation_frame_index + 1;
+            int frames_count = pal.animation_frames_count;
+
+            if(frame_index < frames_count)
+            {
+                const palette_animation_item::frame& frame = pal.animation_frames_ptr[frame_index];
+
+                // The last frame of a looping animation goes back to the first keyframe:
+                if(pal.animation_loop && frame_index == frames_count - 1)
+                {
+                    frame_index = 0;
+                }
+
+                pal.animation_frame_index = int16_t(frame_index);
+
+                if(frame.colors_count)
+                {
+                    _apply_animation_frame(index, frame);
+
+                    if(update_all || pal.update || pal.rotate_count)
+                    {
+                        pal.update = true;
+                        _update = true;
+                    }
+                    else
+                    {
+                        // Only the dirty colors range (aligned to words) is processed and committed:
+                        int pal_first_color = index * colors_per_palette;
+                        int dirty_first_color = pal_first_color + (frame.first_color_index & ~1);
+                        int dirty_last_color = pal_first_color +
+                                ((frame.first_color_index + frame.colors_count + 1) & ~1) - 1;
+                        int dirty_colors_count = dirty_last_color - dirty_first_color + 1;
+                        color* dirty_colors_ptr = _final_colors + dirty_first_color;
+                        copy_colors(_initial_colors + dirty_first_color, dirty_colors_count, dirty_colors_ptr);
+                        pal.apply_effects(dirty_colors_count, dirty_colors_ptr);
+
+                        if(_global_effects_enabled)
+                        {
+                            _apply_global_effects(dirty_colors_count, dirty_colors_ptr);
+                        }
+
+                        if(! dirty_first_color)
+                        {
+                            if(const color* transparent_color = _transparent_color.get())
+                            {
+                                _final_colors[0] = *transparent_color;
+                            }
+                        }
+
+                        first_color = min(first_color, dirty_first_color);
+                        last_color = max(last_color, dirty_last_color);
+                    }
+                }
+            }
+        }
+
+        index += pal.slots_count;
+    }
+}
+
 void palettes_bank::_update_palette(int id)
 {
     palette& pal = _palettes[id];
     const color* initial_pal_colors_ptr = _initial_colors + (id * hw::palettes::colors_per_palette());
     color* final_pal_colors_ptr = _final_colors + (id * hw::palettes::colors_per_palette());
     int pal_colors_count = pal.slots_count * hw::palettes::colors_per_palette();
+    pal.update = false;
     copy_colors(initial_pal_colors_ptr, pal_colors_count, final_pal_colors_ptr);
     pal.apply_effects(pal_colors_count, final_pal_colors_ptr);
 
@@ -858,34 +1186,25 @@ void palettes_bank::_update_palette(int id)
 
 void palettes_bank::_apply_global_effects(int dest_colors_count, color* dest_colors_ptr) const
 {
-    if(int brightness = fixed_t<5>(_brightness).data())
+    // Brightness, contrast, intensity and invert (if there's no hue shift) are applied with one cached LUT:
+    if(_global_lut_key)
     {
-        hw::palettes::brightness(dest_colors_ptr, brightness, dest_colors_count, dest_colors_ptr);
-    }
-
-    if(int contrast = fixed_t<5>(_contrast).data())
-    {
-        hw::palettes::contrast(dest_colors_ptr, contrast, dest_colors_count, dest_colors_ptr);
-    }
-
-    if(int intensity = fixed_t<5>(_intensity).data())
-    {
-        hw::palettes::intensity(dest_colors_ptr, intensity, dest_colors_count, dest_colors_ptr);
+        hw::palettes::aligned_lut_effect(dest_colors_ptr, _global_lut, dest_colors_count, dest_colors_ptr);
     }
 
     if(int hue_shift_intensity = fixed_t<5>(_hue_shift_intensity).data())
     {
         hw::palettes::hue_shift(dest_colors_ptr, hue_shift_intensity, dest_colors_count, dest_colors_ptr);
-    }
 
-    if(_inverted)
-    {
-        hw::palettes::aligned_invert(dest_colors_ptr, dest_colors_count, dest_colors_ptr);
+        if(_inverted)
+        {
+            hw::palettes::aligned_invert(dest_colors_ptr, dest_colors_count, dest_colors_ptr);
+        }
     }
 
     if(int grayscale_intensity = fixed_t<5>(_grayscale_intensity).data())
     {
-        hw::palettes::grayscale(dest_colors_ptr, grayscale_intensity, dest_colors_count, dest_colors_ptr);
+        hw::palettes::aligned_grayscale(dest_colors_ptr, grayscale_intensity, dest_colors_count, dest_colors_ptr);
     }
 
     if(int fade_intensity = fixed_t<5>(_fade_intensity).data())
@@ -913,7 +1232,8 @@ void palettes_bank::palette::apply_effects(int dest_colors_count, color* dest_co
 
     if(int pal_grayscale_intensity = fixed_t<5>(grayscale_intensity).data())
     {
-        hw::palettes::grayscale(dest_colors_ptr, pal_grayscale_intensity, dest_colors_count, dest_colors_ptr);
+        hw::palettes::aligned_grayscale(dest_colors_ptr, pal_grayscale_intensity, dest_colors_count,
+                                        dest_colors_ptr);
     }
 
     if(int pal_fade_intensity = fixed_t<5>(fade_intensity).data())
@@ -14,6 +14,7 @@
 #include "bn_unordered_map.h"
 #include "bn_identity_hasher.h"
 #include "bn_palette_effect_type.h"
+#include "bn_palette_animation_item.h"
 #include "../hw/include/bn_hw_palettes.h"
 
 namespace bn
@@ -60,6 +61,13 @@ public:
 
     void decrease_usages(int id);
 
+    [[nodiscard]] int usages(int id) const
+    {
+        return int(_palettes[id].usages);
+    }
+
+    [[nodiscard]] bool repack_bpp_4(unsigned movable_ids_mask, int8_t* new_ids);
+
     [[nodiscard]] int colors_count(int id) const
     {
         return _palettes[id].slots_count * hw::palettes::colors_per_palette();
@@ -129,6 +137,17 @@ public:
 
     void set_rotate_range(int id, int start, int size);
 
+    [[nodiscard]] bool has_animation(int id) const
+    {
+        return _palettes[id].animation_frames_ptr;
+    }
+
+    [[nodiscard]] bool animation_done(int id) const;
+
+    void set_animation(int id, const palette_animation_item& animation_item);
+
+    void remove_animation(int id);
+
     void reload(int id);
 
     [[nodiscard]] const optional<color>& transparent_color() const
@@ -236,12 +255,16 @@ private:
 
     public:
         unsigned usages = 0;
+        const color* animation_colors_ptr = nullptr;
+        const palette_animation_item::frame* animation_frames_ptr = nullptr;
         fixed grayscale_intensity;
         fixed hue_shift_intensity;
         fixed fade_intensity;
         color fade_color;
         uint16_t hash = 0;
         int16_t rotate_count = 0;
+        int16_t animation_frames_count = 0;
+        int16_t animation_frame_index = 0;
         int8_t slots_count = 1;
         int8_t rotate_range_start = 1;
         int8_t rotate_range_size = 0;
@@ -249,6 +272,7 @@ private:
         bool inverted: 1 = false;
         bool update: 1 = false;
         bool locked: 1 = false;
+        bool animation_loop: 1 = false;
 
         void apply_effects(int dest_colors_count, color* dest_colors_ptr) const;
     };
@@ -256,6 +280,8 @@ private:
     palette _palettes[hw::palettes::count()] = {};
     alignas(int) color _initial_colors[hw::palettes::colors()] = {};
     alignas(int) color _final_colors[hw::palettes::colors()] = {};
+    unsigned _global_lut[hw::palettes::lut_size()] = {};
+    unsigned _global_lut_key = 0;
     optional<color> _transparent_color;
     fixed _brightness;
     fixed _contrast;
@@ -265,8 +291,9 @@ private:
     fixed _fade_intensity;
     palette_effect_type _custom_effect = nullptr;
     unordered_map<uint16_t, int16_t, hw::palettes::count() * 2, identity_hasher> _bpp_4_indexes_map;
-    int _first_index_to_commit = numeric_limits<int>::max();
-    int _last_index_to_commit = 0;
+    int _first_color_to_commit = numeric_limits<int>::max();
+    int _last_color_to_commit = 0;
+    int _animations_count = 0;
     color _fade_color;
     bool _inverted = false;
     bool _update = false;
@@ -280,15 +307,35 @@ private:
 
     [[nodiscard]] int _first_bpp_4_palette_index() const;
 
-    __attribute__((noinline)) void _erase_bpp_4_indexes_map_index(uint16_t hash)
+    [[nodiscard]] bool _same_bpp_4_palettes(int id, int other_id) const;
+
+    __attribute__((noinline)) void _erase_bpp_4_indexes_map_index(uint16_t hash, int id)
     {
-        _bpp_4_indexes_map.erase(hash);
+        auto bpp_4_indexes_map_it = _bpp_4_indexes_map.find(hash);
+
+        // Identical palettes share the same hash, so it is erased only if it points to the given palette:
+        if(bpp_4_indexes_map_it != _bpp_4_indexes_map.end() && bpp_4_indexes_map_it->second == id)
+        {
+            _bpp_4_indexes_map.erase(bpp_4_indexes_map_it);
+        }
     }
 
+    void _release(int id);
+
+    void _relocate_bpp_4(int id, int new_id);
+
     void _on_global_effect_updated(bool active);
 
+    void _update_global_lut();
+
     void _set_colors_bpp_impl(int id, const span<const color>& colors);
 
+    void _update_hash(int id);
+
+    void _apply_animation_frame(int id, const palette_animation_item::frame& frame);
+
+    void _update_animations(int& first_color, int& last_color);
+
     void _update_palette(int id);
 
     void _apply_global_effects(int dest_colors_count, color* dest_colors_ptr) const;
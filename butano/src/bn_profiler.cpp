@@ -6,9 +6,23 @@
 #include "bn_profiler.h"
 
 #if BN_CFG_PROFILER_ENABLED
-    #include "bn_timer.h"
-    #include "bn_optional.h"
+    #include "bn_span.h"
+    #include "bn_string.h"
+    #include "bn_string_view.h"
     #include "bn_unordered_map.h"
+    #include "bn_config_log.h"
+    #include "../hw/include/bn_hw_timer.h"
+
+    #if BN_CFG_LOG_ENABLED
+        #include "bn_log.h"
+    #endif
+
+    #if BN_CFG_PROFILER_TRACE_ENABLED
+        #include "bn_timers.h"
+
+        static_assert(BN_CFG_LOG_ENABLED, "Events tracing requires log enabled");
+        static_assert(BN_CFG_LOG_MAX_SIZE >= 64);
+    #endif
 
     namespace _bn::profiler
     {
@@ -16,54 +30,347 @@
         {
             static_assert(BN_CFG_PROFILER_MAX_ENTRIES > 0);
             static_assert(bn::power_of_two(BN_CFG_PROFILER_MAX_ENTRIES));
+            static_assert(BN_CFG_PROFILER_MAX_DEPTH > 0);
+
+            #if BN_CFG_PROFILER_TRACE_ENABLED
+                static_assert(BN_CFG_PROFILER_TRACE_MAX_EVENTS > 0);
+
+                constexpr int max_trace_events = BN_CFG_PROFILER_TRACE_MAX_EVENTS;
+            #endif
+
+            constexpr int max_slots = BN_CFG_PROFILER_MAX_ENTRIES;
+            constexpr int max_nodes = BN_CFG_PROFILER_MAX_ENTRIES * 2;
+            constexpr int max_depth = BN_CFG_PROFILER_MAX_DEPTH;
+
+            class active_node
+            {
+
+            public:
+                int node;
+                unsigned start_ticks;
+            };
+
+            #if BN_CFG_PROFILER_TRACE_ENABLED
+                class trace_event
+                {
+
+                public:
+                    unsigned ticks;
+                    int16_t slot;
+                    bool begin;
+                };
+            #endif
 
             class static_data
             {
 
             public:
-                ticks_map ticks_per_entry;
-                bn::optional<bn::timer> current_timer;
-                const char* current_id = nullptr;
-                unsigned current_id_hash;
+                const char* slot_ids[max_slots];
+                int slot_last_nodes[max_slots];
+                node nodes[max_nodes];
+                active_node active_nodes[max_depth];
+                ticks_map counts_per_entry;
+                int slots_count = 0;
+                int nodes_count = 1;
+                int active_nodes_count = 0;
+
+                #if BN_CFG_PROFILER_TRACE_ENABLED
+                    trace_event trace_events[max_trace_events];
+                    int trace_events_count = 0;
+                    int trace_dropped_events_count = 0;
+                    int trace_named_slots_count = 0;
+                    bool trace_started = false;
+                #endif
             };
 
             BN_DATA_EWRAM static_data data;
+
+            #if BN_CFG_PROFILER_TRACE_ENABLED
+                void _add_trace_event(int slot, bool begin, unsigned ticks)
+                {
+                    int trace_events_count = data.trace_events_count;
+
+                    if(trace_events_count < max_trace_events) [[likely]]
+                    {
+                        trace_event& event = data.trace_events[trace_events_count];
+                        event.ticks = ticks;
+                        event.slot = int16_t(slot);
+                        event.begin = begin;
+                        data.trace_events_count = trace_events_count + 1;
+                    }
+                    else
+                    {
+                        ++data.trace_dropped_events_count;
+                    }
+                }
+            #endif
+
+            [[nodiscard]] int _find_or_create_node(int slot, int parent)
+            {
+                node* nodes = data.nodes;
+                node& parent_node = nodes[parent];
+                int last_child = -1;
+
+                for(int child = parent_node.first_child; child >= 0; child = nodes[child].next_sibling)
+                {
+                    if(nodes[child].slot == slot)
+                    {
+                        return child;
+                    }
+
+                    last_child = child;
+                }
+
+                int result = data.nodes_count;
+                BN_BASIC_ASSERT(result < max_nodes, "Too many profiler entries");
+
+                data.nodes_count = result + 1;
+
+                node& new_node = nodes[result];
+                new_node = node();
+                new_node.id = data.slot_ids[slot];
+                new_node.parent = parent;
+                new_node.slot = slot;
+
+                if(last_child >= 0)
+                {
+                    nodes[last_child].next_sibling = result;
+                }
+                else
+                {
+                    parent_node.first_child = result;
+                }
+
+                return result;
+            }
         }
 
-        void start(const char* id, unsigned id_hash)
+        int slot(const char* id)
         {
             BN_BASIC_ASSERT(id, "Id is null");
-            BN_BASIC_ASSERT(! data.current_id, "There's already an active id: ", data.current_id);
 
-            data.current_id = id;
-            data.current_id_hash = id_hash;
-            data.current_timer = bn::timer();
+            bn::string_view id_view(id);
+            int slots_count = data.slots_count;
+
+            for(int slot = 0; slot < slots_count; ++slot)
+            {
+                if(data.slot_ids[slot] == id || bn::string_view(data.slot_ids[slot]) == id_view)
+                {
+                    return slot;
+                }
+            }
+
+            BN_BASIC_ASSERT(slots_count < max_slots, "Too many profiler ids");
+
+            data.slot_ids[slots_count] = id;
+            data.slot_last_nodes[slots_count] = -1;
+            data.slots_count = slots_count + 1;
+            return slots_count;
+        }
+
+        #if BN_CFG_ASSERT_ENABLED
+            void check_slot(int slot, const char* id)
+            {
+                const char* slot_id = data.slot_ids[slot];
+
+                if(slot_id != id)
+                {
+                    BN_BASIC_ASSERT(id, "Id is null");
+                    BN_BASIC_ASSERT(bn::string_view(slot_id) == bn::string_view(id),
+                                    "Profiler id changed in the same call site: ", slot_id, " - ", id);
+                }
+            }
+        #endif
+
+        void start(int slot)
+        {
+            int active_nodes_count = data.active_nodes_count;
+            BN_BASIC_ASSERT(active_nodes_count < max_depth, "Too many nested ids");
+
+            int parent = active_nodes_count ? data.active_nodes[active_nodes_count - 1].node : 0;
+            int node_index = data.slot_last_nodes[slot];
+
+            if(node_index < 0 || data.nodes[node_index].parent != parent) [[unlikely]]
+            {
+                node_index = _find_or_create_node(slot, parent);
+                data.slot_last_nodes[slot] = node_index;
+            }
+
+            active_node& new_active_node = data.active_nodes[active_nodes_count];
+            new_active_node.node = node_index;
+            data.active_nodes_count = active_nodes_count + 1;
+
+            unsigned ticks = bn::hw::timer::ticks();
+            new_active_node.start_ticks = ticks;
+
+            #if BN_CFG_PROFILER_TRACE_ENABLED
+                _add_trace_event(slot, true, ticks);
+            #endif
         }
 
         void stop()
         {
-            BN_BASIC_ASSERT(data.current_id, "There's no active id");
-
-            int timer_ticks = data.current_timer->elapsed_ticks();
-            auto timer_ticks_64 = int64_t(timer_ticks);
-            ticks& ticks = data.ticks_per_entry(data.current_id_hash, data.current_id);
-            ticks.total += timer_ticks_64;
-            ticks.max = bn::max(ticks.max, timer_ticks);
-            data.current_id = nullptr;
+            unsigned ticks = bn::hw::timer::ticks();
+            int active_nodes_count = data.active_nodes_count - 1;
+            BN_BASIC_ASSERT(active_nodes_count >= 0, "There's no active id");
+
+            const active_node& last_active_node = data.active_nodes[active_nodes_count];
+            node& last_node = data.nodes[last_active_node.node];
+            int elapsed_ticks = int(ticks - last_active_node.start_ticks);
+            last_node.total_ticks += elapsed_ticks;
+            last_node.max_ticks = bn::max(last_node.max_ticks, elapsed_ticks);
+            ++last_node.calls;
+            data.nodes[last_node.parent].children_ticks += elapsed_ticks;
+            data.active_nodes_count = active_nodes_count;
+
+            #if BN_CFG_PROFILER_TRACE_ENABLED
+                _add_trace_event(last_node.slot, false, ticks);
+            #endif
+        }
+
+        void add_count(const char* id, unsigned id_hash, int count)
+        {
+            BN_BASIC_ASSERT(id, "Id is null");
+
+            ticks& counts = data.counts_per_entry(id_hash, id);
+            counts.total += int64_t(count);
+            counts.max = bn::max(counts.max, count);
         }
 
-        const ticks_map& ticks_per_entry()
+        bn::span<const node> nodes()
         {
-            BN_BASIC_ASSERT(! data.current_id, "There's an active id: ", data.current_id);
+            BN_BASIC_ASSERT(! data.active_nodes_count, "There's an active id: ",
+                            data.nodes[data.active_nodes[data.active_nodes_count - 1].node].id);
+
+            return bn::span<const node>(data.nodes, data.nodes_count);
+        }
 
-            return data.ticks_per_entry;
+        const ticks_map& counts_per_entry()
+        {
+            return data.counts_per_entry;
         }
 
         void reset()
         {
-            BN_BASIC_ASSERT(! data.current_id, "There's an active id: ", data.current_id);
+            BN_BASIC_ASSERT(! data.active_nodes_count, "There's an active id: ",
+                            data.nodes[data.active_nodes[data.active_nodes_count - 1].node].id);
+
+            for(int slot = 0, slots_count = data.slots_count; slot < slots_count; ++slot)
+            {
+                data.slot_last_nodes[slot] = -1;
+            }
+
+            data.nodes[0] = node();
+            data.nodes_count = 1;
+            data.counts_per_entry.clear();
+
+            #if BN_CFG_PROFILER_TRACE_ENABLED
+                data.trace_events_count = 0;
+                data.trace_dropped_events_count = 0;
+            #endif
+        }
+
+        #if BN_CFG_PROFILER_TRACE_ENABLED
+            void flush_trace()
+            {
+                unsigned ticks = bn::hw::timer::ticks();
+
+                if(! data.trace_started)
+                {
+                    data.trace_started = true;
+                    BN_LOG("bn_trace_start ", bn::timers::ticks_per_second());
+                }
+
+                // Log ids of new slots:
+                for(int slot = data.trace_named_slots_count, slots_count = data.slots_count; slot < slots_count;
+                    ++slot)
+                {
+                    BN_LOG("bn_trace_name ", slot, ' ', data.slot_ids[slot]);
+                }
+
+                data.trace_named_slots_count = data.slots_count;
+
+                // Log events (several of them per line), followed by a frame event:
+                constexpr int max_event_size = 20;
+                bn::string<BN_CFG_LOG_MAX_SIZE - 1> line("bn_trace");
+                bn::ostringstream line_stream(line);
+
+                for(int index = 0, limit = data.trace_events_count; index < limit; ++index)
+                {
+                    if(line.available() < max_event_size)
+                    {
+                        BN_LOG(line);
+                        line.assign("bn_trace");
+                    }
+
+                    const trace_event& event = data.trace_events[index];
+                    line_stream << ' ' << (event.begin ? 'B' : 'E') << event.slot << ':' << event.ticks;
+                }
+
+                if(line.available() < max_event_size)
+                {
+                    BN_LOG(line);
+                    line.assign("bn_trace");
+                }
+
+                line_stream << " F:" << ticks;
+                BN_LOG(line);
+
+                if(int dropped_events_count = data.trace_dropped_events_count)
+                {
+                    BN_LOG("bn_trace_dropped ", dropped_events_count);
+                    data.trace_dropped_events_count = 0;
+                }
+
+                data.trace_events_count = 0;
+            }
+        #endif
+    }
+
+    namespace bn::profiler
+    {
+        void log()
+        {
+            #if BN_CFG_LOG_ENABLED
+                bn::span<const _bn::profiler::node> nodes = _bn::profiler::nodes();
+
+                for(int node_index = 1, nodes_count = nodes.size(); node_index < nodes_count; ++node_index)
+                {
+                    // Build node path from the root:
+                    const char* path_ids[BN_CFG_PROFILER_MAX_DEPTH];
+                    int path_ids_count = 0;
+
+                    for(int path_node = node_index; path_node > 0; path_node = nodes[path_node].parent)
+                    {
+                        path_ids[path_ids_count] = nodes[path_node].id;
+                        ++path_ids_count;
+                    }
+
+                    // Some space is reserved for the ticks:
+                    constexpr int path_max_size = BN_CFG_LOG_MAX_SIZE > 48 ? BN_CFG_LOG_MAX_SIZE - 24 :
+                                                                            BN_CFG_LOG_MAX_SIZE / 2;
+                    string<path_max_size> path;
+
+                    for(int path_id_index = path_ids_count - 1; path_id_index >= 0; --path_id_index)
+                    {
+                        string_view path_id(path_ids[path_id_index]);
+
+                        if(path.available() <= path_id.size())
+                        {
+                            break;
+                        }
+
+                        path.append(path_id);
+
+                        if(path_id_index)
+                        {
+                            path.push_back(';');
+                        }
+                    }
 
-            data.ticks_per_entry.clear();
+                    BN_LOG(path, ' ', nodes[node_index].self_ticks());
+                }
+            #endif
         }
     }
 #endif
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BN_PROFILER_ENGINE_H
+#define BN_PROFILER_ENGINE_H
+
+#include "bn_profiler.h"
+#include "bn_telemetry.h"
+
+#if BN_CFG_PROFILER_ENABLED && BN_CFG_PROFILER_LOG_ENGINE
+    #if BN_CFG_PROFILER_LOG_ENGINE_DETAILED
+        #define BN_PROFILER_ENGINE_PROFILER_GENERAL_START(id) \
+            do \
+            { \
+            } while(false)
+
+        #define BN_PROFILER_ENGINE_PROFILER_GENERAL_STOP() \
+            do \
+            { \
+            } while(false)
+
+        #define BN_PROFILER_ENGINE_PROFILER_DETAILED_START(id) \
+            BN_PROFILER_START(id)
+
+        #define BN_PROFILER_ENGINE_PROFILER_DETAILED_STOP() \
+            BN_PROFILER_STOP()
+
+        #define BN_PROFILER_ENGINE_DETAILED_COUNT(id, count) \
+            BN_PROFILER_COUNT(id, count)
+    #else
+        #define BN_PROFILER_ENGINE_PROFILER_GENERAL_START(id) \
+            BN_PROFILER_START(id)
+
+        #define BN_PROFILER_ENGINE_PROFILER_GENERAL_STOP() \
+            BN_PROFILER_STOP()
+
+        #define BN_PROFILER_ENGINE_PROFILER_DETAILED_START(id) \
+            do \
+            { \
+            } while(false)
+
+        #define BN_PROFILER_ENGINE_PROFILER_DETAILED_STOP() \
+            do \
+            { \
+            } while(false)
+
+        #define BN_PROFILER_ENGINE_DETAILED_COUNT(id, count) \
+            do \
+            { \
+            } while(false)
+    #endif
+#else
+    #define BN_PROFILER_ENGINE_PROFILER_GENERAL_START(id) \
+        do \
+        { \
+        } while(false)
+
+    #define BN_PROFILER_ENGINE_PROFILER_GENERAL_STOP() \
+        do \
+        { \
+        } while(false)
+
+    #define BN_PROFILER_ENGINE_PROFILER_DETAILED_START(id) \
+        do \
+        { \
+        } while(false)
+
+    #define BN_PROFILER_ENGINE_PROFILER_DETAILED_STOP() \
+        do \
+        { \
+        } while(false)
+
+    #define BN_PROFILER_ENGINE_DETAILED_COUNT(id, count) \
+        do \
+        { \
+        } while(false)
+#endif
+
+#if BN_CFG_TELEMETRY_ENABLED
+    #define BN_PROFILER_ENGINE_TELEMETRY_START(id) \
+        do \
+        { \
+            constexpr int _bn_telemetry_section_index = _bn::telemetry::engine_section_index(id); \
+            static_assert(_bn_telemetry_section_index >= 0, "Unknown telemetry section"); \
+            _bn::telemetry::start(_bn_telemetry_section_index); \
+        } while(false)
+
+    #define BN_PROFILER_ENGINE_TELEMETRY_STOP() \
+        _bn::telemetry::stop()
+#else
+    #define BN_PROFILER_ENGINE_TELEMETRY_START(id) \
+        do \
+        { \
+        } while(false)
+
+    #define BN_PROFILER_ENGINE_TELEMETRY_STOP() \
+        do \
+        { \
+        } while(false)
+#endif
+
+#define BN_PROFILER_ENGINE_GENERAL_START(id) \
+    do \
+    { \
+        BN_PROFILER_ENGINE_PROFILER_GENERAL_START(id); \
+        BN_PROFILER_ENGINE_TELEMETRY_START(id); \
+    } while(false)
+
+#define BN_PROFILER_ENGINE_GENERAL_STOP() \
+    do \
+    { \
+        BN_PROFILER_ENGINE_TELEMETRY_STOP(); \
+        BN_PROFILER_ENGINE_PROFILER_GENERAL_STOP(); \
+    } while(false)
+
+#define BN_PROFILER_ENGINE_DETAILED_START(id) \
+    do \
+    { \
+        BN_PROFILER_ENGINE_PROFILER_DETAILED_START(id); \
+        BN_PROFILER_ENGINE_TELEMETRY_START(id); \
+    } while(false)
+
+#define BN_PROFILER_ENGINE_DETAILED_STOP() \
+    do \
+    { \
+        BN_PROFILER_ENGINE_TELEMETRY_STOP(); \
+        BN_PROFILER_ENGINE_PROFILER_DETAILED_STOP(); \
+    } while(false)
+
+#endif
@@ -0,0 +1,365 @@
+/*
+ * Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_regular_bg_text_generator.h"
+
+#include "bn_display.h"
+#include "bn_bg_palette_ptr.h"
+#include "bn_bg_palette_item.h"
+#include "bn_utf8_character.h"
+#include "bn_regular_bg_tiles_item.h"
+#include "bn_regular_bg_map_cell_info.h"
+#include "../hw/include/bn_hw_sprite_tiles.h"
+
+namespace bn
+{
+
+namespace
+{
+    constexpr int map_size = 32;
+
+    [[nodiscard]] bool _use_canvas(const sprite_font& font)
+    {
+        return ! font.character_widths_ref().empty() || font.space_between_characters();
+    }
+
+    [[nodiscard]] regular_bg_tiles_ptr _create_tiles(const sprite_font& font, const size& dimensions)
+    {
+        int width = dimensions.width();
+        int height = dimensions.height();
+        BN_ASSERT(width > 0 && width <= map_size, "Invalid width: ", width);
+        BN_ASSERT(height > 0 && height <= map_size, "Invalid height: ", height);
+
+        const span<const tile>& font_tiles = font.item().tiles_item().tiles_ref();
+        bool canvas = _use_canvas(font);
+        int tiles_count = canvas ? 1 + (width * height) : 1 + font_tiles.size();
+        BN_ASSERT(regular_bg_tiles_item::valid_tiles_count(tiles_count, bpp_mode::BPP_4),
+                  "Too many tiles: ", tiles_count, " (canvas: ", canvas, ")");
+
+        regular_bg_tiles_ptr result = regular_bg_tiles_ptr::allocate(tiles_count, bpp_mode::BPP_4, false);
+        tile* tiles_vram = result.vram()->data();
+
+        if(canvas)
+        {
+            hw::sprite_tiles::clear_tiles(tiles_count, tiles_vram);
+        }
+        else
+        {
+            hw::sprite_tiles::clear_tiles(1, tiles_vram);
+            hw::sprite_tiles::copy_tiles(font_tiles.data(), font_tiles.size(), tiles_vram + 1);
+        }
+
+        return result;
+    }
+
+    [[nodiscard]] bg_palette_item _palette_item(const sprite_font& font)
+    {
+        const sprite_palette_item& palette_item = font.item().palette_item();
+        return bg_palette_item(palette_item.colors_ref(), palette_item.bpp(), palette_item.compression());
+    }
+
+    [[nodiscard]] int _cells_offset(const regular_bg_map_ptr& map)
+    {
+        regular_bg_map_cell_info cell_info;
+        cell_info.set_tile_index(map.tiles_offset());
+        cell_info.set_palette_id(map.palette_banks_offset());
+        return cell_info.cell();
+    }
+
+    [[nodiscard]] int _graphics_index(char character, const utf8_characters_map_ref& utf8_characters_map,
+                                      const char* text_data, int& text_index)
+    {
+        int result;
+
+        if(character <= '~')
+        {
+            result = character - '!';
+            ++text_index;
+        }
+        else
+        {
+            utf8_character utf8_char(text_data[text_index]);
+            result = utf8_characters_map.index(utf8_char) + sprite_font::minimum_graphics;
+            text_index += utf8_char.size();
+        }
+
+        return result;
+    }
+
+
+    class layout
+    {
+
+    public:
+        explicit layout(const sprite_font& font) :
+            _utf8_characters_map(font.utf8_characters_ref()),
+            _character_widths(font.character_widths_ref().data()),
+            _character_width(font.item().shape_size().width()),
+            _space_between_characters(font.space_between_characters())
+        {
+        }
+
+        template<class Function>
+        int walk(const string_view& text, Function&& function) const
+        {
+            const char* text_data = text.data();
+            int text_index = 0;
+            int text_size = text.size();
+            int space_width = _character_widths ? _character_widths[0] : _character_width;
+            int x = 0;
+
+            while(text_index < text_size)
+            {
+                char character = text_data[text_index];
+
+                if(character == ' ')
+                {
+                    x += space_width + _space_between_characters;
+                    ++text_index;
+                }
+                else if(character == '\t')
+                {
+                    x += (space_width * 4) + _space_between_characters;
+                    ++text_index;
+                }
+                else if(character >= '!')
+                {
+                    int graphics_index = _graphics_index(character, _utf8_characters_map, text_data, text_index);
+                    int width = _character_widths ? _character_widths[graphics_index + 1] : _character_width;
+
+                    if(width)
+                    {
+                        function(graphics_index, x, width);
+                    }
+
+                    x += width + _space_between_characters;
+                }
+                else
+                {
+                    BN_ERROR("Invalid character: ", character, " (text: ", text, ")");
+                }
+            }
+
+            return x;
+        }
+
+    private:
+        const utf8_characters_map_ref& _utf8_characters_map;
+        const int8_t* _character_widths;
+        int _character_width;
+        int _space_between_characters;
+    };
+}
+
+regular_bg_text_generator::regular_bg_text_generator(const sprite_font& font) :
+    regular_bg_text_generator(font, size(display::width() / 8, display::height() / 8), _palette_item(font))
+{
+}
+
+regular_bg_text_generator::regular_bg_text_generator(const sprite_font& font, const size& dimensions) :
+    regular_bg_text_generator(font, dimensions, _palette_item(font))
+{
+}
+
+regular_bg_text_generator::regular_bg_text_generator(const sprite_font& font, const size& dimensions,
+                                                     const bg_palette_item& palette_item) :
+    _font(font),
+    _dimensions(dimensions),
+    _character_columns(int8_t(font.item().shape_size().width() / 8)),
+    _character_rows(int8_t(font.item().shape_size().height() / 8)),
+    _canvas(_use_canvas(font)),
+    _tiles(_create_tiles(font, dimensions)),
+    _map(regular_bg_map_ptr::allocate(size(map_size, map_size), _tiles, bg_palette_ptr::create(palette_item)))
+{
+    BN_ASSERT(palette_item.bpp() == bpp_mode::BPP_4, "8BPP fonts not supported");
+
+    span<regular_bg_map_cell> cells = *_map.vram();
+    int cells_offset = _cells_offset(_map);
+    hw::memory::set_half_words(uint16_t(cells_offset), cells.size(), cells.data());
+
+    if(_canvas)
+    {
+        int width = dimensions.width();
+        int height = dimensions.height();
+        int first_column = (map_size - width) / 2;
+        int first_row = (map_size - height) / 2;
+        int tile_index = 1;
+
+        for(int row = 0; row < height; ++row)
+        {
+            regular_bg_map_cell* row_cells = cells.data() + ((first_row + row) * map_size) + first_column;
+
+            for(int column = 0; column < width; ++column)
+            {
+                row_cells[column] = regular_bg_map_cell(cells_offset + tile_index);
+                ++tile_index;
+            }
+        }
+    }
+}
+
+int regular_bg_text_generator::width(const string_view& text) const
+{
+    layout text_layout(_font);
+    return text_layout.walk(text, [](int, int, int) { });
+}
+
+void regular_bg_text_generator::generate(const point& cell, const string_view& text)
+{
+    _update(cell, 0, 0, text);
+}
+
+void regular_bg_text_generator::update(const point& cell, const string_view& old_text, const string_view& new_text)
+{
+    int old_size = old_text.size();
+    int new_size = new_text.size();
+    int limit = min(old_size, new_size);
+    int prefix_size = 0;
+
+    while(prefix_size < limit && old_text[prefix_size] == new_text[prefix_size])
+    {
+        ++prefix_size;
+    }
+
+    if(prefix_size == old_size && prefix_size == new_size)
+    {
+        return;
+    }
+
+    // Don't split UTF-8 characters:
+    while(prefix_size > 0 && prefix_size < limit && (uint8_t(new_text[prefix_size]) & 0xC0) == 0x80)
+    {
+        --prefix_size;
+    }
+
+    int dirty_width = width(new_text.substr(0, prefix_size));
+    _update(cell, dirty_width, width(old_text), new_text);
+}
+
+void regular_bg_text_generator::clear(const point& cell, const size& dimensions)
+{
+    int cell_x = cell.x();
+    int cell_y = cell.y();
+    int width = dimensions.width();
+    int height = dimensions.height();
+    BN_ASSERT(cell_x >= 0 && cell_y >= 0 && width >= 0 && height >= 0 &&
+              cell_x + width <= _dimensions.width() && cell_y + height <= _dimensions.height(),
+              "Invalid region: ", cell_x, " - ", cell_y, " - ", width, " - ", height, " - ",
+              _dimensions.width(), " - ", _dimensions.height());
+
+    if(_canvas)
+    {
+        tile* canvas_tiles = _tiles.vram()->data() + 1 + (cell_y * _dimensions.width()) + cell_x;
+
+        for(int row = 0; row < height; ++row)
+        {
+            hw::sprite_tiles::clear_tiles(width, canvas_tiles);
+            canvas_tiles += _dimensions.width();
+        }
+    }
+    else
+    {
+        int first_column = ((map_size - _dimensions.width()) / 2) + cell_x;
+        int first_row = ((map_size - _dimensions.height()) / 2) + cell_y;
+        regular_bg_map_cell* cells = _map.vram()->data() + (first_row * map_size) + first_column;
+        auto cells_offset = uint16_t(_cells_offset(_map));
+
+        for(int row = 0; row < height; ++row)
+        {
+            hw::memory::set_half_words(cells_offset, width, cells);
+            cells += map_size;
+        }
+    }
+}
+
+void regular_bg_text_generator::clear()
+{
+    clear(point(), _dimensions);
+}
+
+void regular_bg_text_generator::_update(const point& cell, int dirty_width, int old_width,
+                                        const string_view& new_text)
+{
+    layout text_layout(_font);
+    int new_width = text_layout.walk(new_text, [](int, int, int) { });
+    int first_column = max(dirty_width, 0) / 8;
+    int last_column = (max(old_width, new_width) + 7) / 8;
+    int character_columns = _character_columns;
+    int character_rows = _character_rows;
+    BN_ASSERT(cell.x() >= 0 && cell.y() >= 0 && cell.x() + last_column <= _dimensions.width() &&
+              cell.y() + character_rows <= _dimensions.height(),
+              "Text out of bounds: ", cell.x(), " - ", cell.y(), " - ", last_column, " - ", character_rows,
+              " - ", _dimensions.width(), " - ", _dimensions.height(), " (text: ", new_text, ")");
+
+    if(last_column > first_column)
+    {
+        clear(point(cell.x() + first_column, cell.y()), size(last_column - first_column, character_rows));
+    }
+
+    int first_x = first_column * 8;
+    int tiles_per_character = character_columns * character_rows;
+
+    if(_canvas)
+    {
+        int canvas_width = _dimensions.width();
+        tile* canvas_tiles = _tiles.vram()->data() + 1 + (cell.y() * canvas_width);
+        const tile* font_tiles = _font.item().tiles_item().tiles_ref().data();
+        int canvas_x = cell.x() * 8;
+
+        text_layout.walk(new_text, [&](int graphics_index, int x, int width)
+        {
+            if(x + width > first_x)
+            {
+                const tile* character_tiles = font_tiles + (graphics_index * tiles_per_character);
+
+                for(int column = 0; column < character_columns && width > 0; ++column)
+                {
+                    int column_width = min(width, 8);
+                    tile* row_tiles = canvas_tiles;
+
+                    for(int row = 0; row < character_rows; ++row)
+                    {
+                        hw::sprite_tiles::plot_tiles(column_width, character_tiles + (row * character_columns), 0,
+                                                     canvas_x + x, row_tiles);
+                        row_tiles += canvas_width;
+                    }
+
+                    ++character_tiles;
+                    x += 8;
+                    width -= 8;
+                }
+            }
+        });
+    }
+    else
+    {
+        int first_map_column = ((map_size - _dimensions.width()) / 2) + cell.x();
+        int first_map_row = ((map_size - _dimensions.height()) / 2) + cell.y();
+        regular_bg_map_cell* cells = _map.vram()->data() + (first_map_row * map_size) + first_map_column;
+        int cells_offset = _cells_offset(_map);
+
+        text_layout.walk(new_text, [&](int graphics_index, int x, int)
+        {
+            if(x >= first_x)
+            {
+                int tile_index = cells_offset + 1 + (graphics_index * tiles_per_character);
+                regular_bg_map_cell* character_cells = cells + (x / 8);
+
+                for(int row = 0; row < character_rows; ++row)
+                {
+                    for(int column = 0; column < character_columns; ++column)
+                    {
+                        character_cells[column] = regular_bg_map_cell(tile_index);
+                        ++tile_index;
+                    }
+
+                    character_cells += map_size;
+                }
+            }
+        });
+    }
+}
+
+}
@@ -180,4 +180,9 @@ optional<span<tile>> regular_bg_tiles_ptr::vram()
     return bg_blocks_manager::tiles_vram(_handle);
 }
 
+bool regular_bg_tiles_ptr::loaded() const
+{
+    return ! bg_blocks_manager::must_commit(_handle);
+}
+
 }
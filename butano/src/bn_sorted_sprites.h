@@ -7,6 +7,9 @@
 #define BN_SORTED_SPRITES_H
 
 #include "bn_pool.h"
+#include "bn_vector.h"
+#include "bn_unordered_map.h"
+#include "bn_identity_hasher.h"
 #include "bn_config_sprites.h"
 #include "bn_sprites_manager_item.h"
 
@@ -36,15 +39,59 @@ namespace bn::sorted_sprites
             return _items;
         }
 
+        [[nodiscard]] bool dirty() const
+        {
+            return _dirty;
+        }
+
+        void set_dirty()
+        {
+            _dirty = true;
+        }
+
+        [[nodiscard]] int first_handles_index() const
+        {
+            return _first_handles_index;
+        }
+
+        [[nodiscard]] int handles_count() const
+        {
+            return _handles_count;
+        }
+
+        void set_handles(int first_handles_index, int handles_count)
+        {
+            _first_handles_index = int16_t(first_handles_index);
+            _handles_count = int16_t(handles_count);
+            _dirty = false;
+        }
+
     private:
         sort_key _sort_key;
         intrusive_list<sprites_manager_item> _items;
+        int16_t _first_handles_index = -1;
+        int16_t _handles_count = 0;
+        bool _dirty = true;
     };
 
 
     using layers_type = intrusive_list<layer>;
 
 
+    constexpr int max_layers = BN_CFG_SPRITES_MAX_SORT_LAYERS;
+    constexpr int max_layers_map_items = [](){
+        int minimum = max_layers * 2;
+        int result = 2;
+
+        while(result < minimum)
+        {
+            result *= 2;
+        }
+
+        return result;
+    }();
+
+
     class sorter
     {
 
@@ -75,32 +122,23 @@ namespace bn::sorted_sprites
                 item_sort_key.set_priority(0);
             }
 
-            layers_type& layer_ptrs = _layer_ptrs;
-            layers_type::iterator layers_end = layer_ptrs.end();
-            layers_type::iterator layers_it = lower_bound(layer_ptrs.begin(), layers_end, item_sort_key,
-                    [](const layer& layer, sort_key sort_key) {
-                        return layer.layer_sort_key() < sort_key;
-                    });
+            unsigned item_sort_key_data = item_sort_key.data();
+            layers_map_type::iterator layers_map_it = _layers_map.find(item_sort_key_data);
+            layer* layer_ptr;
 
-            if(layers_it == layers_end)
+            if(layers_map_it != _layers_map.end()) [[likely]]
             {
-                BN_BASIC_ASSERT(! _layer_pool.full(), "No more sprite sort layers available");
-
-                layer& pool_layer = _layer_pool.create(item_sort_key);
-                layers_it = layer_ptrs.insert(layers_end, pool_layer);
+                layer_ptr = layers_map_it->second;
             }
-            else if(item_sort_key != layers_it->layer_sort_key())
+            else
             {
-                BN_BASIC_ASSERT(! _layer_pool.full(), "No more sprite sort layers available");
-
-                layer& pool_layer = _layer_pool.create(item_sort_key);
-                layers_it = layer_ptrs.insert(layers_it, pool_layer);
+                layer_ptr = &_create_layer(item_sort_key);
             }
 
-            layer& layer_ref = *layers_it;
-            layer_ref.items().push_front(item);
+            layer_ptr->items().push_front(item);
+            layer_ptr->set_dirty();
 
-            int diff = &layer_ref - reinterpret_cast<layer*>(&layer_ptrs);
+            int diff = layer_ptr - reinterpret_cast<layer*>(&_layer_ptrs);
             item.sort_layer_ptr_diff = int16_t(diff);
         }
 
@@ -112,8 +150,24 @@ namespace bn::sorted_sprites
 
             if(layer_items.empty())
             {
-                _layer_ptrs.erase(*layer);
-                _layer_pool.destroy(*layer);
+                _destroy_layer(*layer);
+            }
+            else
+            {
+                layer->set_dirty();
+            }
+        }
+
+        void set_layer_dirty(const sprites_manager_item& item)
+        {
+            _layer_ptr(item.sort_layer_ptr_diff)->set_dirty();
+        }
+
+        void set_layers_dirty()
+        {
+            for(layer& layer : _layer_ptrs)
+            {
+                layer.set_dirty();
             }
         }
 
@@ -127,6 +181,7 @@ namespace bn::sorted_sprites
             {
                 layer_items.erase(item);
                 layer_items.push_front(item);
+                layer->set_dirty();
             }
 
             return sort;
@@ -142,16 +197,60 @@ namespace bn::sorted_sprites
             {
                 layer_items.erase(item);
                 layer_items.push_back(item);
+                layer->set_dirty();
             }
 
             return sort;
         }
 
     private:
-        pool<layer, BN_CFG_SPRITES_MAX_SORT_LAYERS> _layer_pool;
+        using layers_map_type = unordered_map<unsigned, layer*, max_layers_map_items, identity_hasher>;
+        using sorted_layers_type = vector<layer*, max_layers>;
+
+        pool<layer, max_layers> _layer_pool;
         layers_type _layer_ptrs;
+        layers_map_type _layers_map;
+        sorted_layers_type _sorted_layer_ptrs;
         bool _bg_sorting_disabled = false;
 
+        [[nodiscard]] sorted_layers_type::iterator _sorted_layer_position(sort_key sort_key)
+        {
+            return lower_bound(_sorted_layer_ptrs.begin(), _sorted_layer_ptrs.end(), sort_key,
+                    [](const layer* layer, bn::sort_key sort_key) {
+                        return layer->layer_sort_key() < sort_key;
+                    });
+        }
+
+        [[nodiscard]] layer& _create_layer(sort_key sort_key)
+        {
+            BN_BASIC_ASSERT(! _layer_pool.full(), "No more sprite sort layers available");
+
+            layer& pool_layer = _layer_pool.create(sort_key);
+            sorted_layers_type::iterator sorted_layers_it = _sorted_layer_position(sort_key);
+
+            if(sorted_layers_it == _sorted_layer_ptrs.end())
+            {
+                _layer_ptrs.push_back(pool_layer);
+            }
+            else
+            {
+                _layer_ptrs.insert(**sorted_layers_it, pool_layer);
+            }
+
+            _sorted_layer_ptrs.insert(sorted_layers_it, &pool_layer);
+            _layers_map.insert(sort_key.data(), &pool_layer);
+            return pool_layer;
+        }
+
+        void _destroy_layer(layer& layer)
+        {
+            sort_key layer_sort_key = layer.layer_sort_key();
+            _sorted_layer_ptrs.erase(_sorted_layer_position(layer_sort_key));
+            _layers_map.erase(layer_sort_key.data());
+            _layer_ptrs.erase(layer);
+            _layer_pool.destroy(layer);
+        }
+
         [[nodiscard]] layer* _layer_ptr(int diff)
         {
             return reinterpret_cast<layer*>(&_layer_ptrs) + diff;
@@ -312,4 +312,194 @@ void isprite_cached_animate_action::_assign_tiles_list(ivector<sprite_tiles_ptr>
     *_tiles_list_ref = move(tiles_list);
 }
 
+isprite_animate_group& isprite_animate_group::operator=(const isprite_animate_group& other)
+{
+    if(this != &other)
+    {
+        BN_ASSERT(other.sprites().size() <= sprites().max_size(),
+                  "Too many sprites: ", other.sprites().size(), " - ", sprites().max_size());
+        BN_ASSERT(other.graphics_indexes().size() <= graphics_indexes().max_size(),
+                  "Too many graphics indexes: ", other.graphics_indexes().size(), " - ",
+                  graphics_indexes().max_size());
+
+        *_sprites_ref = *other._sprites_ref;
+        *_tiles_item_ref = *other._tiles_item_ref;
+        *_graphics_indexes_ref = *other._graphics_indexes_ref;
+        _assign(other);
+    }
+
+    return *this;
+}
+
+isprite_animate_group& isprite_animate_group::operator=(isprite_animate_group&& other) noexcept
+{
+    if(this != &other)
+    {
+        BN_ASSERT(other.sprites().size() <= sprites().max_size(),
+                  "Too many sprites: ", other.sprites().size(), " - ", sprites().max_size());
+        BN_ASSERT(other.graphics_indexes().size() <= graphics_indexes().max_size(),
+                  "Too many graphics indexes: ", other.graphics_indexes().size(), " - ",
+                  graphics_indexes().max_size());
+
+        *_sprites_ref = move(*other._sprites_ref);
+        *_tiles_item_ref = *other._tiles_item_ref;
+        *_graphics_indexes_ref = *other._graphics_indexes_ref;
+        _assign(other);
+    }
+
+    return *this;
+}
+
+void isprite_animate_group::update()
+{
+    BN_ASSERT(! done(), "Group is done");
+
+    if(_current_wait_updates)
+    {
+        --_current_wait_updates;
+    }
+    else
+    {
+        const ivector<uint16_t>& graphics_indexes = this->graphics_indexes();
+        int current_graphics_indexes_index = _current_graphics_indexes_index;
+        int current_graphics_index = graphics_indexes[current_graphics_indexes_index];
+        _current_wait_updates = _wait_updates;
+
+        if(current_graphics_indexes_index == 0 ||
+                graphics_indexes[current_graphics_indexes_index - 1] != current_graphics_index)
+        {
+            _set_tiles(current_graphics_index);
+        }
+
+        if(_forever && current_graphics_indexes_index == graphics_indexes.size() - 1)
+        {
+            _current_graphics_indexes_index = 0;
+        }
+        else
+        {
+            ++_current_graphics_indexes_index;
+        }
+    }
+}
+
+void isprite_animate_group::add_sprite(const sprite_ptr& sprite)
+{
+    BN_ASSERT(! _sprites_ref->full(), "Too many sprites: ", _sprites_ref->max_size());
+
+    _sprites_ref->push_back(sprite);
+
+    if(const sprite_tiles_ptr* tiles = _tiles.get())
+    {
+        _sprites_ref->back().set_tiles(*tiles);
+    }
+}
+
+void isprite_animate_group::add_sprite(sprite_ptr&& sprite)
+{
+    BN_ASSERT(! _sprites_ref->full(), "Too many sprites: ", _sprites_ref->max_size());
+
+    _sprites_ref->push_back(move(sprite));
+
+    if(const sprite_tiles_ptr* tiles = _tiles.get())
+    {
+        _sprites_ref->back().set_tiles(*tiles);
+    }
+}
+
+bool isprite_animate_group::remove_sprite(const sprite_ptr& sprite)
+{
+    return erase(*_sprites_ref, sprite) > 0;
+}
+
+void isprite_animate_group::set_wait_updates(int wait_updates)
+{
+    BN_ASSERT(wait_updates >= 0, "Invalid wait updates: ", wait_updates);
+    BN_ASSERT(wait_updates <= numeric_limits<decltype(_wait_updates)>::max(),
+              "Too many wait updates: ", wait_updates);
+
+    _wait_updates = uint16_t(wait_updates);
+
+    if(wait_updates < _current_wait_updates)
+    {
+        _current_wait_updates = uint16_t(wait_updates);
+    }
+}
+
+void isprite_animate_group::set_next_change_updates(int next_change_updates)
+{
+    BN_ASSERT(next_change_updates >= 0 && next_change_updates <= _wait_updates,
+              "Invalid next change updates: ", next_change_updates, " - ", _wait_updates);
+
+    _current_wait_updates = next_change_updates;
+}
+
+void isprite_animate_group::set_current_index(int current_index)
+{
+    const ivector<uint16_t>& graphics_indexes = this->graphics_indexes();
+    int num_graphics_indexes = graphics_indexes.size();
+
+    if(_forever)
+    {
+        BN_ASSERT(current_index >= 0 && current_index < num_graphics_indexes,
+                  "Invalid current index: ", current_index, " - ", num_graphics_indexes);
+
+        _current_graphics_indexes_index = current_index;
+    }
+    else
+    {
+        BN_ASSERT(current_index >= 0 && current_index <= num_graphics_indexes,
+                  "Invalid current index: ", current_index, " - ", num_graphics_indexes);
+
+        _current_graphics_indexes_index = current_index;
+
+        if(current_index == num_graphics_indexes)
+        {
+            --current_index;
+        }
+    }
+
+    _set_tiles(graphics_indexes[current_index]);
+}
+
+void isprite_animate_group::_set_refs(
+        ivector<sprite_ptr>& sprites, sprite_tiles_item& tiles_item, ivector<uint16_t>& graphics_indexes)
+{
+    _sprites_ref = &sprites;
+    _tiles_item_ref = &tiles_item;
+    _graphics_indexes_ref = &graphics_indexes;
+}
+
+void isprite_animate_group::_assign(const isprite_animate_group& other)
+{
+    _tiles = other._tiles;
+    _wait_updates = other._wait_updates;
+    _current_graphics_indexes_index = other._current_graphics_indexes_index;
+    _current_wait_updates = other._current_wait_updates;
+    _forever = other._forever;
+}
+
+void isprite_animate_group::_assign_graphics_indexes(const span<const uint16_t>& graphics_indexes)
+{
+    BN_ASSERT(graphics_indexes.size() > 1 && graphics_indexes.size() <= _graphics_indexes_ref->max_size(),
+              "Invalid graphics indexes count: ", graphics_indexes.size(), " - ", _graphics_indexes_ref->max_size());
+
+    for(uint16_t graphics_index : graphics_indexes)
+    {
+        _graphics_indexes_ref->push_back(graphics_index);
+    }
+}
+
+void isprite_animate_group::_set_tiles(int graphics_index)
+{
+    // The tile set is searched for or created only once for all sprites:
+    _tiles = _tiles_item_ref->create_tiles(graphics_index);
+
+    const sprite_tiles_ptr& tiles = *_tiles;
+
+    for(sprite_ptr& sprite : *_sprites_ref)
+    {
+        sprite.set_tiles(tiles);
+    }
+}
+
 }
@@ -8,6 +8,7 @@
 #include "bn_sprite_palette_item.h"
 #include "bn_palettes_bank.h"
 #include "bn_palettes_manager.h"
+#include "bn_sprites_manager.h"
 #include "../hw/include/bn_hw_palettes.h"
 
 namespace bn
@@ -15,6 +16,46 @@ namespace bn
 
 namespace
 {
+    [[nodiscard]] int _create_bpp_4_impl(const span<const color>& colors, uint16_t hash, bool required)
+    {
+        palettes_bank& sprite_palettes_bank = palettes_manager::sprite_palettes_bank();
+        int id = sprite_palettes_bank.create_bpp_4(colors, hash, false);
+
+        // Merging or moving palettes referenced by sprites alone can make room for the new one:
+        if(id < 0 && sprites_manager::repack_palettes())
+        {
+            id = sprite_palettes_bank.create_bpp_4(colors, hash, false);
+        }
+
+        if(id < 0 && required)
+        {
+            id = sprite_palettes_bank.create_bpp_4(colors, hash, true);
+        }
+
+        return id;
+    }
+
+    [[nodiscard]] int _create_bpp_8_impl(const sprite_palette_item& palette_item, bool required)
+    {
+        palettes_bank& sprite_palettes_bank = palettes_manager::sprite_palettes_bank();
+        const span<const color>& colors = palette_item.colors_ref();
+        compression_type compression = palette_item.compression();
+        int id = sprite_palettes_bank.create_bpp_8(colors, compression, false);
+
+        // Moving BPP4 palettes referenced by sprites alone can make room for the new one:
+        if(id < 0 && sprites_manager::repack_palettes())
+        {
+            id = sprite_palettes_bank.create_bpp_8(colors, compression, false);
+        }
+
+        if(id < 0 && required)
+        {
+            id = sprite_palettes_bank.create_bpp_8(colors, compression, true);
+        }
+
+        return id;
+    }
+
     [[nodiscard]] int _create_impl(const sprite_palette_item& palette_item, bool required)
     {
         const span<const color>& colors = palette_item.colors_ref();
@@ -28,7 +69,7 @@ namespace
 
             if(id < 0)
             {
-                id = sprite_palettes_bank.create_bpp_4(colors, hash, required);
+                id = _create_bpp_4_impl(colors, hash, required);
             }
         }
         else
@@ -37,7 +78,7 @@ namespace
 
             if(id < 0)
             {
-                id = sprite_palettes_bank.create_bpp_8(colors, palette_item.compression(), required);
+                id = _create_bpp_8_impl(palette_item, required);
             }
         }
 
@@ -47,16 +88,15 @@ namespace
     [[nodiscard]] int _create_new_impl(const sprite_palette_item& palette_item, bool required)
     {
         const span<const color>& colors = palette_item.colors_ref();
-        palettes_bank& sprite_palettes_bank = palettes_manager::sprite_palettes_bank();
         int id;
 
         if(palette_item.bpp() == bpp_mode::BPP_4)
         {
-            id = sprite_palettes_bank.create_bpp_4(colors, palettes_bank::colors_hash(colors), required);
+            id = _create_bpp_4_impl(colors, palettes_bank::colors_hash(colors), required);
         }
         else
         {
-            id = sprite_palettes_bank.create_bpp_8(colors, palette_item.compression(), required);
+            id = _create_bpp_8_impl(palette_item, required);
         }
 
         return id;
@@ -332,4 +372,24 @@ void sprite_palette_ptr::set_rotate_range(int start, int size)
     palettes_manager::sprite_palettes_bank().set_rotate_range(_id, start, size);
 }
 
+bool sprite_palette_ptr::has_animation() const
+{
+    return palettes_manager::sprite_palettes_bank().has_animation(_id);
+}
+
+bool sprite_palette_ptr::animation_done() const
+{
+    return palettes_manager::sprite_palettes_bank().animation_done(_id);
+}
+
+void sprite_palette_ptr::set_animation(const palette_animation_item& animation_item)
+{
+    palettes_manager::sprite_palettes_bank().set_animation(_id, animation_item);
+}
+
+void sprite_palette_ptr::remove_animation()
+{
+    palettes_manager::sprite_palettes_bank().remove_animation(_id);
+}
+
 }
@@ -7,6 +7,7 @@
 
 #include "bn_palettes_bank.h"
 #include "bn_palettes_manager.h"
+#include "bn_sprites_manager.h"
 
 namespace bn::sprite_palettes
 {
@@ -123,6 +124,11 @@ void reload_custom_effect()
     palettes_manager::sprite_palettes_bank().reload_custom_effect();
 }
 
+bool repack()
+{
+    return sprites_manager::repack_palettes();
+}
+
 void log_status()
 {
     #if BN_CFG_LOG_ENABLED
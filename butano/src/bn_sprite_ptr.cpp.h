@@ -321,7 +321,7 @@ void sprite_ptr::set_tiles(const sprite_tiles_item& tiles_item, int graphics_ind
     {
         sprites_manager::set_tiles(_handle, move(*tiles_ptr));
     }
-    else
+    else if(! sprites_manager::stream_tiles(_handle, tiles_item, graphics_index))
     {
         sprites_manager::remove_tiles(_handle);
         sprites_manager::set_tiles(_handle, sprite_tiles_ptr::create(tiles_item, graphics_index));
@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_sprite_text.h"
+
+#include "bn_sprite_text_generator.h"
+
+namespace bn
+{
+
+void isprite_text::set_text(const string_view& text)
+{
+    istring& current_text = *_text_ref;
+
+    BN_ASSERT(text.size() <= current_text.max_size(),
+              "Text is too long: ", text.size(), " - ", current_text.max_size());
+
+    if(! _generator->repaint(current_text, text, *_sprites_ref))
+    {
+        _sprites_ref->clear();
+        _generator->generate(_position, text, *_sprites_ref);
+    }
+
+    current_text = text;
+}
+
+void isprite_text::regenerate()
+{
+    _sprites_ref->clear();
+    _generator->generate(_position, *_text_ref, *_sprites_ref);
+}
+
+void isprite_text::clear()
+{
+    _sprites_ref->clear();
+    _text_ref->clear();
+}
+
+}
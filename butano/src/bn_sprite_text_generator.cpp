@@ -1029,6 +1029,188 @@ namespace
         return true;
     }
 
+    class repainter
+    {
+
+    public:
+        repainter(const sprite_text_generator& generator, bool one_sprite_per_character) :
+            _generator(generator),
+            _one_sprite_per_character(one_sprite_per_character)
+        {
+            if(! one_sprite_per_character)
+            {
+                _tiles_per_character = generator.font().item().shape_size().width() / 8;
+                _max_characters_per_sprite = _max_columns_per_sprite / (_tiles_per_character * 8);
+            }
+        }
+
+        // Returns the number of sprites used by both lines of text, or -1 if their layouts are different:
+        [[nodiscard]] int sprites_count(const string_view& old_text, const string_view& new_text)
+        {
+            return _walk(old_text, new_text, nullptr);
+        }
+
+        void repaint(const string_view& old_text, const string_view& new_text,
+                     ivector<sprite_ptr>& output_sprites)
+        {
+            [[maybe_unused]] int sprites_count = _walk(old_text, new_text, &output_sprites);
+            _commit_staged_tiles();
+        }
+
+    private:
+        static constexpr int _max_columns_per_sprite = 32;
+        static constexpr int _half_tiles = _max_columns_per_sprite / 8;
+
+        const sprite_text_generator& _generator;
+        optional<sprite_tiles_ptr> _staged_tiles;
+        sprite_ptr* _staged_sprite = nullptr;
+        tile* _staged_tiles_vram = nullptr;
+        int _tiles_per_character = 0;
+        int _max_characters_per_sprite = 1;
+        bool _one_sprite_per_character;
+
+        // Follows the same layout rules as the painters:
+        int _walk(const string_view& old_text, const string_view& new_text, ivector<sprite_ptr>* output_sprites)
+        {
+            const utf8_characters_map_ref& utf8_characters_map = _generator.font().utf8_characters_ref();
+            const char* old_text_data = old_text.data();
+            const char* new_text_data = new_text.data();
+            int old_text_index = 0;
+            int new_text_index = 0;
+            int old_text_size = old_text.size();
+            int new_text_size = new_text.size();
+            int max_characters_per_sprite = _max_characters_per_sprite;
+            int sprite_index = -1;
+            int sprite_character_index = max_characters_per_sprite;
+
+            while(old_text_index < old_text_size && new_text_index < new_text_size)
+            {
+                char old_character = old_text_data[old_text_index];
+                char new_character = new_text_data[new_text_index];
+
+                if(old_character == ' ' || old_character == '\t')
+                {
+                    if(new_character != old_character)
+                    {
+                        return -1;
+                    }
+
+                    if(old_character == '\t')
+                    {
+                        sprite_character_index = max_characters_per_sprite;
+                    }
+                    else if(sprite_character_index < max_characters_per_sprite)
+                    {
+                        ++sprite_character_index;
+                    }
+
+                    ++old_text_index;
+                    ++new_text_index;
+                }
+                else if(old_character >= '!' && new_character >= '!')
+                {
+                    int old_graphics_index = _graphics_index(
+                                old_character, utf8_characters_map, old_text_data, old_text_index);
+                    int new_graphics_index = _graphics_index(
+                                new_character, utf8_characters_map, new_text_data, new_text_index);
+
+                    if(sprite_character_index == max_characters_per_sprite)
+                    {
+                        ++sprite_index;
+                        sprite_character_index = 0;
+                    }
+
+                    if(output_sprites && old_graphics_index != new_graphics_index)
+                    {
+                        _paint_character(new_graphics_index, sprite_character_index,
+                                         (*output_sprites)[sprite_index]);
+                    }
+
+                    ++sprite_character_index;
+                }
+                else
+                {
+                    return -1;
+                }
+            }
+
+            if(old_text_index < old_text_size || new_text_index < new_text_size)
+            {
+                return -1;
+            }
+
+            return sprite_index + 1;
+        }
+
+        void _paint_character(int graphics_index, int sprite_character_index, sprite_ptr& sprite)
+        {
+            const sprite_tiles_item& tiles_item = _generator.font().item().tiles_item();
+
+            if(_one_sprite_per_character)
+            {
+                // Characters tiles are shared by all sprites which show them:
+                sprite.set_tiles(tiles_item, graphics_index);
+                return;
+            }
+
+            if(_staged_sprite != &sprite)
+            {
+                _commit_staged_tiles();
+                _stage_tiles(sprite);
+            }
+
+            tile* tiles_vram = _staged_tiles_vram;
+            const tile* source_tiles_data = tiles_item.graphics_tiles_ref(graphics_index).data();
+            int tiles_per_character = _tiles_per_character;
+            tile* up_tiles_vram_ptr = tiles_vram + (sprite_character_index * tiles_per_character);
+
+            if(_generator.font().item().shape_size().height() == 8)
+            {
+                hw::sprite_tiles::copy_tiles(source_tiles_data, tiles_per_character, up_tiles_vram_ptr);
+            }
+            else
+            {
+                hw::sprite_tiles::copy_tiles(source_tiles_data, tiles_per_character, up_tiles_vram_ptr);
+                hw::sprite_tiles::copy_tiles(source_tiles_data + tiles_per_character, tiles_per_character,
+                                             up_tiles_vram_ptr + _half_tiles);
+            }
+        }
+
+        // Characters are painted on a copy of the sprite tiles,
+        // so the tiles shown on screen are not modified until the next V-Blank:
+        void _stage_tiles(sprite_ptr& sprite)
+        {
+            sprite_tiles_ptr tiles = sprite.tiles();
+            tile* tiles_vram = tiles.vram()->data();
+            int tiles_count = tiles.tiles_count();
+            _staged_sprite = &sprite;
+            _staged_tiles = sprite_tiles_ptr::allocate_optional(tiles_count, bpp_mode::BPP_4);
+
+            if(sprite_tiles_ptr* staged_tiles = _staged_tiles.get())
+            {
+                _staged_tiles_vram = staged_tiles->vram()->data();
+                hw::sprite_tiles::copy_tiles(tiles_vram, tiles_count, _staged_tiles_vram);
+            }
+            else
+            {
+                // Not enough VRAM for the copy, so the shown tiles are painted:
+                _staged_tiles_vram = tiles_vram;
+            }
+        }
+
+        void _commit_staged_tiles()
+        {
+            if(sprite_tiles_ptr* staged_tiles = _staged_tiles.get())
+            {
+                _staged_sprite->set_tiles(move(*staged_tiles));
+                _staged_tiles.reset();
+            }
+
+            _staged_sprite = nullptr;
+        }
+    };
+
+
     template<bool allow_failure>
     bool _generate(const sprite_text_generator& generator, const fixed_point& position, const string_view& text,
                    const utf8_characters_map_ref& utf8_characters_map, int max_character_width, int character_height,
@@ -1313,6 +1495,32 @@ bool sprite_text_generator::generate_top_left_optional(
     return success;
 }
 
+bool sprite_text_generator::repaint(const string_view& old_text, const string_view& new_text,
+                                    ivector<sprite_ptr>& output_sprites) const
+{
+    if(old_text == new_text)
+    {
+        return true;
+    }
+
+    // The layout of variable width text depends on the width of each character:
+    if(! _font.character_widths_ref().empty())
+    {
+        return false;
+    }
+
+    bool one_sprite_per_character = _one_sprite_per_character || _font_one_sprite_per_character;
+    repainter text_repainter(*this, one_sprite_per_character);
+
+    if(text_repainter.sprites_count(old_text, new_text) != output_sprites.size())
+    {
+        return false;
+    }
+
+    text_repainter.repaint(old_text, new_text, output_sprites);
+    return true;
+}
+
 void sprite_text_generator::_init()
 {
     const sprite_shape_size& shape_size = _font.item().shape_size();
@@ -5,7 +5,9 @@
 
 #include "bn_sprite_tiles.h"
 
+#include "bn_sprites_manager.h"
 #include "bn_sprite_tiles_manager.h"
+#include "../hw/include/bn_hw_sprite_tiles_constants.h"
 
 namespace bn::sprite_tiles
 {
@@ -30,6 +32,31 @@ int available_items_count()
     return sprite_tiles_manager::available_items_count();
 }
 
+int stream_max_bytes_per_frame()
+{
+    return sprite_tiles_manager::stream_max_bytes_per_frame();
+}
+
+void set_stream_max_bytes_per_frame(int max_bytes_per_frame)
+{
+    sprite_tiles_manager::set_stream_max_bytes_per_frame(max_bytes_per_frame);
+}
+
+int compaction_max_tiles_per_frame()
+{
+    return sprite_tiles_manager::compaction_max_tiles_per_frame();
+}
+
+void set_compaction_max_tiles_per_frame(int max_tiles_per_frame)
+{
+    sprite_tiles_manager::set_compaction_max_tiles_per_frame(max_tiles_per_frame);
+}
+
+bool compact()
+{
+    return sprites_manager::compact_tiles(hw::sprite_tiles::tiles_count());
+}
+
 void log_status()
 {
     #if BN_CFG_LOG_ENABLED
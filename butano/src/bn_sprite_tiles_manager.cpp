@@ -9,6 +9,7 @@
 #include "bn_string_view.h"
 #include "bn_unordered_map.h"
 #include "bn_config_sprite_tiles.h"
+#include "../hw/include/bn_hw_decompress.h"
 #include "../hw/include/bn_hw_sprite_tiles.h"
 #include "../hw/include/bn_hw_sprite_tiles_constants.h"
 
@@ -84,7 +85,7 @@ namespace
 
     private:
         uint8_t _status: 2 = uint8_t(status_type::FREE);
-        uint8_t _compression: 2 = uint8_t(compression_type::NONE);
+        uint8_t _compression: 3 = uint8_t(compression_type::NONE);
 
     public:
         bool commit: 1 = false;
@@ -146,6 +147,11 @@ namespace
                 return _list->_items[_index];
             }
 
+            [[nodiscard]] friend bool operator==(const iterator& a, const iterator& b)
+            {
+                return a._index == b._index;
+            }
+
             [[nodiscard]] friend bool operator!=(const iterator& a, const iterator& b)
             {
                 return a._index != b._index;
@@ -281,6 +287,10 @@ namespace
         vector<uint16_t, max_items> to_remove_items;
         vector<uint16_t, max_items> to_commit_uncompressed_items;
         vector<uint16_t, max_items> to_commit_compressed_items;
+        hw::decompress::stream stream;
+        int stream_max_bytes_per_frame = 0;
+        int stream_item_id = -1;
+        int compaction_max_tiles_per_frame = 0;
         uint16_t free_tiles_count = 0;
         uint16_t to_remove_tiles_count = 0;
         bool delay_commit = false;
@@ -350,6 +360,29 @@ namespace
     #endif
 
 
+    #if BN_CFG_LOG_ENABLED
+        void _log_fragmentation()
+        {
+            static_data& data = data_ref();
+            int free_tiles_count = data.free_tiles_count;
+            int largest_free_tiles_count = 0;
+
+            if(! data.free_items.empty())
+            {
+                largest_free_tiles_count = data.items.item(data.free_items.back()).tiles_count;
+            }
+
+            // Percentage of free tiles which can't be allocated in a single block:
+            int fragmentation = free_tiles_count ?
+                        ((free_tiles_count - largest_free_tiles_count) * 100) / free_tiles_count : 0;
+
+            BN_LOG("free_blocks_count: ", data.free_items.size());
+            BN_LOG("largest_free_block_tiles_count: ", largest_free_tiles_count);
+            BN_LOG("fragmentation: ", fragmentation, '%');
+        }
+    #endif
+
+
     #if BN_CFG_SPRITE_TILES_LOG_ENABLED
         void _log_status()
         {
@@ -417,6 +450,7 @@ namespace
             BN_LOG("free_tiles_count: ", data.free_tiles_count);
             BN_LOG("to_remove_tiles_count: ", data.to_remove_tiles_count);
             BN_LOG("delay_commit: ", (data.delay_commit ? "true" : "false"));
+            _log_fragmentation();
         }
 
         #define BN_SPRITE_TILES_LOG BN_LOG
@@ -507,11 +541,33 @@ namespace
         }
     }
 
+    [[nodiscard]] bool _streamed(compression_type compression)
+    {
+        if(! data_ref().stream_max_bytes_per_frame)
+        {
+            return false;
+        }
+
+        return compression == compression_type::LZ77 || compression == compression_type::RUN_LENGTH ||
+                compression == compression_type::HUFFMAN;
+    }
+
+    void _cancel_stream(int id)
+    {
+        static_data& data = data_ref();
+
+        if(data.stream_item_id == id)
+        {
+            data.stream_item_id = -1;
+        }
+    }
+
     void _erase_to_commit_item(int id, item_type& item)
     {
         if(item.commit)
         {
             item.commit = false;
+            _cancel_stream(id);
 
             static_data& data = data_ref();
             vector<uint16_t, max_items>& to_commit_items =
@@ -620,6 +676,14 @@ namespace
             hw::decompress::huff(source_tiles_ptr, hw::sprite_tiles::tile_vram(index));
             break;
 
+        case compression_type::LZ4:
+            hw::decompress::lz4(source_tiles_ptr, hw::sprite_tiles::tile_vram(index));
+            break;
+
+        case compression_type::RANS:
+            hw::decompress::rans(source_tiles_ptr, hw::sprite_tiles::tile_vram(index));
+            break;
+
         default:
             BN_ERROR("Unknown compression type: ", int(compression));
             break;
@@ -676,7 +740,7 @@ namespace
 
         if(tiles_data)
         {
-            if(delay_commit) [[unlikely]]
+            if(delay_commit || _streamed(compression))
             {
                 _insert_to_commit_item(id, *item);
             }
@@ -778,6 +842,14 @@ namespace
 
         return -1;
     }
+
+    [[nodiscard]] bool _movable(int id, const item_type& item, const uint16_t* sprites_usages)
+    {
+        // Uncompressed tiles can be reloaded from their source data in the next commit.
+        // Tiles referenced outside sprites can't be moved, since their tile index could be stored anywhere:
+        return item.status() == status_type::USED && item.data && item.compression() == compression_type::NONE &&
+                item.usages == sprites_usages[id];
+    }
 }
 
 void init()
@@ -841,6 +913,7 @@ int available_items_count()
 
             BN_LOG("free_tiles_count: ", data.free_tiles_count);
             BN_LOG("to_remove_tiles_count: ", data.to_remove_tiles_count);
+            _log_fragmentation();
         #endif
     }
 #endif
@@ -1095,6 +1168,11 @@ void decrease_usages(int id)
     BN_SPRITE_TILES_LOG_STATUS();
 }
 
+int usages(int id)
+{
+    return int(data_ref().items.item(id).usages);
+}
+
 int start_tile(int id)
 {
     return int(data_ref().items.item(id).start_tile);
@@ -1158,6 +1236,7 @@ void set_tiles_ref(int id, const span<const tile>& tiles_ref, compression_type c
         }
 
         item.data = new_tiles_data;
+        _cancel_stream(id);
         _insert_to_commit_item(id, item);
 
         BN_SPRITE_TILES_LOG_STATUS();
@@ -1170,6 +1249,7 @@ void set_tiles_ref(int id, const span<const tile>& tiles_ref, compression_type c
         }
 
         item.set_compression(compression);
+        _cancel_stream(id);
         _insert_to_commit_item(id, item);
 
         BN_SPRITE_TILES_LOG_STATUS();
@@ -1184,11 +1264,31 @@ void reload_tiles_ref(int id)
 
     BN_BASIC_ASSERT(item.data, "Item has no data");
 
+    _cancel_stream(id);
     _insert_to_commit_item(id, item);
 
     BN_SPRITE_TILES_LOG_STATUS();
 }
 
+bool must_commit(int id)
+{
+    return data_ref().items.item(id).commit;
+}
+
+int stream_max_bytes_per_frame()
+{
+    return data_ref().stream_max_bytes_per_frame;
+}
+
+void set_stream_max_bytes_per_frame(int max_bytes_per_frame)
+{
+    BN_ASSERT(max_bytes_per_frame >= 0, "Invalid max bytes per frame: ", max_bytes_per_frame);
+
+    static_data& data = data_ref();
+    data.stream_max_bytes_per_frame = max_bytes_per_frame;
+    data.stream_item_id = -1;
+}
+
 optional<span<tile>> vram(int id)
 {
     const item_type& item = data_ref().items.item(id);
@@ -1202,6 +1302,121 @@ optional<span<tile>> vram(int id)
     return result;
 }
 
+int compaction_max_tiles_per_frame()
+{
+    return data_ref().compaction_max_tiles_per_frame;
+}
+
+void set_compaction_max_tiles_per_frame(int max_tiles_per_frame)
+{
+    BN_ASSERT(max_tiles_per_frame >= 0, "Invalid max tiles per frame: ", max_tiles_per_frame);
+
+    data_ref().compaction_max_tiles_per_frame = max_tiles_per_frame;
+}
+
+bool fragmented()
+{
+    const static_data& data = data_ref();
+    return data.free_items.size() + data.to_remove_items.size() > 1;
+}
+
+bool compact(const uint16_t* sprites_usages, int max_tiles_count)
+{
+    static_data& data = data_ref();
+
+    if(data.to_remove_tiles_count)
+    {
+        update();
+        data.delay_commit = true;
+    }
+
+    if(data.free_items.size() <= 1)
+    {
+        return false;
+    }
+
+    BN_SPRITE_TILES_LOG("sprite_tiles_manager - COMPACT: ", max_tiles_count);
+
+    auto iterator = data.items.begin();
+    auto end = data.items.end();
+    int moved_tiles_count = 0;
+    bool compacted = false;
+
+    while(iterator != end)
+    {
+        auto next_iterator = iterator;
+        ++next_iterator;
+
+        if(next_iterator == end)
+        {
+            break;
+        }
+
+        item_type& item = *iterator;
+        item_type& next_item = *next_iterator;
+        int next_id = next_iterator.id();
+
+        if(item.status() != status_type::FREE || ! _movable(next_id, next_item, sprites_usages))
+        {
+            iterator = next_iterator;
+            continue;
+        }
+
+        int next_tiles_count = next_item.tiles_count;
+        moved_tiles_count += next_tiles_count;
+
+        if(moved_tiles_count > max_tiles_count)
+        {
+            break;
+        }
+
+        // Move the used item to the start of the free one:
+        int free_id = iterator.id();
+        int free_tiles_count = item.tiles_count;
+        next_item.start_tile = item.start_tile;
+        _erase_free_item(free_id);
+        data.items.erase(free_id);
+        _insert_to_commit_item(next_id, next_item);
+
+        // Move the free item after the used one, merging it with the next free item if possible:
+        auto after_iterator = next_iterator;
+        ++after_iterator;
+
+        int free_start_tile = int(next_item.start_tile) + next_tiles_count;
+
+        if(after_iterator != end && (*after_iterator).status() == status_type::FREE)
+        {
+            int after_id = after_iterator.id();
+            item_type& after_item = *after_iterator;
+            _erase_free_item(after_id);
+            after_item.start_tile = unsigned(free_start_tile);
+            after_item.tiles_count += unsigned(free_tiles_count);
+            _insert_free_item(after_id);
+            iterator = after_iterator;
+        }
+        else
+        {
+            item_type new_item;
+            new_item.start_tile = unsigned(free_start_tile);
+            new_item.tiles_count = unsigned(free_tiles_count);
+            iterator = data.items.insert(after_iterator.id(), new_item);
+            _insert_free_item(iterator.id());
+        }
+
+        compacted = true;
+    }
+
+    if(compacted)
+    {
+        // Moved tiles are still displayed in their previous location until the next commit:
+        data.delay_commit = true;
+
+        BN_SPRITE_TILES_LOG_STATUS();
+    }
+
+    return compacted;
+}
+
 void update()
 {
     static_data& data = data_ref();
@@ -1276,6 +1491,12 @@ void update()
     data.delay_commit = false;
 }
 
+bool must_commit()
+{
+    const static_data& data = data_ref();
+    return ! data.to_commit_uncompressed_items.empty() || ! data.to_commit_compressed_items.empty();
+}
+
 void commit_uncompressed(bool use_dma)
 {
     static_data& data = data_ref();
@@ -1313,7 +1534,43 @@ void commit_compressed()
 {
     static_data& data = data_ref();
 
-    if(! data.to_commit_compressed_items.empty())
+    if(data.stream_max_bytes_per_frame)
+    {
+        vector<uint16_t, max_items>& to_commit_items = data.to_commit_compressed_items;
+        hw::decompress::stream& stream = data.stream;
+        int remaining_bytes = data.stream_max_bytes_per_frame;
+
+        while(remaining_bytes > 0 && ! to_commit_items.empty())
+        {
+            int item_index = to_commit_items.front();
+            item_type& item = data.items.item(item_index);
+
+            if(! _streamed(item.compression()))
+            {
+                _hw_commit(item.data, item.compression(), int(item.start_tile), int(item.tiles_count));
+                item.commit = false;
+                to_commit_items.erase(to_commit_items.begin());
+            }
+            else
+            {
+                if(data.stream_item_id != item_index)
+                {
+                    stream.init(item.data, hw::sprite_tiles::tile_vram(int(item.start_tile)));
+                    data.stream_item_id = item_index;
+                }
+
+                remaining_bytes -= stream.decompress(remaining_bytes);
+
+                if(stream.done())
+                {
+                    item.commit = false;
+                    data.stream_item_id = -1;
+                    to_commit_items.erase(to_commit_items.begin());
+                }
+            }
+        }
+    }
+    else if(! data.to_commit_compressed_items.empty())
     {
         BN_SPRITE_TILES_LOG("sprite_tiles_manager - COMMIT COMPRESSED");
 
@@ -9,6 +9,7 @@
 #include "bn_span.h"
 #include "bn_optional.h"
 #include "bn_config_log.h"
+#include "bn_config_sprite_tiles.h"
 
 namespace bn
 {
@@ -19,6 +20,11 @@ namespace bn
 
 namespace bn::sprite_tiles_manager
 {
+    [[nodiscard]] constexpr int max_ids()
+    {
+        return BN_CFG_SPRITE_TILES_MAX_ITEMS + 1;
+    }
+
     void init();
 
     [[nodiscard]] int used_tiles_count();
@@ -49,6 +55,8 @@ namespace bn::sprite_tiles_manager
 
     void decrease_usages(int id);
 
+    [[nodiscard]] int usages(int id);
+
     [[nodiscard]] int start_tile(int id);
 
     [[nodiscard]] int tiles_count(int id);
@@ -61,10 +69,26 @@ namespace bn::sprite_tiles_manager
 
     void reload_tiles_ref(int id);
 
+    [[nodiscard]] bool must_commit(int id);
+
+    [[nodiscard]] int stream_max_bytes_per_frame();
+
+    void set_stream_max_bytes_per_frame(int max_bytes_per_frame);
+
     [[nodiscard]] optional<span<tile>> vram(int id);
 
+    [[nodiscard]] int compaction_max_tiles_per_frame();
+
+    void set_compaction_max_tiles_per_frame(int max_tiles_per_frame);
+
+    [[nodiscard]] bool fragmented();
+
+    [[nodiscard]] bool compact(const uint16_t* sprites_usages, int max_tiles_count);
+
     void update();
 
+    [[nodiscard]] bool must_commit();
+
     void commit_uncompressed(bool use_dma);
 
     void commit_compressed();
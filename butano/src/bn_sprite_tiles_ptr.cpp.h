@@ -6,11 +6,34 @@
 #include "bn_sprite_tiles_ptr.h"
 
 #include "bn_sprite_tiles_item.h"
+#include "bn_sprites_manager.h"
 #include "bn_sprite_tiles_manager.h"
+#include "../hw/include/bn_hw_sprite_tiles_constants.h"
 
 namespace bn
 {
 
+namespace
+{
+    [[nodiscard]] int _create_impl(const span<const tile>& tiles_ref, compression_type compression, bool required)
+    {
+        int handle = sprite_tiles_manager::create_optional(tiles_ref, compression);
+
+        // Moving tiles referenced by sprites alone can make room for the new ones:
+        if(handle < 0 && sprites_manager::compact_tiles(hw::sprite_tiles::tiles_count()))
+        {
+            handle = sprite_tiles_manager::create_optional(tiles_ref, compression);
+        }
+
+        if(handle < 0 && required)
+        {
+            handle = sprite_tiles_manager::create(tiles_ref, compression);
+        }
+
+        return handle;
+    }
+}
+
 optional<sprite_tiles_ptr> sprite_tiles_ptr::find(const sprite_tiles_item& tiles_item)
 {
     int handle = sprite_tiles_manager::find(tiles_item.graphics_tiles_ref(), tiles_item.compression());
@@ -40,14 +63,13 @@ optional<sprite_tiles_ptr> sprite_tiles_ptr::find(const sprite_tiles_item& tiles
 
 sprite_tiles_ptr sprite_tiles_ptr::create(const sprite_tiles_item& tiles_item)
 {
-    int handle = sprite_tiles_manager::create(tiles_item.graphics_tiles_ref(), tiles_item.compression());
+    int handle = _create_impl(tiles_item.graphics_tiles_ref(), tiles_item.compression(), true);
     return sprite_tiles_ptr(handle);
 }
 
 sprite_tiles_ptr sprite_tiles_ptr::create(const sprite_tiles_item& tiles_item, int graphics_index)
 {
-    int handle = sprite_tiles_manager::create(
-            tiles_item.graphics_tiles_ref(graphics_index), tiles_item.compression());
+    int handle = _create_impl(tiles_item.graphics_tiles_ref(graphics_index), tiles_item.compression(), true);
     return sprite_tiles_ptr(handle);
 }
 
@@ -58,7 +80,7 @@ sprite_tiles_ptr sprite_tiles_ptr::allocate(int tiles_count, bpp_mode bpp)
 
 optional<sprite_tiles_ptr> sprite_tiles_ptr::create_optional(const sprite_tiles_item& tiles_item)
 {
-    int handle = sprite_tiles_manager::create_optional(tiles_item.graphics_tiles_ref(), tiles_item.compression());
+    int handle = _create_impl(tiles_item.graphics_tiles_ref(), tiles_item.compression(), false);
     optional<sprite_tiles_ptr> result;
 
     if(handle >= 0)
@@ -72,8 +94,7 @@ optional<sprite_tiles_ptr> sprite_tiles_ptr::create_optional(const sprite_tiles_
 optional<sprite_tiles_ptr> sprite_tiles_ptr::create_optional(
         const sprite_tiles_item& tiles_item, int graphics_index)
 {
-    int handle = sprite_tiles_manager::create_optional(
-            tiles_item.graphics_tiles_ref(graphics_index), tiles_item.compression());
+    int handle = _create_impl(tiles_item.graphics_tiles_ref(graphics_index), tiles_item.compression(), false);
     optional<sprite_tiles_ptr> result;
 
     if(handle >= 0)
@@ -181,4 +202,9 @@ optional<span<tile>> sprite_tiles_ptr::vram()
     return sprite_tiles_manager::vram(_handle);
 }
 
+bool sprite_tiles_ptr::loaded() const
+{
+    return ! sprite_tiles_manager::must_commit(_handle);
+}
+
 }
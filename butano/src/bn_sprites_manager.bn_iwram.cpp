@@ -15,14 +15,19 @@ void _check_items_on_screen(intrusive_list<sorted_sprites::layer>& layers)
     hot::check_items_on_screen(layers);
 }
 
-int _rebuild_handles_impl(int reserved_handles_count, void* hw_handles, intrusive_list<sorted_sprites::layer>& layers)
+int _rebuild_handles_impl(int reserved_handles_count, void* hw_handles, intrusive_list<sorted_sprites::layer>& layers,
+                          int& first_changed_index, int& last_changed_index, int& changed_handles_count)
 {
-    return hot::rebuild_handles(reserved_handles_count, hw_handles, layers);
+    return hot::rebuild_handles(reserved_handles_count, hw_handles, layers, first_changed_index, last_changed_index,
+                                changed_handles_count);
 }
 
-bool _update_cameras_impl(intrusive_list<sorted_sprites::layer>& layers)
+bool _update_cameras_impl(intrusive_list<intrusive_list_node_type>* culling_buckets, unsigned culling_buckets_mask,
+                          const cameras_manager::culling_cells* cameras_culling_cells, int& evaluated_items_count,
+                          int& culled_items_count)
 {
-    return hot::update_cameras(layers);
+    return hot::update_cameras(culling_buckets, culling_buckets_mask, cameras_culling_cells, evaluated_items_count,
+                               culled_items_count);
 }
 
 }
@@ -9,6 +9,12 @@
 #include "bn_sprite_first_attributes.h"
 #include "bn_sprite_regular_second_attributes.h"
 #include "bn_sorted_sprites.h"
+#include "bn_palettes_bank.h"
+#include "bn_cameras_manager.h"
+#include "bn_palettes_manager.h"
+#include "bn_profiler_engine.h"
+#include "bn_sprite_tiles_item.h"
+#include "bn_sprite_tiles_manager.h"
 #include "../hw/include/bn_hw_sprite_affine_mats_constants.h"
 
 #if ! BN_CFG_SPRITES_USE_IWRAM
@@ -31,6 +37,9 @@ namespace
 
     using item_type = sprites_manager_item;
     using sorted_items_type = vector<item_type*, BN_CFG_SPRITES_MAX_ITEMS>;
+    using culling_bucket_type = intrusive_list<sprite_culling_node_type>;
+
+    constexpr int unculled_bucket = cameras_manager::sprites_culling_buckets_count;
 
     class static_data
     {
@@ -39,6 +48,7 @@ namespace
         pool<item_type, BN_CFG_SPRITES_MAX_ITEMS> items_pool;
         hw::sprites::handle_type handles[hw::sprites::count()];
         sorted_sprites::sorter sorter;
+        culling_bucket_type culling_buckets[unculled_bucket + 1];
         int reserved_handles_count = 0;
         int first_index_to_commit = 0;
         int last_index_to_commit = hw::sprites::count() - 1;
@@ -55,7 +65,7 @@ namespace
         return *reinterpret_cast<static_data*>(data_buffer);
     }
 
-    void _always_update_indexes_to_commit(const item_type& item)
+    void _update_indexes_to_commit(const item_type& item)
     {
         int handles_index = item.handles_index;
 
@@ -76,14 +86,51 @@ namespace
         }
     }
 
-    inline void _update_indexes_to_commit(const item_type& item)
+    [[nodiscard]] int _culling_bucket(const item_type& item)
+    {
+        if(const camera_ptr* camera = item.camera.get())
+        {
+            if(camera->sprites_culling_enabled())
+            {
+                int cell_x = item.position.x().right_shift_integer() >> cameras_manager::sprites_culling_cell_shift;
+                int cell_y = item.position.y().right_shift_integer() >> cameras_manager::sprites_culling_cell_shift;
+                return cameras_manager::sprites_culling_bucket(cell_x, cell_y);
+            }
+
+            return unculled_bucket;
+        }
+
+        return item_type::no_culling_bucket;
+    }
+
+    void _update_culling_bucket(item_type& item)
     {
-        if(! data_ref().rebuild_handles)
+        int old_bucket = item.culling_bucket;
+        int new_bucket = _culling_bucket(item);
+
+        if(old_bucket != new_bucket)
         {
-            _always_update_indexes_to_commit(item);
+            static_data& data = data_ref();
+
+            if(old_bucket != item_type::no_culling_bucket)
+            {
+                data.culling_buckets[old_bucket].erase(item.culling_node);
+            }
+
+            if(new_bucket != item_type::no_culling_bucket)
+            {
+                data.culling_buckets[new_bucket].push_back(item.culling_node);
+            }
+
+            item.culling_bucket = uint8_t(new_bucket);
         }
     }
 
+    [[nodiscard]] bool _culled(const item_type& item)
+    {
+        return item.culling_bucket < unculled_bucket;
+    }
+
     void _update_item_dimensions(item_type& item)
     {
         item.update_half_dimensions();
@@ -201,20 +248,38 @@ namespace
                 }
             }
 
+            int first_changed_index = hw::sprites::count();
+            int last_changed_index = -1;
+            int changed_handles_count = 0;
+
             #if BN_CFG_SPRITES_USE_IWRAM
-                int visible_items_count = _rebuild_handles_impl(reserved_count, handles, data.sorter.layers());
+                int visible_items_count = _rebuild_handles_impl(
+                            reserved_count, handles, data.sorter.layers(), first_changed_index, last_changed_index,
+                            changed_handles_count);
             #else
-                int visible_items_count = hot::rebuild_handles(reserved_count, handles, data.sorter.layers());
+                int visible_items_count = hot::rebuild_handles(
+                            reserved_count, handles, data.sorter.layers(), first_changed_index, last_changed_index,
+                            changed_handles_count);
             #endif
 
             BN_BASIC_ASSERT(visible_items_count >= 0, "Too many on screen sprites");
 
-            int last_visible_items_count = data.last_visible_items_count;
+            BN_PROFILER_ENGINE_DETAILED_COUNT("eng_spr_handles_rebuilt", changed_handles_count);
+            BN_PROFILER_ENGINE_DETAILED_COUNT("eng_spr_handles_skipped",
+                                              visible_items_count - reserved_count - changed_handles_count);
+
+            int last_visible_items_count = min(data.last_visible_items_count, hw::sprites::count());
             data.last_visible_items_count = visible_items_count;
 
-            for(int index = visible_items_count; index < last_visible_items_count; ++index)
+            if(visible_items_count < last_visible_items_count)
             {
-                hw::sprites::hide_and_destroy(handles[index]);
+                for(int index = visible_items_count; index < last_visible_items_count; ++index)
+                {
+                    hw::sprites::hide_and_destroy(handles[index]);
+                }
+
+                first_changed_index = min(first_changed_index, visible_items_count);
+                last_changed_index = last_visible_items_count - 1;
             }
 
             if(reload_all_handles) [[unlikely]]
@@ -222,29 +287,10 @@ namespace
                 data.first_index_to_commit = 0;
                 data.last_index_to_commit = hw::sprites::count() - 1;
             }
-            else
+            else if(first_changed_index <= last_changed_index)
             {
-                int to_commit_items_count;
-
-                if(visible_items_count < last_visible_items_count)
-                {
-                    to_commit_items_count = min(last_visible_items_count, hw::sprites::count() - reserved_count);
-                }
-                else
-                {
-                    to_commit_items_count = visible_items_count;
-                }
-
-                if(to_commit_items_count)
-                {
-                    data.first_index_to_commit = reserved_count;
-                    data.last_index_to_commit = reserved_count + to_commit_items_count - 1;
-                }
-                else
-                {
-                    data.first_index_to_commit = hw::sprites::count();
-                    data.last_index_to_commit = 0;
-                }
+                data.first_index_to_commit = min(data.first_index_to_commit, first_changed_index);
+                data.last_index_to_commit = max(data.last_index_to_commit, last_changed_index);
             }
         }
     }
@@ -311,6 +357,7 @@ id_type create(sprite_builder&& builder)
 
     item_type& new_item = data.items_pool.create(move(builder));
     data.sorter.insert(new_item);
+    _update_culling_bucket(new_item);
 
     if(new_item.visible)
     {
@@ -348,6 +395,7 @@ id_type create_optional(sprite_builder&& builder)
 
     item_type& new_item = data.items_pool.create(move(builder), move(*tiles_ptr), move(*palette_ptr));
     data.sorter.insert(new_item);
+    _update_culling_bucket(new_item);
 
     if(new_item.visible)
     {
@@ -374,6 +422,11 @@ void decrease_usages(id_type id)
         static_data& data = data_ref();
         data.sorter.erase(*item);
 
+        if(int culling_bucket = item->culling_bucket; culling_bucket != item_type::no_culling_bucket)
+        {
+            data.culling_buckets[culling_bucket].erase(item->culling_node);
+        }
+
         if(const sprite_affine_mat_ptr* item_affine_mat = item->affine_mat.get())
         {
             sprite_affine_mats_manager::dettach_sprite(item_affine_mat->id(), item->affine_mat_attach_node);
@@ -515,6 +568,34 @@ void remove_tiles(id_type id)
     item->tiles.reset();
 }
 
+bool stream_tiles(id_type id, const sprite_tiles_item& tiles_item, int graphics_index)
+{
+    auto item = static_cast<item_type*>(id);
+
+    if(! item->tiles)
+    {
+        return false;
+    }
+
+    // Tiles referenced by this sprite alone are overwritten in the next commit, keeping their VRAM slot:
+    int tiles_handle = item->tiles_handle();
+
+    if(sprite_tiles_manager::usages(tiles_handle) > 1 || ! sprite_tiles_manager::tiles_ref(tiles_handle))
+    {
+        return false;
+    }
+
+    span<const tile> tiles_ref = tiles_item.graphics_tiles_ref(graphics_index);
+
+    if(sprite_tiles_manager::tiles_count(tiles_handle) != tiles_ref.size())
+    {
+        return false;
+    }
+
+    sprite_tiles_manager::set_tiles_ref(tiles_handle, tiles_ref, tiles_item.compression());
+    return true;
+}
+
 const sprite_palette_ptr& palette(id_type id)
 {
     auto item = static_cast<const item_type*>(id);
@@ -557,6 +638,113 @@ void remove_palette(id_type id)
     item->palette.reset();
 }
 
+bool repack_palettes()
+{
+    static_data& data = data_ref();
+    palettes_bank& sprite_palettes_bank = palettes_manager::sprite_palettes_bank();
+    constexpr int palettes_count = hw::palettes::count();
+    int items_usages[palettes_count] = {};
+
+    for(sorted_sprites::layer& layer : data.sorter.layers())
+    {
+        for(item_type& item : layer.items())
+        {
+            if(const sprite_palette_ptr* palette = item.palette.get())
+            {
+                ++items_usages[palette->id()];
+            }
+        }
+    }
+
+    // Only palettes referenced by sprites alone can be merged or moved:
+    unsigned movable_ids_mask = 0;
+
+    for(int id = 0; id < palettes_count; ++id)
+    {
+        int items_usages_count = items_usages[id];
+
+        if(items_usages_count && items_usages_count == sprite_palettes_bank.usages(id))
+        {
+            movable_ids_mask |= 1U << id;
+        }
+    }
+
+    int8_t new_ids[palettes_count];
+
+    if(! movable_ids_mask || ! sprite_palettes_bank.repack_bpp_4(movable_ids_mask, new_ids))
+    {
+        return false;
+    }
+
+    for(sorted_sprites::layer& layer : data.sorter.layers())
+    {
+        for(item_type& item : layer.items())
+        {
+            if(const sprite_palette_ptr* palette = item.palette.get())
+            {
+                int id = palette->id();
+                int new_id = new_ids[id];
+
+                if(new_id != id)
+                {
+                    item.set_palette_id(new_id);
+                    hw::sprites::set_palette(new_id, item.handle);
+                    _update_indexes_to_commit(item);
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+bool compact_tiles(int max_tiles_count)
+{
+    if(! sprite_tiles_manager::fragmented())
+    {
+        return false;
+    }
+
+    static_data& data = data_ref();
+    uint16_t items_usages[sprite_tiles_manager::max_ids()] = {};
+
+    for(sorted_sprites::layer& layer : data.sorter.layers())
+    {
+        for(item_type& item : layer.items())
+        {
+            if(item.tiles)
+            {
+                ++items_usages[item.tiles_handle()];
+            }
+        }
+    }
+
+    // Only tiles referenced by sprites alone can be moved:
+    if(! sprite_tiles_manager::compact(items_usages, max_tiles_count))
+    {
+        return false;
+    }
+
+    for(sorted_sprites::layer& layer : data.sorter.layers())
+    {
+        for(item_type& item : layer.items())
+        {
+            if(const sprite_tiles_ptr* tiles = item.tiles.get())
+            {
+                int tiles_id = tiles->id();
+
+                if(tiles_id != hw::sprites::tiles_id(item.handle))
+                {
+                    hw::sprites::set_tiles(tiles_id, item.handle);
+                    _update_indexes_to_commit(item);
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
 void set_tiles_and_palette(id_type id, const sprite_shape_size& shape_size, sprite_tiles_ptr&& tiles,
                            sprite_palette_ptr&& palette)
 {
@@ -602,9 +790,16 @@ const fixed_point& position(id_type id)
     return item->position;
 }
 
-const point& hw_position(id_type id)
+point hw_position(id_type id)
 {
     auto item = static_cast<const item_type*>(id);
+
+    // Hardware positions of culled sprites are not updated when their camera moves:
+    if(_culled(*item)) [[unlikely]]
+    {
+        return item->calculate_hw_position();
+    }
+
     return item->hw_position;
 }
 
@@ -620,9 +815,17 @@ void set_x(id_type id, fixed x)
 
     if(diff)
     {
-        int hw_x = item->hw_position.x() + diff;
-        item->hw_position.set_x(hw_x);
-        hw::sprites::set_x(hw_x, item->handle);
+        if(_culled(*item)) [[unlikely]]
+        {
+            _update_culling_bucket(*item);
+            item->update_hw_position();
+        }
+        else
+        {
+            int hw_x = item->hw_position.x() + diff;
+            item->hw_position.set_x(hw_x);
+            hw::sprites::set_x(hw_x, item->handle);
+        }
 
         if(item->visible)
         {
@@ -646,9 +849,17 @@ void set_y(id_type id, fixed y)
 
     if(diff)
     {
-        int hw_y = item->hw_position.y() + diff;
-        item->hw_position.set_y(hw_y);
-        hw::sprites::set_y(hw_y, item->handle);
+        if(_culled(*item)) [[unlikely]]
+        {
+            _update_culling_bucket(*item);
+            item->update_hw_position();
+        }
+        else
+        {
+            int hw_y = item->hw_position.y() + diff;
+            item->hw_position.set_y(hw_y);
+            hw::sprites::set_y(hw_y, item->handle);
+        }
 
         if(item->visible)
         {
@@ -672,12 +883,20 @@ void set_position(id_type id, const fixed_point& position)
 
     if(diff != point())
     {
-        point new_hw_position = item->hw_position + diff;
-        item->hw_position = new_hw_position;
+        if(_culled(*item)) [[unlikely]]
+        {
+            _update_culling_bucket(*item);
+            item->update_hw_position();
+        }
+        else
+        {
+            point new_hw_position = item->hw_position + diff;
+            item->hw_position = new_hw_position;
 
-        hw::sprites::handle_type& handle = item->handle;
-        hw::sprites::set_x(new_hw_position.x(), handle);
-        hw::sprites::set_y(new_hw_position.y(), handle);
+            hw::sprites::handle_type& handle = item->handle;
+            hw::sprites::set_x(new_hw_position.x(), handle);
+            hw::sprites::set_y(new_hw_position.y(), handle);
+        }
 
         if(item->visible)
         {
@@ -954,6 +1173,7 @@ void set_visible(id_type id, bool visible)
             hw::sprites::hide(item->handle);
             item->on_screen = false;
             item->check_on_screen = false;
+            data.sorter.set_layer_dirty(*item);
         }
     }
 }
@@ -971,6 +1191,7 @@ void set_camera(id_type id, camera_ptr&& camera)
     if(camera != item->camera)
     {
         item->camera = move(camera);
+        _update_culling_bucket(*item);
         item->update_hw_position();
 
         if(item->visible)
@@ -990,6 +1211,7 @@ void remove_camera(id_type id)
     if(item->camera)
     {
         item->camera.reset();
+        _update_culling_bucket(*item);
         item->update_hw_position();
 
         if(item->visible)
@@ -1198,7 +1420,7 @@ void reload_blending()
             for(item_type& item : layer.items())
             {
                 hw::sprites::set_blending_enabled(item.blending_enabled, fade_enabled, item.handle);
-                _always_update_indexes_to_commit(item);
+                _update_indexes_to_commit(item);
             }
         }
     }
@@ -1210,6 +1432,7 @@ void reload_all()
     data.last_visible_items_count = hw::sprites::count();
     data.rebuild_handles = true;
     data.reload_all_handles = true;
+    data.sorter.set_layers_dirty();
 }
 
 void fill_hblank_effect_horizontal_positions(id_type id, int hw_x, const fixed* positions_ptr, uint16_t* dest_ptr)
@@ -1374,16 +1597,50 @@ void fill_hblank_effect_third_attributes([[maybe_unused]] sprite_shape_size shap
     }
 }
 
+void update_camera_sprites_culling(int camera_id)
+{
+    static_data& data = data_ref();
+
+    for(culling_bucket_type& culling_bucket : data.culling_buckets)
+    {
+        auto it = culling_bucket.begin();
+        auto end = culling_bucket.end();
+
+        while(it != end)
+        {
+            item_type& item = item_type::culling_node_item(*it);
+            ++it;
+
+            if(item.camera->id() == camera_id)
+            {
+                _update_culling_bucket(item);
+            }
+        }
+    }
+}
+
 void update_cameras()
 {
     static_data& data = data_ref();
 
+    const cameras_manager::culling_cells* cameras_culling_cells = cameras_manager::sprites_culling_cells();
+    unsigned culling_buckets_mask = cameras_manager::sprites_culling_buckets_mask();
+    int evaluated_items_count = 0;
+    int culled_items_count = 0;
+
     #if BN_CFG_SPRITES_USE_IWRAM
-        bool check_items_on_screen = _update_cameras_impl(data.sorter.layers());
+        bool check_items_on_screen = _update_cameras_impl(
+                    data.culling_buckets, culling_buckets_mask, cameras_culling_cells, evaluated_items_count,
+                    culled_items_count);
     #else
-        bool check_items_on_screen = hot::update_cameras(data.sorter.layers());
+        bool check_items_on_screen = hot::update_cameras(
+                    data.culling_buckets, culling_buckets_mask, cameras_culling_cells, evaluated_items_count,
+                    culled_items_count);
     #endif
 
+    BN_PROFILER_ENGINE_DETAILED_COUNT("eng_spr_cull_evaluated", evaluated_items_count);
+    BN_PROFILER_ENGINE_DETAILED_COUNT("eng_spr_cull_culled", culled_items_count);
+
     if(check_items_on_screen)
     {
         data.check_items_on_screen = true;
@@ -1414,6 +1671,11 @@ void update()
     static_data& data = data_ref();
     sprite_affine_mats_manager::update();
 
+    if(int compaction_max_tiles_count = sprite_tiles_manager::compaction_max_tiles_per_frame())
+    {
+        [[maybe_unused]] bool compacted = compact_tiles(compaction_max_tiles_count);
+    }
+
     if(data.check_items_on_screen)
     {
         data.check_items_on_screen = false;
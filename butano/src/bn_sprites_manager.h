@@ -20,6 +20,7 @@ class point;
 class camera_ptr;
 class sprite_builder;
 class sprite_tiles_ptr;
+class sprite_tiles_item;
 class sprite_shape_size;
 class sprite_palette_ptr;
 class affine_mat_attributes;
@@ -38,6 +39,11 @@ namespace sorted_sprites
     class layer;
 }
 
+namespace cameras_manager
+{
+    class culling_cells;
+}
+
 namespace sprites_manager
 {
     using id_type = void*;
@@ -84,6 +90,8 @@ namespace sprites_manager
 
     void remove_tiles(id_type id);
 
+    [[nodiscard]] bool stream_tiles(id_type id, const sprite_tiles_item& tiles_item, int graphics_index);
+
     [[nodiscard]] const sprite_palette_ptr& palette(id_type id);
 
     void set_palette(id_type id, bpp_mode old_bpp, const sprite_palette_ptr& palette);
@@ -92,12 +100,16 @@ namespace sprites_manager
 
     void remove_palette(id_type id);
 
+    [[nodiscard]] bool repack_palettes();
+
+    [[nodiscard]] bool compact_tiles(int max_tiles_count);
+
     void set_tiles_and_palette(id_type id, const sprite_shape_size& shape_size, sprite_tiles_ptr&& tiles,
                                sprite_palette_ptr&& palette);
 
     [[nodiscard]] const fixed_point& position(id_type id);
 
-    [[nodiscard]] const point& hw_position(id_type id);
+    [[nodiscard]] point hw_position(id_type id);
 
     void set_x(id_type id, fixed x);
 
@@ -217,6 +229,8 @@ namespace sprites_manager
     void fill_hblank_effect_third_attributes(
             sprite_shape_size shape_size, const sprite_third_attributes* third_attributes_ptr, uint16_t* dest_ptr);
 
+    void update_camera_sprites_culling(int camera_id);
+
     void update_cameras();
 
     void remove_identity_affine_mat_when_not_needed(id_type id);
@@ -231,9 +245,13 @@ namespace sprites_manager
         BN_CODE_IWRAM void _check_items_on_screen(intrusive_list<sorted_sprites::layer>& layers);
 
         [[nodiscard]] BN_CODE_IWRAM int _rebuild_handles_impl(
-                int reserved_handles_count, void* hw_handles, intrusive_list<sorted_sprites::layer>& layers);
+                int reserved_handles_count, void* hw_handles, intrusive_list<sorted_sprites::layer>& layers,
+                int& first_changed_index, int& last_changed_index, int& changed_handles_count);
 
-        [[nodiscard]] BN_CODE_IWRAM bool _update_cameras_impl(intrusive_list<sorted_sprites::layer>& layers);
+        [[nodiscard]] BN_CODE_IWRAM bool _update_cameras_impl(
+                intrusive_list<intrusive_list_node_type>* culling_buckets, unsigned culling_buckets_mask,
+                const cameras_manager::culling_cells* cameras_culling_cells, int& evaluated_items_count,
+                int& culled_items_count);
     #endif
 }
 
@@ -4,6 +4,7 @@
  */
 
 #include "bn_sorted_sprites.h"
+#include "bn_cameras_manager.h"
 #include "../hw/include/bn_hw_sprites_constants.h"
 
 namespace bn::sprites_manager::hot
@@ -34,6 +35,7 @@ inline void check_items_on_screen(intrusive_list<sorted_sprites::layer>& layers)
                 if(item.on_screen != on_screen)
                 {
                     item.on_screen = on_screen;
+                    layer.set_dirty();
 
                     if(on_screen)
                     {
@@ -57,13 +59,23 @@ inline void check_items_on_screen(intrusive_list<sorted_sprites::layer>& layers)
 }
 
 [[nodiscard]] inline int rebuild_handles(
-        int reserved_handles_count, void* hw_handles, intrusive_list<sorted_sprites::layer>& layers)
+        int reserved_handles_count, void* hw_handles, intrusive_list<sorted_sprites::layer>& layers,
+        int& first_changed_index, int& last_changed_index, int& changed_handles_count)
 {
     auto handles = reinterpret_cast<hw::sprites::handle_type*>(hw_handles);
     int visible_items_count = reserved_handles_count;
 
     for(sorted_sprites::layer& layer : layers)
     {
+        // Layers without items shown, hidden or sorted since the last rebuild keep their handles:
+        if(! layer.dirty() && layer.first_handles_index() == visible_items_count)
+        {
+            visible_items_count += layer.handles_count();
+            continue;
+        }
+
+        int first_handles_index = visible_items_count;
+
         for(sprites_manager_item& item : layer.items())
         {
             if(item.on_screen)
@@ -75,7 +87,23 @@ inline void check_items_on_screen(intrusive_list<sorted_sprites::layer>& layers)
                     }
                 #endif
 
-                hw::sprites::copy_handle(item.handle, handles[visible_items_count]);
+                const hw::sprites::handle_type& item_handle = item.handle;
+                hw::sprites::handle_type& handle = handles[visible_items_count];
+
+                if(item_handle.attr0 != handle.attr0 || item_handle.attr1 != handle.attr1 ||
+                        item_handle.attr2 != handle.attr2)
+                {
+                    hw::sprites::copy_handle(item_handle, handle);
+
+                    if(visible_items_count < first_changed_index)
+                    {
+                        first_changed_index = visible_items_count;
+                    }
+
+                    last_changed_index = visible_items_count;
+                    ++changed_handles_count;
+                }
+
                 item.handles_index = int8_t(visible_items_count);
                 ++visible_items_count;
             }
@@ -84,30 +112,75 @@ inline void check_items_on_screen(intrusive_list<sorted_sprites::layer>& layers)
                 item.handles_index = -1;
             }
         }
+
+        layer.set_handles(first_handles_index, visible_items_count - first_handles_index);
     }
 
+    #if BN_CFG_ASSERT_ENABLED
+        if(visible_items_count > hw::sprites::count()) [[unlikely]]
+        {
+            return -1;
+        }
+    #endif
+
     return visible_items_count;
 }
 
-[[nodiscard]] inline bool update_cameras(intrusive_list<sorted_sprites::layer>& layers)
+[[nodiscard]] inline bool update_cameras(intrusive_list<sprite_culling_node_type>* culling_buckets,
+        unsigned culling_buckets_mask, const cameras_manager::culling_cells* cameras_culling_cells,
+        int& evaluated_items_count, int& culled_items_count)
 {
     bool check_items_on_screen = false;
 
-    for(sorted_sprites::layer& layer : layers)
+    // Buckets of grid cells not entering or leaving the display are skipped:
+    for(int bucket = 0; bucket < cameras_manager::sprites_culling_buckets_count; ++bucket)
     {
-        for(sprites_manager_item& item : layer.items())
+        intrusive_list<sprite_culling_node_type>& bucket_nodes = culling_buckets[bucket];
+
+        if(culling_buckets_mask & (1U << bucket))
         {
-            if(item.camera)
+            for(sprite_culling_node_type& culling_node : bucket_nodes)
             {
-                item.update_hw_position();
+                sprites_manager_item& item = sprites_manager_item::culling_node_item(culling_node);
+                const cameras_manager::culling_cells& culling_cells = cameras_culling_cells[item.camera->id()];
+                int cell_x = item.position.x().right_shift_integer() >> cameras_manager::sprites_culling_cell_shift;
+                int cell_y = item.position.y().right_shift_integer() >> cameras_manager::sprites_culling_cell_shift;
+
+                if(culling_cells.contains(cell_x, cell_y))
+                {
+                    item.update_hw_position();
+                    ++evaluated_items_count;
 
-                if(item.visible)
+                    if(item.visible)
+                    {
+                        item.check_on_screen = true;
+                        check_items_on_screen = true;
+                    }
+                }
+                else
                 {
-                    item.check_on_screen = true;
-                    check_items_on_screen = true;
+                    ++culled_items_count;
                 }
             }
         }
+        else
+        {
+            culled_items_count += bucket_nodes.size();
+        }
+    }
+
+    // Sprites attached to cameras without culling are always updated:
+    for(sprite_culling_node_type& culling_node : culling_buckets[cameras_manager::sprites_culling_buckets_count])
+    {
+        sprites_manager_item& item = sprites_manager_item::culling_node_item(culling_node);
+        item.update_hw_position();
+        ++evaluated_items_count;
+
+        if(item.visible)
+        {
+            item.check_on_screen = true;
+            check_items_on_screen = true;
+        }
     }
 
     return check_items_on_screen;
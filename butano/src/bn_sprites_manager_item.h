@@ -6,6 +6,7 @@
 #ifndef BN_SPRITES_MANAGER_ITEM_H
 #define BN_SPRITES_MANAGER_ITEM_H
 
+#include "bn_limits.h"
 #include "bn_display.h"
 #include "bn_sort_key.h"
 #include "bn_camera_ptr.h"
@@ -23,6 +24,7 @@ namespace bn
     class sprite_builder;
 
     using sprite_affine_mat_attach_node_type = intrusive_list_node_type;
+    using sprite_culling_node_type = intrusive_list_node_type;
 }
 
 namespace bn::sorted_sprites
@@ -37,7 +39,10 @@ class sprites_manager_item : public intrusive_list_node_type
 {
 
 public:
+    static constexpr int no_culling_bucket = numeric_limits<uint8_t>::max();
+
     sprite_affine_mat_attach_node_type affine_mat_attach_node;
+    sprite_culling_node_type culling_node;
     hw::sprites::handle_type handle;
     fixed_point position;
     point hw_position;
@@ -49,6 +54,7 @@ public:
     optional<camera_ptr> camera;
     int16_t sort_layer_ptr_diff;
     int8_t handles_index = -1;
+    uint8_t culling_bucket = no_culling_bucket;
     int8_t half_width;
     int8_t half_height;
     uint8_t double_size_mode: 2;
@@ -59,6 +65,17 @@ public:
     bool on_screen: 1;
     bool check_on_screen: 1;
 
+    [[nodiscard]] int tiles_handle() const
+    {
+        return tiles->_handle;
+    }
+
+    void set_palette_id(int palette_id)
+    {
+        // Palettes are relocated by the palettes bank, so their usages are not updated here:
+        palette->_id = int8_t(palette_id);
+    }
+
     [[nodiscard]] static sprites_manager_item& affine_mat_attach_node_item(
             sprite_affine_mat_attach_node_type& attach_node)
     {
@@ -69,6 +86,15 @@ public:
         return *item;
     }
 
+    [[nodiscard]] static sprites_manager_item& culling_node_item(sprite_culling_node_type& culling_node)
+    {
+        auto item_address = reinterpret_cast<intptr_t>(&culling_node);
+        item_address -= sizeof(intrusive_list_node_type) + sizeof(sprite_affine_mat_attach_node_type);
+
+        auto item = reinterpret_cast<sprites_manager_item*>(item_address);
+        return *item;
+    }
+
     sprites_manager_item(const fixed_point& _position, const sprite_shape_size& shape_size,
                          sprite_tiles_ptr&& _tiles, sprite_palette_ptr&& _palette) :
         position(_position),
@@ -193,7 +219,7 @@ public:
         update_hw_position();
     }
 
-    void update_hw_position()
+    [[nodiscard]] point real_position() const
     {
         int real_x = position.x().shift_integer();
         int real_y = position.y().shift_integer();
@@ -205,8 +231,22 @@ public:
             real_y -= camera_position.y().shift_integer();
         }
 
-        update_hw_x(real_x);
-        update_hw_y(real_y);
+        return point(real_x, real_y);
+    }
+
+    [[nodiscard]] point calculate_hw_position() const
+    {
+        point result = real_position();
+        result.set_x(result.x() + (display::width() / 2) - int(half_width));
+        result.set_y(result.y() + (display::height() / 2) - int(half_height));
+        return result;
+    }
+
+    void update_hw_position()
+    {
+        point real = real_position();
+        update_hw_x(real.x());
+        update_hw_y(real.y());
     }
 
     void update_hw_x(int real_x)
@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_telemetry.h"
+
+#if BN_CFG_TELEMETRY_ENABLED
+    #include "bn_span.h"
+    #include "bn_memory.h"
+    #include "bn_algorithm.h"
+    #include "bn_power_of_two.h"
+    #include "bn_config_log.h"
+    #include "../hw/include/bn_hw_timer.h"
+
+    #if BN_CFG_LOG_ENABLED
+        #include "bn_log.h"
+    #endif
+
+    namespace _bn::telemetry
+    {
+        namespace
+        {
+            static_assert(BN_CFG_TELEMETRY_MAX_SAMPLES > 0);
+            static_assert(bn::power_of_two(BN_CFG_TELEMETRY_MAX_SAMPLES));
+            static_assert(BN_CFG_TELEMETRY_LOG_INTERVAL >= 0);
+
+            constexpr int max_samples = BN_CFG_TELEMETRY_MAX_SAMPLES;
+            constexpr int frame_channels_count = 3;
+            constexpr int channels_count = frame_channels_count + engine_sections_count;
+            constexpr int max_active_sections = 4;
+
+            class static_data
+            {
+
+            public:
+                int values[channels_count][max_samples];
+                int percentile_values[max_samples];
+                int sections_ticks[engine_sections_count];
+                unsigned active_sections_start_ticks[max_active_sections];
+                int8_t active_sections[max_active_sections];
+                int active_sections_count = 0;
+                int next_sample_index = 0;
+                int samples_count = 0;
+                int samples_since_log = 0;
+            };
+
+            BN_DATA_EWRAM_BSS static_data data;
+
+            [[nodiscard]] int& _value_ref(int channel, int sample_index)
+            {
+                int first_sample_index = data.next_sample_index - data.samples_count;
+                return data.values[channel][(first_sample_index + sample_index) & (max_samples - 1)];
+            }
+        }
+
+        void start(int section_index)
+        {
+            int active_sections_count = data.active_sections_count;
+            BN_BASIC_ASSERT(active_sections_count < max_active_sections, "Too many active sections");
+
+            data.active_sections[active_sections_count] = int8_t(section_index);
+            data.active_sections_start_ticks[active_sections_count] = bn::hw::timer::ticks();
+            data.active_sections_count = active_sections_count + 1;
+        }
+
+        void stop()
+        {
+            unsigned ticks = bn::hw::timer::ticks();
+            int active_sections_count = data.active_sections_count - 1;
+            BN_BASIC_ASSERT(active_sections_count >= 0, "There's no active section");
+
+            int section_index = data.active_sections[active_sections_count];
+            data.sections_ticks[section_index] += int(ticks - data.active_sections_start_ticks[active_sections_count]);
+            data.active_sections_count = active_sections_count;
+        }
+
+        void add_sample(int cpu_ticks, int vblank_ticks, int missed_frames)
+        {
+            int sample_index = data.next_sample_index;
+            data.values[bn::telemetry::cpu_ticks_channel][sample_index] = cpu_ticks;
+            data.values[bn::telemetry::vblank_ticks_channel][sample_index] = vblank_ticks;
+            data.values[bn::telemetry::missed_frames_channel][sample_index] = missed_frames;
+
+            for(int section_index = 0; section_index < engine_sections_count; ++section_index)
+            {
+                data.values[frame_channels_count + section_index][sample_index] = data.sections_ticks[section_index];
+            }
+
+            bn::memory::clear(data.sections_ticks);
+            data.next_sample_index = (sample_index + 1) & (max_samples - 1);
+            data.samples_count = bn::min(data.samples_count + 1, max_samples);
+
+            if constexpr(BN_CFG_TELEMETRY_LOG_INTERVAL > 0)
+            {
+                if(++data.samples_since_log == BN_CFG_TELEMETRY_LOG_INTERVAL)
+                {
+                    data.samples_since_log = 0;
+                    bn::telemetry::log();
+                }
+            }
+        }
+    }
+
+    namespace bn::telemetry
+    {
+        int channels_count()
+        {
+            return _bn::telemetry::channels_count;
+        }
+
+        const char* channel_name(int channel)
+        {
+            BN_ASSERT(channel >= 0 && channel < _bn::telemetry::channels_count, "Invalid channel: ", channel);
+
+            switch(channel)
+            {
+
+            case cpu_ticks_channel:
+                return "cpu_ticks";
+
+            case vblank_ticks_channel:
+                return "vblank_ticks";
+
+            case missed_frames_channel:
+                return "missed_frames";
+
+            default:
+                return _bn::telemetry::engine_sections[channel - _bn::telemetry::frame_channels_count];
+            }
+        }
+
+        int samples_count()
+        {
+            return _bn::telemetry::data.samples_count;
+        }
+
+        int value(int channel, int sample_index)
+        {
+            BN_ASSERT(channel >= 0 && channel < _bn::telemetry::channels_count, "Invalid channel: ", channel);
+            BN_ASSERT(sample_index >= 0 && sample_index < samples_count(), "Invalid sample index: ", sample_index);
+
+            return _bn::telemetry::_value_ref(channel, sample_index);
+        }
+
+        int percentile(int channel, int percent)
+        {
+            BN_ASSERT(channel >= 0 && channel < _bn::telemetry::channels_count, "Invalid channel: ", channel);
+            BN_ASSERT(percent >= 0 && percent <= 100, "Invalid percent: ", percent);
+
+            int count = samples_count();
+
+            if(! count)
+            {
+                return 0;
+            }
+
+            // Samples are copied to an EWRAM buffer to avoid a big IWRAM stack frame:
+            int* values = _bn::telemetry::data.percentile_values;
+
+            for(int sample_index = 0; sample_index < count; ++sample_index)
+            {
+                values[sample_index] = _bn::telemetry::_value_ref(channel, sample_index);
+            }
+
+            // Nearest rank method:
+            int rank = bn::max(((percent * count) + 99) / 100, 1);
+            bn::nth_element(values, values + rank - 1, values + count);
+            return values[rank - 1];
+        }
+
+        int max(int channel)
+        {
+            BN_ASSERT(channel >= 0 && channel < _bn::telemetry::channels_count, "Invalid channel: ", channel);
+
+            int result = 0;
+
+            for(int sample_index = 0, count = samples_count(); sample_index < count; ++sample_index)
+            {
+                result = bn::max(result, _bn::telemetry::_value_ref(channel, sample_index));
+            }
+
+            return result;
+        }
+
+        void histogram(int channel, int bucket_size, span<int> buckets)
+        {
+            BN_ASSERT(channel >= 0 && channel < _bn::telemetry::channels_count, "Invalid channel: ", channel);
+            BN_ASSERT(bucket_size > 0, "Invalid bucket size: ", bucket_size);
+            BN_BASIC_ASSERT(! buckets.empty(), "There are no buckets");
+
+            int last_bucket_index = buckets.size() - 1;
+
+            for(int& bucket : buckets)
+            {
+                bucket = 0;
+            }
+
+            for(int sample_index = 0, count = samples_count(); sample_index < count; ++sample_index)
+            {
+                int bucket_index = _bn::telemetry::_value_ref(channel, sample_index) / bucket_size;
+                ++buckets[bn::min(bucket_index, last_bucket_index)];
+            }
+        }
+
+        void log()
+        {
+            #if BN_CFG_LOG_ENABLED
+                BN_LOG("telemetry samples: ", samples_count());
+
+                for(int channel = 0; channel < _bn::telemetry::channels_count; ++channel)
+                {
+                    BN_LOG("    ", channel_name(channel),
+                           " - p50: ", percentile(channel, 50),
+                           " - p95: ", percentile(channel, 95),
+                           " - max: ", max(channel));
+                }
+            #endif
+        }
+
+        void reset()
+        {
+            _bn::telemetry::data.next_sample_index = 0;
+            _bn::telemetry::data.samples_count = 0;
+            _bn::telemetry::data.samples_since_log = 0;
+        }
+    }
+#endif
@@ -104,6 +104,16 @@ class BMP:
 
             self.colors_count = colors_count
 
+    def palette_colors(self):
+        palette_colors_count = int((self.__pixels_offset - self.__colors_offset) / 4)
+
+        with open(self.__file_path, 'rb') as file:
+            file.seek(self.__colors_offset)
+            colors = struct.unpack(str(palette_colors_count) + 'I', file.read(palette_colors_count * 4))
+
+        # GBA colors (5 bits per channel):
+        return [((color >> 19) & 31) | (((color >> 11) & 31) << 5) | (((color >> 3) & 31) << 10) for color in colors]
+
     def quantize(self, output_file_path):
         if self.colors_count == 16:
             shutil.copyfile(self.__file_path, output_file_path)
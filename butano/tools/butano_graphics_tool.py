@@ -81,10 +81,27 @@ def validate_palette_item(palette_item):
 
 
 def validate_compression(compression):
-    if compression not in ['none', 'lz77', 'run_length', 'huffman', 'auto', 'auto_no_huffman']:
+    if compression not in ['none', 'lz77', 'run_length', 'huffman', 'lz4', 'rans', 'auto', 'auto_no_huffman',
+                           'auto_smallest', 'auto_fast']:
         raise ValueError('Unknown compression: ' + str(compression))
 
 
+def auto_compressions(compression):
+    if compression == 'auto':
+        return ['none', 'run_length', 'lz77', 'huffman']
+
+    if compression == 'auto_no_huffman':
+        return ['none', 'run_length', 'lz77']
+
+    if compression == 'auto_smallest':
+        return ['none', 'run_length', 'lz77', 'huffman', 'lz4', 'rans']
+
+    if compression == 'auto_fast':
+        return ['none', 'lz4']
+
+    raise ValueError('Unknown compression: ' + str(compression))
+
+
 def compression_label(compression):
     if compression == 'none':
         return 'compression_type::NONE'
@@ -98,9 +115,37 @@ def compression_label(compression):
     if compression == 'huffman':
         return 'compression_type::HUFFMAN'
 
+    if compression == 'lz4':
+        return 'compression_type::LZ4'
+
+    if compression == 'rans':
+        return 'compression_type::RANS'
+
     raise ValueError('Unknown compression: ' + str(compression))
 
 
+def tiles_content_hash_label(grit_data, name):
+    tiles_match = re.search(re.escape(name) + r'_bn_gfxTiles\[[0-9]+][^=;]*=\s*{([^}]*)}', grit_data)
+
+    if tiles_match is None:
+        return '0'
+
+    # 32-bit FNV-1a hash of the tiles data (0 is reserved for items without content hash):
+    result = 0x811C9DC5
+
+    for tiles_word in re.findall(r'0x[0-9A-Fa-f]+', tiles_match.group(1)):
+        tiles_word_value = int(tiles_word, 16)
+
+        for shift in range(0, 32, 8):
+            result ^= (tiles_word_value >> shift) & 0xFF
+            result = (result * 0x01000193) & 0xFFFFFFFF
+
+    if result == 0:
+        result = 1
+
+    return '0x' + format(result, '08X')
+
+
 def append_compression_command(tag, compression, command):
     if compression == 'lz77':
         command.append('-' + tag + 'zl')
@@ -110,6 +155,200 @@ def append_compression_command(tag, compression, command):
         command.append('-' + tag + 'zh')
 
 
+def lz4_compress(data):
+    # Byte aligned LZ4 block format preceded by a GBA BIOS like header (type 4):
+    size = len(data)
+    output = bytearray(((size << 8) | 0x40).to_bytes(4, 'little'))
+    positions = {}
+    literals_start = 0
+    index = 0
+
+    def write_length(length):
+        while length >= 255:
+            output.append(255)
+            length -= 255
+
+        output.append(length)
+
+    def write_sequence(literals_end, match_distance, match_length):
+        literals_length = literals_end - literals_start
+        token = min(literals_length, 15) << 4
+
+        if match_length:
+            token |= min(match_length - 4, 15)
+
+        output.append(token)
+
+        if literals_length >= 15:
+            write_length(literals_length - 15)
+
+        output.extend(data[literals_start:literals_end])
+
+        if match_length:
+            output.extend(match_distance.to_bytes(2, 'little'))
+
+            if match_length - 4 >= 15:
+                write_length(match_length - 4 - 15)
+
+    while index + 4 <= size:
+        key = bytes(data[index:index + 4])
+        match_index = positions.get(key)
+        positions[key] = index
+
+        if match_index is not None and index - match_index <= 0xFFFF:
+            match_length = 4
+
+            while index + match_length < size and data[match_index + match_length] == data[index + match_length]:
+                match_length += 1
+
+            write_sequence(index, index - match_index, match_length)
+
+            for match_position in range(index + 1, min(index + match_length, size - 3)):
+                positions[bytes(data[match_position:match_position + 4])] = match_position
+
+            index += match_length
+            literals_start = index
+        else:
+            index += 1
+
+    if literals_start < size:
+        write_sequence(size, 0, 0)
+
+    return bytes(output)
+
+
+def rans_compress_symbols(data, symbol_bits):
+    # Static rANS with 12-bit frequencies preceded by a GBA BIOS like header (type 5):
+    scale_bits = 12
+    lower_bound = 1 << 23
+
+    if symbol_bits == 4:
+        symbols = []
+
+        for value in data:
+            symbols.append(value & 0xF)
+            symbols.append(value >> 4)
+    else:
+        symbols = list(data)
+
+    symbols_count = max(symbols) + 1
+    counts = [0] * symbols_count
+
+    for symbol in symbols:
+        counts[symbol] += 1
+
+    frequencies = [0] * symbols_count
+
+    for symbol in range(symbols_count):
+        if counts[symbol]:
+            frequencies[symbol] = max((counts[symbol] << scale_bits) // len(symbols), 1)
+
+    while sum(frequencies) != 1 << scale_bits:
+        if sum(frequencies) < 1 << scale_bits:
+            frequencies[counts.index(max(counts))] += 1
+        else:
+            symbol = max(range(symbols_count), key=lambda s: frequencies[s])
+            frequencies[symbol] -= 1
+
+    starts = [0] * symbols_count
+
+    for symbol in range(1, symbols_count):
+        starts[symbol] = starts[symbol - 1] + frequencies[symbol - 1]
+
+    state = lower_bound
+    reversed_bytes = bytearray()
+
+    for symbol in reversed(symbols):
+        frequency = frequencies[symbol]
+        max_state = ((lower_bound >> scale_bits) << 8) * frequency
+
+        while state >= max_state:
+            reversed_bytes.append(state & 0xFF)
+            state >>= 8
+
+        state = ((state // frequency) << scale_bits) + (state % frequency) + starts[symbol]
+
+    output = bytearray(((len(data) << 8) | 0x50 | symbol_bits).to_bytes(4, 'little'))
+    output.extend(symbols_count.to_bytes(2, 'little'))
+
+    for frequency in frequencies:
+        output.extend(frequency.to_bytes(2, 'little'))
+
+    output.extend(state.to_bytes(4, 'little'))
+    reversed_bytes.reverse()
+    output.extend(reversed_bytes)
+    return bytes(output)
+
+
+def rans_compress(data):
+    nibbles_output = rans_compress_symbols(data, 4)
+    bytes_output = rans_compress_symbols(data, 8)
+    return nibbles_output if len(nibbles_output) <= len(bytes_output) else bytes_output
+
+
+def apply_compression(grit_file_path, array_name, compression):
+    # Compression types not supported by grit are applied to its uncompressed output:
+    if compression == 'lz4':
+        compress_function = lz4_compress
+    elif compression == 'rans':
+        compress_function = rans_compress
+    else:
+        return
+
+    with open(grit_file_path, 'r') as grit_file:
+        grit_data = grit_file.read()
+
+    array_pattern = r'unsigned (int|short|char) (\w+' + array_name + r')\[([0-9]+)]([^=;]*)=\s*{([^}]*)}'
+    array_match = re.search(array_pattern, grit_data)
+
+    if array_match is None:
+        raise ValueError(array_name + ' array not found in ' + grit_file_path)
+
+    word_size = {'int': 4, 'short': 2, 'char': 1}[array_match.group(1)]
+    name = array_match.group(2)
+    data = bytearray()
+
+    for grit_word in re.findall(r'0x[0-9A-Fa-f]+', array_match.group(5)):
+        data.extend(int(grit_word, 16).to_bytes(word_size, 'little'))
+
+    old_size = len(data)
+    data = bytearray(compress_function(bytes(data)))
+
+    while len(data) % 4:
+        data.append(0)
+
+    new_size = len(data)
+    words = [int.from_bytes(data[index:index + word_size], 'little') for index in range(0, new_size, word_size)]
+    word_format = '0x%0' + str(word_size * 2) + 'X'
+    words_per_line = 8 if word_size == 4 else 16
+    words_text = ''
+
+    for index in range(0, len(words), words_per_line):
+        words_text += '\t' + ','.join(word_format % word for word in words[index:index + words_per_line]) + ',\n'
+
+    array_text = 'unsigned ' + array_match.group(1) + ' ' + name + '[' + str(len(words)) + ']' + \
+                 array_match.group(4) + '=\n{\n' + words_text + '}'
+    grit_data = grit_data[:array_match.start()] + array_text + grit_data[array_match.end():]
+    grit_data = re.sub(name + r'\[[0-9]+]', name + '[' + str(len(words)) + ']', grit_data)
+    grit_data = re.sub(r'#define ' + name + r'Len [0-9]+', '#define ' + name + 'Len ' + str(new_size), grit_data)
+
+    def update_total_size(total_size_match):
+        sizes = [int(size) for size in total_size_match.group(1).split('=')[0].split('+')]
+
+        if old_size in sizes:
+            sizes[sizes.index(old_size)] = new_size
+
+        if len(sizes) == 1:
+            return 'Total size: ' + str(sizes[0])
+
+        return 'Total size: ' + ' + '.join(str(size) for size in sizes) + ' = ' + str(sum(sizes))
+
+    grit_data = re.sub(r'Total size: ([0-9 +=]+)', update_total_size, grit_data)
+
+    with open(grit_file_path, 'w') as grit_file:
+        grit_file.write(grit_data)
+
+
 def remove_file(file_path):
     if os.path.exists(file_path):
         os.remove(file_path)
@@ -228,27 +467,18 @@ class SpriteItem:
         palette_compression = self.__palette_compression
 
         if tiles_compression.startswith('auto'):
-            test_huffman = tiles_compression == 'auto'
-            tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression, 'none', None)
-            tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression, 'run_length',
-                                                                         file_size)
-            tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression, 'lz77', file_size)
+            file_size = None
 
-            if test_huffman:
-                tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression, 'huffman',
-                                                                             file_size)
+            for test_compression in auto_compressions(tiles_compression):
+                tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression,
+                                                                             test_compression, file_size)
 
         if palette_compression.startswith('auto'):
-            test_huffman = palette_compression == 'auto'
-            palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'none', None)
-            palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'run_length',
-                                                                             file_size)
-            palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'lz77',
-                                                                             file_size)
+            file_size = None
 
-            if test_huffman:
-                palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'huffman',
-                                                                                 file_size)
+            for test_compression in auto_compressions(palette_compression):
+                palette_compression, file_size = self.__test_palette_compression(grit, palette_compression,
+                                                                                 test_compression, file_size)
 
         self.__execute_command(grit, tiles_compression, palette_compression)
         return self.__write_header(tiles_compression, palette_compression, False)
@@ -355,6 +585,10 @@ class SpriteItem:
         except subprocess.CalledProcessError as e:
             raise ValueError(grit + ' call failed (return code ' + str(e.returncode) + '): ' + str(e.output))
 
+        grit_file_path = self.__build_folder_path + '/' + self.__file_name_no_ext + '_bn_gfx.h'
+        apply_compression(grit_file_path, 'Tiles', tiles_compression)
+        apply_compression(grit_file_path, 'Pal', palette_compression)
+
 
 class SpriteTilesItem:
 
@@ -401,13 +635,10 @@ class SpriteTilesItem:
         compression = self.__compression
 
         if compression.startswith('auto'):
-            test_huffman = compression == 'auto'
-            compression, file_size = self.__test_compression(grit, compression, 'none', None)
-            compression, file_size = self.__test_compression(grit, compression, 'run_length', file_size)
-            compression, file_size = self.__test_compression(grit, compression, 'lz77', file_size)
+            file_size = None
 
-            if test_huffman:
-                compression, file_size = self.__test_compression(grit, compression, 'huffman', file_size)
+            for test_compression in auto_compressions(compression):
+                compression, file_size = self.__test_compression(grit, compression, test_compression, file_size)
 
         self.__execute_command(grit, compression)
         return self.__write_header(compression, False)
@@ -501,6 +732,9 @@ class SpriteTilesItem:
         except subprocess.CalledProcessError as e:
             raise ValueError(grit + ' call failed (return code ' + str(e.returncode) + '): ' + str(e.output))
 
+        grit_file_path = self.__build_folder_path + '/' + self.__file_name_no_ext + '_bn_gfx.h'
+        apply_compression(grit_file_path, 'Tiles', compression)
+
 
 class SpritePaletteItem:
 
@@ -522,13 +756,10 @@ class SpritePaletteItem:
         compression = self.__compression
 
         if compression.startswith('auto'):
-            test_huffman = compression == 'auto'
-            compression, file_size = self.__test_compression(grit, compression, 'none', None)
-            compression, file_size = self.__test_compression(grit, compression, 'run_length', file_size)
-            compression, file_size = self.__test_compression(grit, compression, 'lz77', file_size)
+            file_size = None
 
-            if test_huffman:
-                compression, file_size = self.__test_compression(grit, compression, 'huffman', file_size)
+            for test_compression in auto_compressions(compression):
+                compression, file_size = self.__test_compression(grit, compression, test_compression, file_size)
 
         self.__execute_command(grit, compression)
         return self.__write_header(compression, False)
@@ -602,6 +833,9 @@ class SpritePaletteItem:
         except subprocess.CalledProcessError as e:
             raise ValueError(grit + ' call failed (return code ' + str(e.returncode) + '): ' + str(e.output))
 
+        grit_file_path = self.__build_folder_path + '/' + self.__file_name_no_ext + '_bn_gfx.h'
+        apply_compression(grit_file_path, 'Pal', compression)
+
 
 class RegularBgItem:
 
@@ -739,36 +973,25 @@ class RegularBgItem:
         map_compression = self.__map_compression
 
         if tiles_compression.startswith('auto'):
-            test_huffman = tiles_compression == 'auto'
-            tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression, 'none', None)
-            tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression, 'run_length',
-                                                                         file_size)
-            tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression, 'lz77', file_size)
+            file_size = None
 
-            if test_huffman:
-                tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression, 'huffman',
-                                                                             file_size)
+            for test_compression in auto_compressions(tiles_compression):
+                tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression,
+                                                                             test_compression, file_size)
 
         if palette_compression.startswith('auto'):
-            test_huffman = palette_compression == 'auto'
-            palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'none', None)
-            palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'run_length',
-                                                                             file_size)
-            palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'lz77',
-                                                                             file_size)
+            file_size = None
 
-            if test_huffman:
-                palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'huffman',
-                                                                                 file_size)
+            for test_compression in auto_compressions(palette_compression):
+                palette_compression, file_size = self.__test_palette_compression(grit, palette_compression,
+                                                                                 test_compression, file_size)
 
         if map_compression.startswith('auto'):
-            test_huffman = map_compression == 'auto'
-            map_compression, file_size = self.__test_map_compression(grit, map_compression, 'none', None)
-            map_compression, file_size = self.__test_map_compression(grit, map_compression, 'run_length', file_size)
-            map_compression, file_size = self.__test_map_compression(grit, map_compression, 'lz77', file_size)
+            file_size = None
 
-            if test_huffman:
-                map_compression, file_size = self.__test_map_compression(grit, map_compression, 'huffman', file_size)
+            for test_compression in auto_compressions(map_compression):
+                map_compression, file_size = self.__test_map_compression(grit, map_compression,
+                                                                         test_compression, file_size)
 
         self.__execute_command(grit, tiles_compression, palette_compression, map_compression)
         return self.__write_header(tiles_compression, palette_compression, map_compression, False)
@@ -861,7 +1084,7 @@ class RegularBgItem:
         header_file += '    constexpr inline regular_bg_item ' + name + '(' + '\n            ' + \
                        'regular_bg_tiles_item(span<const tile>(' + name + '_bn_gfxTiles, ' + \
                        str(tiles_count) + '), ' + bpp_mode_label + ', ' + compression_label(tiles_compression) + \
-                       '), ' + '\n            '
+                       ', ' + tiles_content_hash_label(grit_data, name) + '), ' + '\n            '
 
         if self.__palette_item is None:
             header_file += 'bg_palette_item(span<const color>(' + name + '_bn_gfxPal, ' + \
@@ -928,6 +1151,11 @@ class RegularBgItem:
         except subprocess.CalledProcessError as e:
             raise ValueError(grit + ' call failed (return code ' + str(e.returncode) + '): ' + str(e.output))
 
+        grit_file_path = self.__build_folder_path + '/' + self.__file_name_no_ext + '_bn_gfx.h'
+        apply_compression(grit_file_path, 'Tiles', tiles_compression)
+        apply_compression(grit_file_path, 'Pal', palette_compression)
+        apply_compression(grit_file_path, 'Map', map_compression)
+
 
 class RegularBgTilesItem:
 
@@ -966,27 +1194,18 @@ class RegularBgTilesItem:
         palette_compression = self.__palette_compression
 
         if tiles_compression.startswith('auto'):
-            test_huffman = tiles_compression == 'auto'
-            tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression, 'none', None)
-            tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression, 'run_length',
-                                                                         file_size)
-            tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression, 'lz77', file_size)
+            file_size = None
 
-            if test_huffman:
-                tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression, 'huffman',
-                                                                             file_size)
+            for test_compression in auto_compressions(tiles_compression):
+                tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression,
+                                                                             test_compression, file_size)
 
         if palette_compression.startswith('auto'):
-            test_huffman = palette_compression == 'auto'
-            palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'none', None)
-            palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'run_length',
-                                                                             file_size)
-            palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'lz77',
-                                                                             file_size)
+            file_size = None
 
-            if test_huffman:
-                palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'huffman',
-                                                                                 file_size)
+            for test_compression in auto_compressions(palette_compression):
+                palette_compression, file_size = self.__test_palette_compression(grit, palette_compression,
+                                                                                 test_compression, file_size)
 
         self.__execute_command(grit, tiles_compression, palette_compression)
         return self.__write_header(tiles_compression, palette_compression, False)
@@ -1067,7 +1286,7 @@ class RegularBgTilesItem:
         header_file += '    constexpr inline regular_bg_tiles_item ' + name + '(' + '\n            ' + \
                        'span<const tile>(' + name + '_bn_gfxTiles, ' + \
                        str(tiles_count) + '), ' + bpp_mode_label + ', ' + compression_label(tiles_compression) + \
-                       ');' + '\n'
+                       ', ' + tiles_content_hash_label(grit_data, name) + ');' + '\n'
 
         if self.__generate_palette:
             header_file += '\n'
@@ -1109,6 +1328,10 @@ class RegularBgTilesItem:
         except subprocess.CalledProcessError as e:
             raise ValueError(grit + ' call failed (return code ' + str(e.returncode) + '): ' + str(e.output))
 
+        grit_file_path = self.__build_folder_path + '/' + self.__file_name_no_ext + '_bn_gfx.h'
+        apply_compression(grit_file_path, 'Tiles', tiles_compression)
+        apply_compression(grit_file_path, 'Pal', palette_compression)
+
 
 class AffineBgItem:
 
@@ -1218,36 +1441,25 @@ class AffineBgItem:
         map_compression = self.__map_compression
 
         if tiles_compression.startswith('auto'):
-            test_huffman = tiles_compression == 'auto'
-            tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression, 'none', None)
-            tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression, 'run_length',
-                                                                         file_size)
-            tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression, 'lz77', file_size)
+            file_size = None
 
-            if test_huffman:
-                tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression, 'huffman',
-                                                                             file_size)
+            for test_compression in auto_compressions(tiles_compression):
+                tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression,
+                                                                             test_compression, file_size)
 
         if palette_compression.startswith('auto'):
-            test_huffman = palette_compression == 'auto'
-            palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'none', None)
-            palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'run_length',
-                                                                             file_size)
-            palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'lz77',
-                                                                             file_size)
+            file_size = None
 
-            if test_huffman:
-                palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'huffman',
-                                                                                 file_size)
+            for test_compression in auto_compressions(palette_compression):
+                palette_compression, file_size = self.__test_palette_compression(grit, palette_compression,
+                                                                                 test_compression, file_size)
 
         if map_compression.startswith('auto'):
-            test_huffman = map_compression == 'auto'
-            map_compression, file_size = self.__test_map_compression(grit, map_compression, 'none', None)
-            map_compression, file_size = self.__test_map_compression(grit, map_compression, 'run_length', file_size)
-            map_compression, file_size = self.__test_map_compression(grit, map_compression, 'lz77', file_size)
+            file_size = None
 
-            if test_huffman:
-                map_compression, file_size = self.__test_map_compression(grit, map_compression, 'huffman', file_size)
+            for test_compression in auto_compressions(map_compression):
+                map_compression, file_size = self.__test_map_compression(grit, map_compression,
+                                                                         test_compression, file_size)
 
         self.__execute_command(grit, tiles_compression, palette_compression, map_compression)
         return self.__write_header(tiles_compression, palette_compression, map_compression, False)
@@ -1331,8 +1543,8 @@ class AffineBgItem:
         header_file += '{' + '\n'
         header_file += '    constexpr inline affine_bg_item ' + name + '(' + '\n            ' + \
                        'affine_bg_tiles_item(span<const tile>(' + name + '_bn_gfxTiles, ' + \
-                       str(tiles_count) + '), ' + compression_label(tiles_compression) + \
-                       '), ' + '\n            '
+                       str(tiles_count) + '), ' + compression_label(tiles_compression) + ', ' + \
+                       tiles_content_hash_label(grit_data, name) + '), ' + '\n            '
 
         if self.__palette_item is None:
             header_file += 'bg_palette_item(span<const color>(' + name + '_bn_gfxPal, ' + \
@@ -1378,6 +1590,11 @@ class AffineBgItem:
         except subprocess.CalledProcessError as e:
             raise ValueError(grit + ' call failed (return code ' + str(e.returncode) + '): ' + str(e.output))
 
+        grit_file_path = self.__build_folder_path + '/' + self.__file_name_no_ext + '_bn_gfx.h'
+        apply_compression(grit_file_path, 'Tiles', tiles_compression)
+        apply_compression(grit_file_path, 'Pal', palette_compression)
+        apply_compression(grit_file_path, 'Map', map_compression)
+
 
 class AffineBgTilesItem:
 
@@ -1415,27 +1632,18 @@ class AffineBgTilesItem:
         palette_compression = self.__palette_compression
 
         if tiles_compression.startswith('auto'):
-            test_huffman = tiles_compression == 'auto'
-            tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression, 'none', None)
-            tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression, 'run_length',
-                                                                         file_size)
-            tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression, 'lz77', file_size)
+            file_size = None
 
-            if test_huffman:
-                tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression, 'huffman',
-                                                                             file_size)
+            for test_compression in auto_compressions(tiles_compression):
+                tiles_compression, file_size = self.__test_tiles_compression(grit, tiles_compression,
+                                                                             test_compression, file_size)
 
         if palette_compression.startswith('auto'):
-            test_huffman = palette_compression == 'auto'
-            palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'none', None)
-            palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'run_length',
-                                                                             file_size)
-            palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'lz77',
-                                                                             file_size)
+            file_size = None
 
-            if test_huffman:
-                palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'huffman',
-                                                                                 file_size)
+            for test_compression in auto_compressions(palette_compression):
+                palette_compression, file_size = self.__test_palette_compression(grit, palette_compression,
+                                                                                 test_compression, file_size)
 
         self.__execute_command(grit, tiles_compression, palette_compression)
         return self.__write_header(tiles_compression, palette_compression, False)
@@ -1514,8 +1722,8 @@ class AffineBgTilesItem:
         header_file += '{' + '\n'
         header_file += '    constexpr inline affine_bg_tiles_item ' + name + '(' + '\n            ' + \
                        'span<const tile>(' + name + '_bn_gfxTiles, ' + \
-                       str(tiles_count) + '), ' + compression_label(tiles_compression) + \
-                       ');' + '\n'
+                       str(tiles_count) + '), ' + compression_label(tiles_compression) + ', ' + \
+                       tiles_content_hash_label(grit_data, name) + ');' + '\n'
 
         if self.__generate_palette:
             header_file += '\n'
@@ -1551,6 +1759,10 @@ class AffineBgTilesItem:
         except subprocess.CalledProcessError as e:
             raise ValueError(grit + ' call failed (return code ' + str(e.returncode) + '): ' + str(e.output))
 
+        grit_file_path = self.__build_folder_path + '/' + self.__file_name_no_ext + '_bn_gfx.h'
+        apply_compression(grit_file_path, 'Tiles', tiles_compression)
+        apply_compression(grit_file_path, 'Pal', palette_compression)
+
 
 class PaletteBitmapItem:
 
@@ -1586,27 +1798,18 @@ class PaletteBitmapItem:
         palette_compression = self.__palette_compression
 
         if pixels_compression.startswith('auto'):
-            test_huffman = pixels_compression == 'auto'
-            pixels_compression, file_size = self.__test_pixels_compression(grit, pixels_compression, 'none', None)
-            pixels_compression, file_size = self.__test_pixels_compression(grit, pixels_compression, 'run_length',
-                                                                           file_size)
-            pixels_compression, file_size = self.__test_pixels_compression(grit, pixels_compression, 'lz77', file_size)
+            file_size = None
 
-            if test_huffman:
-                pixels_compression, file_size = self.__test_pixels_compression(grit, pixels_compression, 'huffman',
-                                                                               file_size)
+            for test_compression in auto_compressions(pixels_compression):
+                pixels_compression, file_size = self.__test_pixels_compression(grit, pixels_compression,
+                                                                               test_compression, file_size)
 
         if palette_compression.startswith('auto'):
-            test_huffman = palette_compression == 'auto'
-            palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'none', None)
-            palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'run_length',
-                                                                             file_size)
-            palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'lz77',
-                                                                             file_size)
+            file_size = None
 
-            if test_huffman:
-                palette_compression, file_size = self.__test_palette_compression(grit, palette_compression, 'huffman',
-                                                                                 file_size)
+            for test_compression in auto_compressions(palette_compression):
+                palette_compression, file_size = self.__test_palette_compression(grit, palette_compression,
+                                                                                 test_compression, file_size)
 
         self.__execute_command(grit, pixels_compression, palette_compression)
         return self.__write_header(pixels_compression, palette_compression, False)
@@ -1691,6 +1894,10 @@ class PaletteBitmapItem:
         except subprocess.CalledProcessError as e:
             raise ValueError(grit + ' call failed (return code ' + str(e.returncode) + '): ' + str(e.output))
 
+        grit_file_path = self.__build_folder_path + '/' + self.__file_name_no_ext + '_bn_gfx.h'
+        apply_compression(grit_file_path, 'Bitmap', tiles_compression)
+        apply_compression(grit_file_path, 'Pal', palette_compression)
+
 
 class PaletteBitmapPixelsItem:
 
@@ -1710,13 +1917,10 @@ class PaletteBitmapPixelsItem:
         compression = self.__compression
 
         if compression.startswith('auto'):
-            test_huffman = compression == 'auto'
-            compression, file_size = self.__test_compression(grit, compression, 'none', None)
-            compression, file_size = self.__test_compression(grit, compression, 'run_length', file_size)
-            compression, file_size = self.__test_compression(grit, compression, 'lz77', file_size)
+            file_size = None
 
-            if test_huffman:
-                compression, file_size = self.__test_compression(grit, compression, 'huffman', file_size)
+            for test_compression in auto_compressions(compression):
+                compression, file_size = self.__test_compression(grit, compression, test_compression, file_size)
 
         self.__execute_command(grit, compression)
         return self.__write_header(compression, False)
@@ -1786,6 +1990,9 @@ class PaletteBitmapPixelsItem:
         except subprocess.CalledProcessError as e:
             raise ValueError(grit + ' call failed (return code ' + str(e.returncode) + '): ' + str(e.output))
 
+        grit_file_path = self.__build_folder_path + '/' + self.__file_name_no_ext + '_bn_gfx.h'
+        apply_compression(grit_file_path, 'Bitmap', compression)
+
 
 class DirectBitmapItem:
 
@@ -1805,13 +2012,10 @@ class DirectBitmapItem:
         compression = self.__compression
 
         if compression.startswith('auto'):
-            test_huffman = compression == 'auto'
-            compression, file_size = self.__test_compression(grit, compression, 'none', None)
-            compression, file_size = self.__test_compression(grit, compression, 'run_length', file_size)
-            compression, file_size = self.__test_compression(grit, compression, 'lz77', file_size)
+            file_size = None
 
-            if test_huffman:
-                compression, file_size = self.__test_compression(grit, compression, 'huffman', file_size)
+            for test_compression in auto_compressions(compression):
+                compression, file_size = self.__test_compression(grit, compression, test_compression, file_size)
 
         self.__execute_command(grit, compression)
         return self.__write_header(compression, False)
@@ -1881,6 +2085,9 @@ class DirectBitmapItem:
         except subprocess.CalledProcessError as e:
             raise ValueError(grit + ' call failed (return code ' + str(e.returncode) + '): ' + str(e.output))
 
+        grit_file_path = self.__build_folder_path + '/' + self.__file_name_no_ext + '_bn_gfx.h'
+        apply_compression(grit_file_path, 'Bitmap', compression)
+
 
 class BgPaletteItem:
 
@@ -1902,13 +2109,10 @@ class BgPaletteItem:
         compression = self.__compression
 
         if compression.startswith('auto'):
-            test_huffman = compression == 'auto'
-            compression, file_size = self.__test_compression(grit, compression, 'none', None)
-            compression, file_size = self.__test_compression(grit, compression, 'run_length', file_size)
-            compression, file_size = self.__test_compression(grit, compression, 'lz77', file_size)
+            file_size = None
 
-            if test_huffman:
-                compression, file_size = self.__test_compression(grit, compression, 'huffman', file_size)
+            for test_compression in auto_compressions(compression):
+                compression, file_size = self.__test_compression(grit, compression, test_compression, file_size)
 
         self.__execute_command(grit, compression)
         return self.__write_header(compression, False)
@@ -1982,6 +2186,199 @@ class BgPaletteItem:
         except subprocess.CalledProcessError as e:
             raise ValueError(grit + ' call failed (return code ' + str(e.returncode) + '): ' + str(e.output))
 
+        grit_file_path = self.__build_folder_path + '/' + self.__file_name_no_ext + '_bn_gfx.h'
+        apply_compression(grit_file_path, 'Pal', compression)
+
+
+class PaletteAnimationItem:
+
+    def __init__(self, file_path, file_name_no_ext, build_folder_path, info):
+        bmp = BMP(file_path)
+        self.__file_name_no_ext = file_name_no_ext
+        self.__build_folder_path = build_folder_path
+
+        try:
+            self.__colors_count = int(info['colors_count'])
+        except KeyError:
+            raise ValueError('colors_count field not found in graphics json file: ' + file_name_no_ext + '.json')
+
+        if self.__colors_count < 1 or self.__colors_count > 128:
+            raise ValueError('Invalid colors count: ' + str(self.__colors_count))
+
+        try:
+            self.__first_color_index = int(info['first_color_index'])
+        except KeyError:
+            self.__first_color_index = 0
+
+        if self.__first_color_index < 0 or self.__first_color_index + self.__colors_count > 256:
+            raise ValueError('Invalid first color index: ' + str(self.__first_color_index))
+
+        try:
+            self.__loop = bool(info['loop'])
+        except KeyError:
+            self.__loop = True
+
+        try:
+            self.__interpolation = str(info['interpolation'])
+        except KeyError:
+            self.__interpolation = 'linear'
+
+        if self.__interpolation != 'linear' and self.__interpolation != 'step':
+            raise ValueError('Invalid interpolation: ' + self.__interpolation)
+
+        palette_colors = bmp.palette_colors()
+
+        try:
+            keyframes_count = int(info['keyframes'])
+        except KeyError:
+            raise ValueError('keyframes field not found in graphics json file: ' + file_name_no_ext + '.json')
+
+        if keyframes_count < 2 or keyframes_count * self.__colors_count > len(palette_colors):
+            raise ValueError('Invalid keyframes count: ' + str(keyframes_count) + ' (palette colors count: ' +
+                             str(len(palette_colors)) + ')')
+
+        self.__keyframes = []
+
+        for keyframe_index in range(keyframes_count):
+            first_color = keyframe_index * self.__colors_count
+            self.__keyframes.append(palette_colors[first_color:first_color + self.__colors_count])
+
+        # Durations are the number of frames from each keyframe to the next one:
+        segments_count = keyframes_count if self.__loop else keyframes_count - 1
+
+        try:
+            durations = info['durations']
+        except KeyError:
+            raise ValueError('durations field not found in graphics json file: ' + file_name_no_ext + '.json')
+
+        if isinstance(durations, list):
+            self.__durations = [int(duration) for duration in durations]
+
+            if len(self.__durations) != segments_count:
+                raise ValueError('Invalid durations count: ' + str(len(self.__durations)) + ' - ' +
+                                 str(segments_count))
+        else:
+            self.__durations = [int(durations)] * segments_count
+
+        for duration in self.__durations:
+            if duration < 1:
+                raise ValueError('Invalid duration: ' + str(duration))
+
+    def process(self, grit):
+        states = self.__interpolate_states()
+        colors = []
+        frames = []
+
+        def append_frame(first_index, count, new_state):
+            frames.append([len(colors), self.__first_color_index + first_index, count])
+            colors.extend(new_state[first_index:first_index + count])
+
+        def append_delta_frame(old_state, new_state):
+            changed_indexes = [index for index in range(self.__colors_count) if old_state[index] != new_state[index]]
+
+            if len(changed_indexes) > 0:
+                first_index = changed_indexes[0]
+                append_frame(first_index, changed_indexes[-1] - first_index + 1, new_state)
+            else:
+                frames.append([len(colors), self.__first_color_index, 0])
+
+        append_frame(0, self.__colors_count, states[0])
+
+        for state_index in range(1, len(states)):
+            append_delta_frame(states[state_index - 1], states[state_index])
+
+        if self.__loop:
+            append_delta_frame(states[-1], states[0])
+
+        if len(colors) > 65535:
+            raise ValueError('Too many animation colors: ' + str(len(colors)))
+
+        if len(frames) > 32767:
+            raise ValueError('Too many animation frames: ' + str(len(frames)))
+
+        return self.__write_header(colors, frames)
+
+    def __interpolate_states(self):
+        keyframes = self.__keyframes
+        keyframes_count = len(keyframes)
+        linear = self.__interpolation == 'linear'
+        states = []
+
+        for segment_index, duration in enumerate(self.__durations):
+            first_keyframe = keyframes[segment_index]
+            second_keyframe = keyframes[(segment_index + 1) % keyframes_count]
+
+            for step in range(duration):
+                if linear:
+                    states.append([self.__interpolate_color(first_color, second_color, step, duration)
+                                   for first_color, second_color in zip(first_keyframe, second_keyframe)])
+                else:
+                    states.append(first_keyframe)
+
+        if not self.__loop:
+            states.append(keyframes[-1])
+
+        return states
+
+    @staticmethod
+    def __interpolate_color(first_color, second_color, step, duration):
+        result = 0
+
+        for shift in (0, 5, 10):
+            first_value = (first_color >> shift) & 31
+            second_value = (second_color >> shift) & 31
+            value = ((first_value * (duration - step)) + (second_value * step) + (duration // 2)) // duration
+            result |= value << shift
+
+        return result
+
+    def __write_header(self, colors, frames):
+        name = self.__file_name_no_ext
+        header_file_path = self.__build_folder_path + '/bn_palette_animation_items_' + name + '.h'
+        colors_per_line = 6
+        colors_text = ''
+
+        for index in range(0, len(colors), colors_per_line):
+            colors_text += '        ' + ', '.join('color(0x%04X)' % color
+                                                  for color in colors[index:index + colors_per_line]) + ',\n'
+
+        frames_per_line = 4
+        frames_text = ''
+
+        for index in range(0, len(frames), frames_per_line):
+            frames_text += '        ' + ', '.join('{ ' + str(frame[0]) + ', ' + str(frame[1]) + ', ' +
+                                                  str(frame[2]) + ' }'
+                                                  for frame in frames[index:index + frames_per_line]) + ',\n'
+
+        include_guard = 'BN_PALETTE_ANIMATION_ITEMS_' + name.upper() + '_H'
+        header_file = '#ifndef ' + include_guard + '\n'
+        header_file += '#define ' + include_guard + '\n'
+        header_file += '\n'
+        header_file += '#include "bn_palette_animation_item.h"' + '\n'
+        header_file += '\n'
+        header_file += 'namespace bn::palette_animation_items' + '\n'
+        header_file += '{' + '\n'
+        header_file += '    constexpr inline color ' + name + '_colors[] = {' + '\n'
+        header_file += colors_text
+        header_file += '    };' + '\n'
+        header_file += '\n'
+        header_file += '    constexpr inline palette_animation_item::frame ' + name + '_frames[] = {' + '\n'
+        header_file += frames_text
+        header_file += '    };' + '\n'
+        header_file += '\n'
+        header_file += '    constexpr inline palette_animation_item ' + name + '(' + \
+                       name + '_colors, ' + name + '_frames, ' + ('true' if self.__loop else 'false') + ');' + '\n'
+        header_file += '}' + '\n'
+        header_file += '\n'
+        header_file += '#endif' + '\n'
+        header_file += '\n'
+
+        file_tools.write_file_if_changed(header_file_path, header_file)
+
+        # Colors and frames (4 bytes per frame):
+        total_size = (len(colors) * 2) + (len(frames) * 4)
+        return total_size, header_file_path
+
 
 class GraphicsFileInfo:
 
@@ -2030,6 +2427,8 @@ class GraphicsFileInfo:
                 item = DirectBitmapItem(self.__file_path, self.__file_name_no_ext, build_folder_path, info)
             elif graphics_type == 'bg_palette':
                 item = BgPaletteItem(self.__file_path, self.__file_name_no_ext, build_folder_path, info)
+            elif graphics_type == 'palette_animation':
+                item = PaletteAnimationItem(self.__file_path, self.__file_name_no_ext, build_folder_path, info)
             else:
                 raise ValueError('Unknown graphics type "' + graphics_type +
                                  '" found in graphics json file: ' + self.__json_file_path)
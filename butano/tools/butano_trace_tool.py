@@ -0,0 +1,113 @@
+"""
+Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+zlib License, see LICENSE file.
+"""
+
+import argparse
+import json
+import sys
+import traceback
+
+
+class TraceConverter:
+
+    def __init__(self):
+        self.__ticks_per_second = None
+        self.__names = {}
+        self.__events = []
+        self.__last_ticks = None
+        self.__ticks_offset = 0
+        self.__dropped_events_count = 0
+
+    def process_line(self, line):
+        # Markers are searched anywhere in the line to skip log backend prefixes (like "[INFO] GBA Debug: "):
+        index = line.find('bn_trace')
+
+        if index < 0:
+            return
+
+        tokens = line[index:].split()
+        marker = tokens[0]
+
+        if marker == 'bn_trace_start':
+            self.__ticks_per_second = int(tokens[1])
+        elif marker == 'bn_trace_name':
+            self.__names[int(tokens[1])] = ' '.join(tokens[2:])
+        elif marker == 'bn_trace_dropped':
+            self.__dropped_events_count += int(tokens[1])
+        elif marker == 'bn_trace':
+            for token in tokens[1:]:
+                self.__process_event(token)
+
+    def write(self, output_file_path):
+        if self.__ticks_per_second is None:
+            raise ValueError('Trace start not found (is BN_CFG_PROFILER_TRACE_ENABLED set?)')
+
+        trace_events = [{'name': 'thread_name', 'ph': 'M', 'pid': 0, 'tid': 0, 'args': {'name': 'GBA'}}]
+        microseconds_per_tick = 1000000 / self.__ticks_per_second
+
+        for event_type, slot, ticks in self.__events:
+            trace_event = {'ph': event_type, 'ts': ticks * microseconds_per_tick, 'pid': 0, 'tid': 0}
+
+            if event_type == 'i':
+                trace_event['name'] = 'frame'
+                trace_event['s'] = 'g'
+            else:
+                trace_event['name'] = self.__names.get(slot, 'slot_' + str(slot))
+
+            trace_events.append(trace_event)
+
+        with open(output_file_path, 'w') as output_file:
+            json.dump({'traceEvents': trace_events, 'displayTimeUnit': 'ms'}, output_file)
+
+        print('Trace events: ' + str(len(self.__events)))
+
+        if self.__dropped_events_count:
+            print('Dropped trace events (increase BN_CFG_PROFILER_TRACE_MAX_EVENTS): ' +
+                  str(self.__dropped_events_count))
+
+    def __process_event(self, token):
+        event_id, ticks_text = token.split(':')
+        ticks = int(ticks_text)
+
+        # Timer ticks are 32-bit, so wrap arounds are unwrapped here:
+        if self.__last_ticks is not None and ticks < self.__last_ticks:
+            self.__ticks_offset += 1 << 32
+
+        self.__last_ticks = ticks
+        ticks += self.__ticks_offset
+
+        if event_id == 'F':
+            self.__events.append(('i', None, ticks))
+        elif event_id[0] == 'B':
+            self.__events.append(('B', int(event_id[1:]), ticks))
+        elif event_id[0] == 'E':
+            self.__events.append(('E', int(event_id[1:]), ticks))
+        else:
+            raise ValueError('Invalid trace event: ' + token)
+
+
+def process_trace(input_file_path, output_file_path):
+    converter = TraceConverter()
+
+    with open(input_file_path, 'r', errors='replace') as input_file:
+        for line in input_file:
+            converter.process_line(line)
+
+    converter.write(output_file_path)
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(
+        description='Butano trace tool: converts profiler trace logs to Chrome trace JSON files '
+                    '(they can be opened with Perfetto or chrome://tracing).')
+    parser.add_argument('--input', required=True, help='emulator log file path')
+    parser.add_argument('--output', required=True, help='output JSON file path')
+
+    try:
+        args = parser.parse_args()
+        process_trace(args.input, args.output)
+    except Exception as ex:
+        sys.stderr.write('Error: ' + str(ex) + '\n')
+        traceback.print_exc()
+        exit(-1)
@@ -319,6 +319,78 @@ namespace
         }
     }
 
+    void sprites_animation_group_scene(bn::sprite_text_generator& text_generator)
+    {
+        constexpr bn::string_view info_text_lines[] = {
+            "PAD: change sprites direction",
+            "",
+            "START: go to next scene",
+        };
+
+        common::info info("Sprites animation group", info_text_lines, text_generator);
+
+        constexpr int columns = 6;
+        constexpr int rows = 4;
+        bn::vector<bn::sprite_ptr, columns * rows> ninja_sprites;
+
+        for(int row = 0; row < rows; ++row)
+        {
+            for(int column = 0; column < columns; ++column)
+            {
+                ninja_sprites.push_back(bn::sprite_items::ninja.create_sprite(
+                                            (column - (columns / 2)) * 32 + 16, (row - (rows / 2)) * 32 + 16));
+            }
+        }
+
+        // All sprites share the same clock and the same tile set:
+        bn::sprite_animate_group<4, columns * rows> group = bn::create_sprite_animate_group_forever<columns * rows>(
+                    16, bn::sprite_items::ninja.tiles_item(), 0, 1, 2, 3);
+
+        for(const bn::sprite_ptr& ninja_sprite : ninja_sprites)
+        {
+            group.add_sprite(ninja_sprite);
+        }
+
+        while(! bn::keypad::start_pressed())
+        {
+            int first_graphics_index = -1;
+
+            if(bn::keypad::left_pressed())
+            {
+                first_graphics_index = 8;
+            }
+            else if(bn::keypad::right_pressed())
+            {
+                first_graphics_index = 12;
+            }
+
+            if(bn::keypad::up_pressed())
+            {
+                first_graphics_index = 4;
+            }
+            else if(bn::keypad::down_pressed())
+            {
+                first_graphics_index = 0;
+            }
+
+            if(first_graphics_index >= 0)
+            {
+                group = bn::create_sprite_animate_group_forever<columns * rows>(
+                            16, bn::sprite_items::ninja.tiles_item(), first_graphics_index, first_graphics_index + 1,
+                            first_graphics_index + 2, first_graphics_index + 3);
+
+                for(const bn::sprite_ptr& ninja_sprite : ninja_sprites)
+                {
+                    group.add_sprite(ninja_sprite);
+                }
+            }
+
+            group.update();
+            info.update();
+            bn::core::update();
+        }
+    }
+
     void sprites_rotation_scene(bn::sprite_text_generator& text_generator)
     {
         constexpr bn::string_view info_text_lines[] = {
@@ -1218,6 +1290,9 @@ int main()
         sprites_animation_actions_scene(text_generator);
         bn::core::update();
 
+        sprites_animation_group_scene(text_generator);
+        bn::core::update();
+
         sprites_rotation_scene(text_generator);
         bn::core::update();
 
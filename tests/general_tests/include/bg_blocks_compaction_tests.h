@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef BG_BLOCKS_COMPACTION_TESTS_H
+#define BG_BLOCKS_COMPACTION_TESTS_H
+
+#include "bn_core.h"
+#include "bn_color.h"
+#include "bn_bg_maps.h"
+#include "bn_bg_tiles.h"
+#include "bn_optional.h"
+#include "bn_bg_palette_ptr.h"
+#include "bn_bg_palette_item.h"
+#include "bn_regular_bg_map_ptr.h"
+#include "bn_regular_bg_map_item.h"
+#include "bn_regular_bg_tiles_ptr.h"
+#include "bn_regular_bg_tiles_item.h"
+#include "bn_regular_bg_map_cell_info.h"
+#include "tests.h"
+
+#include "../../butano/hw/include/bn_hw_bg_blocks.h"
+
+class bg_blocks_compaction_tests : public tests
+{
+
+public:
+    bg_blocks_compaction_tests() :
+        tests("bg_blocks_compaction")
+    {
+        for(uint32_t& tile_data : _removed_tiles[0].data)
+        {
+            tile_data = 0x11111111;
+        }
+
+        for(int tile_index = 0; tile_index < _tiles_count; ++tile_index)
+        {
+            for(uint32_t& tile_data : _tiles[tile_index].data)
+            {
+                tile_data = 0x01010101 * unsigned(tile_index + 2);
+            }
+        }
+
+        for(int cell_index = 0; cell_index < _cells_count; ++cell_index)
+        {
+            _cells[cell_index] = bn::regular_bg_map_cell(cell_index % _tiles_count);
+        }
+
+        // Merge the free blocks left by previous tests:
+        bn::bg_tiles::compact();
+        bn::core::update();
+
+        _test_compaction();
+
+        // Tiles and map cells must outlive the removed items until they are freed:
+        bn::core::update();
+    }
+
+private:
+    static constexpr int _tiles_count = 4;
+    static constexpr int _map_size = 32;
+    static constexpr int _cells_count = _map_size * _map_size;
+
+    alignas(int) bn::tile _removed_tiles[1];
+    alignas(int) bn::tile _tiles[_tiles_count];
+    alignas(int) bn::regular_bg_map_cell _cells[_cells_count];
+
+    void _test_compaction() const
+    {
+        bn::color colors[16] = {};
+        bn::bg_palette_ptr palette = bn::bg_palette_ptr::create(bn::bg_palette_item(colors, bn::bpp_mode::BPP_4));
+        bn::optional<bn::regular_bg_tiles_ptr> removed_tiles = bn::regular_bg_tiles_ptr::create(
+                    bn::regular_bg_tiles_item(_removed_tiles, bn::bpp_mode::BPP_4), false);
+
+        // Tiles with offset can be relocated to any block:
+        bn::regular_bg_tiles_ptr tiles = bn::regular_bg_tiles_ptr::create(
+                    bn::regular_bg_tiles_item(_tiles, bn::bpp_mode::BPP_4), true);
+        bn::regular_bg_map_ptr map = bn::regular_bg_map_ptr::create(
+                    bn::regular_bg_map_item(_cells[0], bn::size(_map_size, _map_size)), tiles, palette);
+        bn::core::update();
+
+        int first_id = removed_tiles->id();
+        int tiles_id = tiles.id();
+        int map_id = map.id();
+        BN_ASSERT(tiles_id == first_id + 1 && map_id == tiles_id + 1,
+                  "BG blocks not contiguous: ", first_id, " - ", tiles_id, " - ", map_id);
+
+        int old_tiles_offset = map.tiles_offset();
+        BN_ASSERT(old_tiles_offset > 0, "Invalid tiles offset: ", old_tiles_offset);
+        _check_vram(tiles_id, map_id, map);
+
+        // Removing the first tiles leaves a free block before the used ones:
+        removed_tiles.reset();
+        bn::core::update();
+
+        int available_tiles_blocks_count = bn::bg_tiles::available_blocks_count();
+        int available_map_blocks_count = bn::bg_maps::available_blocks_count();
+        bn::bg_tiles::compact();
+        BN_ASSERT(tiles.id() == first_id, "Tiles not moved: ", tiles.id());
+        BN_ASSERT(map.id() == tiles_id, "Map not moved: ", map.id());
+        BN_ASSERT(map.tiles_offset() < old_tiles_offset, "Tiles offset not updated: ", map.tiles_offset());
+        BN_ASSERT(bn::bg_tiles::available_blocks_count() == available_tiles_blocks_count,
+                  "Available tiles blocks count changed: ", bn::bg_tiles::available_blocks_count(), " - ",
+                  available_tiles_blocks_count);
+        BN_ASSERT(bn::bg_maps::available_blocks_count() == available_map_blocks_count,
+                  "Available map blocks count changed: ", bn::bg_maps::available_blocks_count(), " - ",
+                  available_map_blocks_count);
+
+        // Relocated items are moved in VRAM in the next update, with map cells offset to the new tiles position:
+        bn::core::update();
+        _check_vram(first_id, tiles_id, map);
+
+        bn::bg_tiles::compact();
+        BN_ASSERT(tiles.id() == first_id, "Tiles moved again: ", tiles.id());
+        BN_ASSERT(map.id() == tiles_id, "Map moved again: ", map.id());
+    }
+
+    void _check_vram(int tiles_block, int map_block, const bn::regular_bg_map_ptr& map) const
+    {
+        auto vram_tiles = reinterpret_cast<const volatile uint32_t*>(bn::hw::bg_blocks::vram(tiles_block));
+
+        for(int tile_index = 0; tile_index < _tiles_count; ++tile_index)
+        {
+            for(int word_index = 0; word_index < 8; ++word_index)
+            {
+                uint32_t vram_word = vram_tiles[(tile_index * 8) + word_index];
+                uint32_t expected_word = _tiles[tile_index].data[word_index];
+                BN_ASSERT(vram_word == expected_word, "Invalid VRAM tile: ", tiles_block, " - ", tile_index, " - ",
+                          vram_word, " - ", expected_word);
+            }
+        }
+
+        auto vram_cells = reinterpret_cast<const volatile uint16_t*>(bn::hw::bg_blocks::vram(map_block));
+        int tiles_offset = map.tiles_offset();
+        int palette_id = map.palette().id();
+
+        for(int cell_index = 0; cell_index < _cells_count; ++cell_index)
+        {
+            bn::regular_bg_map_cell_info cell_info(vram_cells[cell_index]);
+            int expected_tile_index = _cells[cell_index] + tiles_offset;
+            BN_ASSERT(cell_info.tile_index() == expected_tile_index, "Invalid VRAM cell: ", map_block, " - ",
+                      cell_index, " - ", cell_info.tile_index(), " - ", expected_tile_index);
+            BN_ASSERT(cell_info.palette_id() == palette_id, "Invalid VRAM cell palette: ", map_block, " - ",
+                      cell_index, " - ", cell_info.palette_id(), " - ", palette_id);
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef FRAME_ARENA_TESTS_H
+#define FRAME_ARENA_TESTS_H
+
+#include "bn_core.h"
+#include "bn_memory.h"
+#include "bn_frame_deque.h"
+#include "bn_frame_vector.h"
+#include "bn_config_memory.h"
+#include "tests.h"
+
+class frame_arena_tests : public tests
+{
+
+public:
+    frame_arena_tests() :
+        tests("frame_arena")
+    {
+        // Arenas are reset at the end of each update:
+        bn::core::update();
+        BN_ASSERT(bn::memory::used_frame_iwram() == 0);
+        BN_ASSERT(bn::memory::used_frame_ewram() == 0);
+
+        #if BN_CFG_MEMORY_FRAME_IWRAM_BYTES
+            _test_alloc(true);
+            _test_containers(true);
+        #else
+            BN_ASSERT(! bn::memory::frame_iwram_alloc(8));
+            BN_ASSERT(bn::memory::available_frame_iwram() == 0);
+        #endif
+
+        #if BN_CFG_MEMORY_FRAME_EWRAM_BYTES
+            _test_alloc(false);
+            _test_containers(false);
+        #else
+            BN_ASSERT(! bn::memory::frame_ewram_alloc(8));
+            BN_ASSERT(bn::memory::available_frame_ewram() == 0);
+        #endif
+    }
+
+private:
+    [[nodiscard]] static int _used_bytes(bool iwram)
+    {
+        return iwram ? bn::memory::used_frame_iwram() : bn::memory::used_frame_ewram();
+    }
+
+    [[nodiscard]] static int _available_bytes(bool iwram)
+    {
+        return iwram ? bn::memory::available_frame_iwram() : bn::memory::available_frame_ewram();
+    }
+
+    [[nodiscard]] static void* _alloc(int bytes, bool iwram)
+    {
+        return iwram ? bn::memory::frame_iwram_alloc(bytes) : bn::memory::frame_ewram_alloc(bytes);
+    }
+
+    static void _test_alloc(bool iwram)
+    {
+        int available_bytes = _available_bytes(iwram);
+        BN_ASSERT(available_bytes > 16);
+
+        // Allocations are 8 bytes aligned:
+        void* ptr = _alloc(4, iwram);
+        BN_ASSERT(ptr);
+        BN_ASSERT(bn::aligned<8>(ptr));
+        BN_ASSERT(_used_bytes(iwram) == 8);
+
+        void* other_ptr = _alloc(12, iwram);
+        BN_ASSERT(other_ptr);
+        BN_ASSERT(bn::aligned<8>(other_ptr));
+        BN_ASSERT(static_cast<uint8_t*>(other_ptr) == static_cast<uint8_t*>(ptr) + 8);
+        BN_ASSERT(_used_bytes(iwram) == 24);
+        BN_ASSERT(_available_bytes(iwram) == available_bytes - 24);
+
+        BN_ASSERT(! _alloc(available_bytes, iwram));
+        BN_ASSERT(_used_bytes(iwram) == 24);
+
+        bn::core::update();
+        BN_ASSERT(_used_bytes(iwram) == 0);
+        BN_ASSERT(_available_bytes(iwram) == available_bytes);
+        BN_ASSERT(iwram ? bn::memory::max_used_frame_iwram() >= 24 : bn::memory::max_used_frame_ewram() >= 24);
+
+        // Memory is reused after the reset:
+        BN_ASSERT(_alloc(4, iwram) == ptr);
+
+        bn::core::update();
+    }
+
+    static void _test_containers(bool iwram)
+    {
+        {
+            bn::frame_vector<int> vector(4, iwram);
+            BN_ASSERT(vector.max_size() == 4);
+            BN_ASSERT(_used_bytes(iwram) == 16);
+
+            for(int index = 0; index < 4; ++index)
+            {
+                vector.push_back(index);
+            }
+
+            BN_ASSERT(vector.full());
+            BN_ASSERT(vector[0] == 0 && vector[3] == 3);
+
+            bn::frame_deque<int> deque(2, iwram);
+            BN_ASSERT(_used_bytes(iwram) == 24);
+
+            deque.push_back(1);
+            deque.push_front(0);
+            BN_ASSERT(deque.full());
+            BN_ASSERT(deque.front() == 0 && deque.back() == 1);
+        }
+
+        // Containers must be destroyed before the arena is reset:
+        bn::core::update();
+        BN_ASSERT(_used_bytes(iwram) == 0);
+    }
+};
+
+#endif
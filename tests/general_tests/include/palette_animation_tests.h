@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef PALETTE_ANIMATION_TESTS_H
+#define PALETTE_ANIMATION_TESTS_H
+
+#include "bn_core.h"
+#include "bn_colors.h"
+#include "bn_bg_palette_ptr.h"
+#include "bn_bg_palette_item.h"
+#include "bn_palette_animation_item.h"
+#include "tests.h"
+
+#include "../../butano/hw/include/bn_hw_palettes.h"
+
+class palette_animation_tests : public tests
+{
+
+public:
+    palette_animation_tests() :
+        tests("palette_animation")
+    {
+        for(int index = 0; index < _colors_count; ++index)
+        {
+            _palette_colors[index] = bn::color(index, 7, 13);
+        }
+
+        _test_animation();
+        _test_loop();
+    }
+
+private:
+    using frame = bn::palette_animation_item::frame;
+
+    static constexpr int _colors_count = 16;
+
+    static constexpr bn::color _animation_colors[] = {
+        bn::colors::red, bn::colors::green, bn::colors::blue, bn::colors::yellow
+    };
+
+    // Each frame updates a different range of colors:
+    static constexpr frame _frames[] = {
+        frame{ 0, 1, 2 },
+        frame{ 2, 5, 1 },
+        frame{ 3, 1, 1 },
+    };
+
+    bn::color _palette_colors[_colors_count];
+
+    [[nodiscard]] static bn::color _hw_color(const bn::bg_palette_ptr& palette, int color_index)
+    {
+        auto color_register = reinterpret_cast<volatile uint16_t*>(
+                    bn::hw::palettes::bg_color_register((palette.id() * _colors_count) + color_index));
+        return bn::color(*color_register);
+    }
+
+    static void _check_color(const bn::bg_palette_ptr& palette, int color_index, bn::color expected_color)
+    {
+        bn::color color = palette.colors()[color_index];
+        BN_ASSERT(color == expected_color, "Invalid color: ", color_index, " - ", color.data(), " - ",
+                  expected_color.data());
+
+        bn::color hw_color = _hw_color(palette, color_index);
+        BN_ASSERT(hw_color == expected_color, "Invalid HW color: ", color_index, " - ", hw_color.data(), " - ",
+                  expected_color.data());
+    }
+
+    void _test_animation() const
+    {
+        bn::bg_palette_ptr palette = bn::bg_palette_ptr::create(
+                    bn::bg_palette_item(_palette_colors, bn::bpp_mode::BPP_4));
+        bn::palette_animation_item animation_item(_animation_colors, _frames, false);
+
+        // The first frame is applied when the animation is set:
+        palette.set_animation(animation_item);
+        BN_ASSERT(palette.has_animation());
+        BN_ASSERT(! palette.animation_done());
+        bn::core::update();
+        _check_color(palette, 0, _palette_colors[0]);
+        _check_color(palette, 1, bn::colors::red);
+        _check_color(palette, 2, bn::colors::green);
+        _check_color(palette, 5, bn::colors::blue);
+
+        bn::core::update();
+        _check_color(palette, 1, bn::colors::yellow);
+        _check_color(palette, 2, bn::colors::green);
+        _check_color(palette, 5, bn::colors::blue);
+        _check_color(palette, 6, _palette_colors[6]);
+        BN_ASSERT(palette.animation_done());
+
+        // Finished animations keep the last frame colors:
+        bn::core::update();
+        _check_color(palette, 1, bn::colors::yellow);
+        BN_ASSERT(palette.animation_done());
+
+        palette.remove_animation();
+        BN_ASSERT(! palette.has_animation());
+    }
+
+    void _test_loop() const
+    {
+        bn::bg_palette_ptr palette = bn::bg_palette_ptr::create(
+                    bn::bg_palette_item(_palette_colors, bn::bpp_mode::BPP_4));
+        bn::palette_animation_item animation_item(_animation_colors, _frames, true);
+        palette.set_animation(animation_item);
+
+        // After its last frame, a looping animation plays its second frame again:
+        for(int cycle = 0; cycle < 3; ++cycle)
+        {
+            bn::core::update();
+            BN_ASSERT(! palette.animation_done());
+
+            bn::core::update();
+            BN_ASSERT(! palette.animation_done());
+        }
+
+        _check_color(palette, 1, bn::colors::yellow);
+        _check_color(palette, 5, bn::colors::blue);
+    }
+};
+
+#endif
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef PALETTE_EFFECTS_TESTS_H
+#define PALETTE_EFFECTS_TESTS_H
+
+#include "bn_color.h"
+#include "tests.h"
+
+#include "../../butano/hw/include/bn_hw_palettes.h"
+
+class palette_effects_tests : public tests
+{
+
+public:
+    palette_effects_tests() :
+        tests("palette_effects")
+    {
+        for(int value = 0; value <= 32; ++value)
+        {
+            _test_lut(value, 0, 0, false);
+            _test_lut(0, value, 0, false);
+            _test_lut(0, 0, value, false);
+        }
+
+        for(int value = 0; value <= 32; value += 4)
+        {
+            int intensity = (value * 3) % 33;
+            _test_lut(value, 32 - value, intensity, false);
+            _test_lut(value, 32 - value, intensity, true);
+        }
+
+        _test_grayscale();
+    }
+
+private:
+    static constexpr int _colors_count = 32768;
+    static constexpr int _chunk_colors_count = bn::hw::palettes::colors();
+
+    alignas(int) bn::color _source_colors[_chunk_colors_count];
+    alignas(int) bn::color _expected_colors[_chunk_colors_count];
+    alignas(int) bn::color _colors[_chunk_colors_count];
+
+    void _fill_source_colors(int first_color)
+    {
+        for(int index = 0; index < _chunk_colors_count; ++index)
+        {
+            _source_colors[index] = bn::color(first_color + index);
+        }
+    }
+
+    // Global effects were applied one per-color pass at a time before being composed into a LUT:
+    void _test_lut(int brightness, int contrast, int intensity, bool inverted)
+    {
+        unsigned lut[bn::hw::palettes::lut_size()];
+        bn::hw::palettes::build_lut(brightness, contrast, intensity, inverted, lut);
+
+        for(int first_color = 0; first_color < _colors_count; first_color += _chunk_colors_count)
+        {
+            _fill_source_colors(first_color);
+
+            for(int index = 0; index < _chunk_colors_count; ++index)
+            {
+                _expected_colors[index] = _source_colors[index];
+            }
+
+            if(brightness)
+            {
+                bn::hw::palettes::brightness(_expected_colors, brightness, _chunk_colors_count, _expected_colors);
+            }
+
+            if(contrast)
+            {
+                bn::hw::palettes::contrast(_expected_colors, contrast, _chunk_colors_count, _expected_colors);
+            }
+
+            if(intensity)
+            {
+                bn::hw::palettes::intensity(_expected_colors, intensity, _chunk_colors_count, _expected_colors);
+            }
+
+            if(inverted)
+            {
+                bn::hw::palettes::invert(_expected_colors, _chunk_colors_count, _expected_colors);
+            }
+
+            bn::hw::palettes::aligned_lut_effect(_source_colors, lut, _chunk_colors_count, _colors);
+
+            for(int index = 0; index < _chunk_colors_count; ++index)
+            {
+                BN_ASSERT(_colors[index] == _expected_colors[index],
+                          "Invalid LUT color: ", _source_colors[index].data(), " - ", _colors[index].data(), " - ",
+                          _expected_colors[index].data(), " - ", brightness, " - ", contrast, " - ", intensity,
+                          " - ", inverted);
+            }
+        }
+    }
+
+    void _test_grayscale()
+    {
+        for(int first_color = 0; first_color < _colors_count; first_color += _chunk_colors_count)
+        {
+            _fill_source_colors(first_color);
+            bn::hw::palettes::grayscale(_source_colors, 32, _chunk_colors_count, _expected_colors);
+            bn::hw::palettes::aligned_grayscale(_source_colors, 32, _chunk_colors_count, _colors);
+
+            for(int index = 0; index < _chunk_colors_count; ++index)
+            {
+                BN_ASSERT(_colors[index] == _expected_colors[index],
+                          "Invalid grayscale color: ", _source_colors[index].data(), " - ", _colors[index].data(),
+                          " - ", _expected_colors[index].data());
+            }
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef REGULAR_BG_TEXT_GENERATOR_TESTS_H
+#define REGULAR_BG_TEXT_GENERATOR_TESTS_H
+
+#include "bn_regular_bg_map_cell_info.h"
+#include "bn_regular_bg_text_generator.h"
+#include "tests.h"
+
+#include "common_fixed_8x8_sprite_font.h"
+#include "common_variable_8x8_sprite_font.h"
+
+class regular_bg_text_generator_tests : public tests
+{
+
+public:
+    regular_bg_text_generator_tests() :
+        tests("regular_bg_text_generator")
+    {
+        _test_map_cells();
+        _test_canvas();
+    }
+
+private:
+    static constexpr int _map_size = 32;
+    static constexpr int _width = 10;
+    static constexpr int _height = 4;
+
+    // Returns the tile index of the given text area cell, relative to the first tile of the map:
+    [[nodiscard]] static int _tile_index(bn::regular_bg_map_ptr& map, int x, int y)
+    {
+        int map_x = ((_map_size - _width) / 2) + x;
+        int map_y = ((_map_size - _height) / 2) + y;
+        bn::regular_bg_map_cell cell = (*map.vram())[(map_y * _map_size) + map_x];
+        return bn::regular_bg_map_cell_info(cell).tile_index() - map.tiles_offset();
+    }
+
+    [[nodiscard]] static int _character_tile_index(char character)
+    {
+        return 1 + character - '!';
+    }
+
+    static void _check_empty_cells(bn::regular_bg_map_ptr& map)
+    {
+        for(int y = 0; y < _height; ++y)
+        {
+            for(int x = 0; x < _width; ++x)
+            {
+                int tile_index = _tile_index(map, x, y);
+                BN_ASSERT(! tile_index, "Cell not cleared: ", x, " - ", y, " - ", tile_index);
+            }
+        }
+    }
+
+    // Fixed width fonts without space between characters point map cells to the font tiles:
+    void _test_map_cells()
+    {
+        bn::regular_bg_text_generator text_generator(common::fixed_8x8_sprite_font, bn::size(_width, _height));
+        bn::regular_bg_map_ptr map = text_generator.map();
+        BN_ASSERT(! text_generator.canvas(), "Canvas used with a fixed width font");
+        _check_empty_cells(map);
+
+        text_generator.generate(bn::point(1, 2), "AB");
+        BN_ASSERT(_tile_index(map, 0, 2) == 0, "Invalid cell: ", _tile_index(map, 0, 2));
+        BN_ASSERT(_tile_index(map, 1, 2) == _character_tile_index('A'), "Invalid cell: ", _tile_index(map, 1, 2));
+        BN_ASSERT(_tile_index(map, 2, 2) == _character_tile_index('B'), "Invalid cell: ", _tile_index(map, 2, 2));
+        BN_ASSERT(_tile_index(map, 3, 2) == 0, "Invalid cell: ", _tile_index(map, 3, 2));
+
+        text_generator.clear();
+        _check_empty_cells(map);
+
+        text_generator.generate(bn::point(1, 2), "AB");
+        text_generator.update(bn::point(1, 2), "AB", "AC");
+        BN_ASSERT(_tile_index(map, 1, 2) == _character_tile_index('A'), "Invalid cell: ", _tile_index(map, 1, 2));
+        BN_ASSERT(_tile_index(map, 2, 2) == _character_tile_index('C'), "Invalid cell: ", _tile_index(map, 2, 2));
+
+        text_generator.update(bn::point(1, 2), "AC", "A");
+        BN_ASSERT(_tile_index(map, 1, 2) == _character_tile_index('A'), "Invalid cell: ", _tile_index(map, 1, 2));
+        BN_ASSERT(_tile_index(map, 2, 2) == 0, "Invalid cell: ", _tile_index(map, 2, 2));
+
+        text_generator.clear(bn::point(1, 2), bn::size(1, 1));
+        _check_empty_cells(map);
+    }
+
+    [[nodiscard]] static bool _empty_tile(bn::regular_bg_tiles_ptr& tiles, int x, int y)
+    {
+        const bn::tile& tile = (*tiles.vram())[1 + (y * _width) + x];
+
+        for(uint32_t tile_data : tile.data)
+        {
+            if(tile_data)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    static void _check_empty_tiles(bn::regular_bg_tiles_ptr& tiles)
+    {
+        for(int y = 0; y < _height; ++y)
+        {
+            for(int x = 0; x < _width; ++x)
+            {
+                BN_ASSERT(_empty_tile(tiles, x, y), "Tile not cleared: ", x, " - ", y);
+            }
+        }
+    }
+
+    // Variable width fonts are drawn on a tile canvas with one tile per text area cell:
+    void _test_canvas()
+    {
+        bn::regular_bg_text_generator text_generator(common::variable_8x8_sprite_font, bn::size(_width, _height));
+        bn::regular_bg_map_ptr map = text_generator.map();
+        bn::regular_bg_tiles_ptr tiles = map.tiles();
+        BN_ASSERT(text_generator.canvas(), "Canvas not used with a variable width font");
+
+        for(int y = 0; y < _height; ++y)
+        {
+            for(int x = 0; x < _width; ++x)
+            {
+                int tile_index = _tile_index(map, x, y);
+                BN_ASSERT(tile_index == 1 + (y * _width) + x, "Invalid canvas cell: ", x, " - ", y, " - ",
+                          tile_index);
+            }
+        }
+
+        _check_empty_tiles(tiles);
+
+        text_generator.generate(bn::point(1, 1), "A");
+        BN_ASSERT(! _empty_tile(tiles, 1, 1), "Text not drawn");
+        BN_ASSERT(_empty_tile(tiles, 0, 1), "Text drawn out of place");
+        BN_ASSERT(_empty_tile(tiles, 3, 1), "Text drawn out of place");
+
+        text_generator.clear();
+        _check_empty_tiles(tiles);
+
+        text_generator.generate(bn::point(1, 1), "A");
+        BN_ASSERT(! _empty_tile(tiles, 1, 1), "Text not drawn again");
+
+        text_generator.update(bn::point(1, 1), "A", "");
+        _check_empty_tiles(tiles);
+    }
+};
+
+#endif
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef SPRITE_TEXT_GENERATOR_TESTS_H
+#define SPRITE_TEXT_GENERATOR_TESTS_H
+
+#include "bn_sprite_tiles.h"
+#include "bn_sprite_tiles_ptr.h"
+#include "bn_sprite_text_generator.h"
+#include "tests.h"
+
+#include "common_fixed_8x8_sprite_font.h"
+#include "common_variable_8x8_sprite_font.h"
+
+class sprite_text_generator_tests : public tests
+{
+
+public:
+    sprite_text_generator_tests() :
+        tests("sprite_text_generator")
+    {
+        _test_glyph_cache();
+        _test_multiple_characters_per_sprite();
+        _test_variable_width();
+    }
+
+private:
+    // Changed characters reuse the tiles already shown by other sprites:
+    static void _test_glyph_cache()
+    {
+        bn::sprite_text_generator text_generator(common::fixed_8x8_sprite_font);
+        text_generator.set_one_sprite_per_character(true);
+
+        bn::vector<bn::sprite_ptr, 4> sprites = text_generator.generate<4>(0, 0, "AB");
+        bn::vector<bn::sprite_ptr, 4> other_sprites = text_generator.generate<4>(0, 16, "BA");
+        int used_tiles_count = bn::sprite_tiles::used_tiles_count();
+
+        BN_ASSERT(text_generator.repaint("AB", "BA", sprites), "Text not repainted");
+        BN_ASSERT(sprites.size() == 2, "Invalid sprites count: ", sprites.size());
+        BN_ASSERT(sprites[0].tiles() == other_sprites[0].tiles(), "Glyph tiles not reused");
+        BN_ASSERT(sprites[1].tiles() == other_sprites[1].tiles(), "Glyph tiles not reused");
+        BN_ASSERT(bn::sprite_tiles::used_tiles_count() == used_tiles_count,
+                  "Glyph tiles allocated: ", bn::sprite_tiles::used_tiles_count(), " - ", used_tiles_count);
+    }
+
+    static void _test_multiple_characters_per_sprite()
+    {
+        bn::sprite_text_generator text_generator(common::fixed_8x8_sprite_font);
+
+        bn::vector<bn::sprite_ptr, 4> sprites = text_generator.generate<4>(0, 0, "AB");
+        bn::sprite_ptr sprite = sprites[0];
+
+        BN_ASSERT(text_generator.repaint("AB", "BA", sprites), "Text not repainted");
+        BN_ASSERT(sprites.size() == 1, "Invalid sprites count: ", sprites.size());
+        BN_ASSERT(sprites[0] == sprite, "Sprite not reused");
+
+        // Different layouts are not repainted:
+        BN_ASSERT(! text_generator.repaint("BA", "B A", sprites), "Different layout repainted");
+        BN_ASSERT(! text_generator.repaint("BA", "BAB", sprites), "Different layout repainted");
+    }
+
+    static void _test_variable_width()
+    {
+        bn::sprite_text_generator text_generator(common::variable_8x8_sprite_font);
+        text_generator.set_one_sprite_per_character(true);
+
+        bn::vector<bn::sprite_ptr, 4> sprites = text_generator.generate<4>(0, 0, "AB");
+        BN_ASSERT(! text_generator.repaint("AB", "BA", sprites), "Variable width text repainted");
+    }
+};
+
+#endif
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef SPRITE_TILES_COMPACTION_TESTS_H
+#define SPRITE_TILES_COMPACTION_TESTS_H
+
+#include "bn_core.h"
+#include "bn_color.h"
+#include "bn_vector.h"
+#include "bn_optional.h"
+#include "bn_sprite_ptr.h"
+#include "bn_sprite_tiles.h"
+#include "bn_sprite_tiles_ptr.h"
+#include "bn_sprite_palette_ptr.h"
+#include "bn_sprite_palette_item.h"
+#include "tests.h"
+
+#include "../../butano/hw/include/bn_hw_tonc.h"
+
+class sprite_tiles_compaction_tests : public tests
+{
+
+public:
+    sprite_tiles_compaction_tests() :
+        tests("sprite_tiles_compaction")
+    {
+        for(int block = 0; block < _blocks_count; ++block)
+        {
+            for(int tile_index = 0; tile_index < _block_tiles; ++tile_index)
+            {
+                for(uint32_t& tile_data : _tiles[block][tile_index].data)
+                {
+                    tile_data = 0x01010101 * unsigned((block * _block_tiles) + tile_index + 1);
+                }
+            }
+        }
+
+        // Merge the free tiles left by previous tests:
+        [[maybe_unused]] bool compacted = bn::sprite_tiles::compact();
+        bn::core::update();
+
+        _test_compaction();
+
+        // Tiles data must outlive the removed sprite tiles until they are freed:
+        bn::core::update();
+    }
+
+private:
+    static constexpr int _blocks_count = 3;
+    static constexpr int _block_tiles = 16;
+
+    alignas(int) bn::tile _tiles[_blocks_count][_block_tiles];
+
+    void _test_compaction() const
+    {
+        bn::color colors[16] = {};
+        bn::sprite_palette_ptr palette = bn::sprite_palette_ptr::create(
+                    bn::sprite_palette_item(colors, bn::bpp_mode::BPP_4));
+        bn::vector<bn::optional<bn::sprite_ptr>, _blocks_count> sprites;
+
+        for(int block = 0; block < _blocks_count; ++block)
+        {
+            bn::sprite_tiles_item tiles_item(_tiles[block], bn::bpp_mode::BPP_4);
+            sprites.emplace_back(bn::sprite_ptr::create(
+                                     bn::sprite_shape_size(32, 32), bn::sprite_tiles_ptr::create(tiles_item), palette));
+        }
+
+        bn::core::update();
+
+        int first_id = sprites[0]->tiles().id();
+        int middle_id = sprites[1]->tiles().id();
+        int last_id = sprites[2]->tiles().id();
+        BN_ASSERT(middle_id == first_id + _block_tiles && last_id == middle_id + _block_tiles,
+                  "Sprite tiles not contiguous: ", first_id, " - ", middle_id, " - ", last_id);
+
+        // Removing the middle sprite leaves a free block between used ones:
+        sprites[1].reset();
+        bn::core::update();
+
+        int available_tiles_count = bn::sprite_tiles::available_tiles_count();
+        BN_ASSERT(bn::sprite_tiles::compact(), "Sprite tiles not compacted");
+        BN_ASSERT(sprites[0]->tiles().id() == first_id, "First sprite tiles moved: ", sprites[0]->tiles().id());
+        BN_ASSERT(sprites[2]->tiles().id() == middle_id, "Last sprite tiles not moved: ", sprites[2]->tiles().id());
+        BN_ASSERT(bn::sprite_tiles::available_tiles_count() == available_tiles_count,
+                  "Available tiles count changed: ", bn::sprite_tiles::available_tiles_count(), " - ",
+                  available_tiles_count);
+
+        // Relocated tiles are reloaded from their source data in the next update:
+        bn::core::update();
+        _check_vram(first_id, 0);
+        _check_vram(middle_id, 2);
+
+        BN_ASSERT(! bn::sprite_tiles::compact(), "Sprite tiles compacted again");
+    }
+
+    void _check_vram(int tiles_id, int block) const
+    {
+        auto vram_tiles = reinterpret_cast<const volatile uint32_t*>(MEM_VRAM_OBJ) + (tiles_id * 8);
+
+        for(int tile_index = 0; tile_index < _block_tiles; ++tile_index)
+        {
+            for(int word_index = 0; word_index < 8; ++word_index)
+            {
+                uint32_t vram_word = vram_tiles[(tile_index * 8) + word_index];
+                uint32_t expected_word = _tiles[block][tile_index].data[word_index];
+                BN_ASSERT(vram_word == expected_word, "Invalid VRAM tile: ", tiles_id, " - ", block, " - ",
+                          tile_index, " - ", vram_word, " - ", expected_word);
+            }
+        }
+    }
+};
+
+#endif
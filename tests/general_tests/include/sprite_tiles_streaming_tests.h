@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef SPRITE_TILES_STREAMING_TESTS_H
+#define SPRITE_TILES_STREAMING_TESTS_H
+
+#include "bn_core.h"
+#include "bn_sprite_ptr.h"
+#include "bn_sprite_tiles.h"
+#include "bn_sprite_tiles_ptr.h"
+#include "bn_sprite_items_common_fixed_8x8_font.h"
+#include "tests.h"
+
+#include "../../butano/hw/include/bn_hw_tonc.h"
+
+class sprite_tiles_streaming_tests : public tests
+{
+
+public:
+    sprite_tiles_streaming_tests() :
+        tests("sprite_tiles_streaming")
+    {
+        _test_own_slot();
+        _test_shared_tiles();
+
+        // Free removed sprite tiles:
+        bn::core::update();
+    }
+
+private:
+    static constexpr int _first_graphics_index = 32;
+
+    [[nodiscard]] static const bn::sprite_tiles_item& _tiles_item()
+    {
+        return bn::sprite_items::common_fixed_8x8_font.tiles_item();
+    }
+
+    static void _check_vram(int tiles_id, int graphics_index)
+    {
+        auto vram_words = reinterpret_cast<const volatile uint32_t*>(MEM_VRAM_OBJ) + (tiles_id * 8);
+        const bn::tile& expected_tile = _tiles_item().graphics_tiles_ref(graphics_index)[0];
+
+        for(int word_index = 0; word_index < 8; ++word_index)
+        {
+            uint32_t vram_word = vram_words[word_index];
+            uint32_t expected_word = expected_tile.data[word_index];
+            BN_ASSERT(vram_word == expected_word, "Invalid VRAM tile: ", tiles_id, " - ", graphics_index, " - ",
+                      word_index, " - ", vram_word, " - ", expected_word);
+        }
+    }
+
+    // Frames not found in VRAM are copied to the slot of tiles used by the sprite alone:
+    static void _test_own_slot()
+    {
+        bn::sprite_ptr sprite = bn::sprite_ptr::create(bn::sprite_items::common_fixed_8x8_font, _first_graphics_index);
+        bn::core::update();
+
+        int tiles_id = sprite.tiles().id();
+        int used_tiles_count = bn::sprite_tiles::used_tiles_count();
+        _check_vram(tiles_id, _first_graphics_index);
+
+        for(int frame = 1; frame <= 4; ++frame)
+        {
+            int graphics_index = _first_graphics_index + frame;
+            sprite.set_tiles(_tiles_item(), graphics_index);
+            BN_ASSERT(sprite.tiles().id() == tiles_id, "Sprite tiles slot changed: ", sprite.tiles().id());
+            BN_ASSERT(bn::sprite_tiles::used_tiles_count() == used_tiles_count,
+                      "Sprite tiles allocated: ", bn::sprite_tiles::used_tiles_count(), " - ", used_tiles_count);
+
+            bn::core::update();
+            _check_vram(tiles_id, graphics_index);
+        }
+    }
+
+    static void _test_shared_tiles()
+    {
+        int graphics_index = _first_graphics_index;
+        bn::sprite_ptr sprite = bn::sprite_ptr::create(bn::sprite_items::common_fixed_8x8_font, graphics_index);
+        bn::sprite_ptr other_sprite = bn::sprite_ptr::create(bn::sprite_items::common_fixed_8x8_font,
+                                                             graphics_index + 1);
+        bn::core::update();
+
+        // Frames already in VRAM are shared:
+        sprite.set_tiles(_tiles_item(), graphics_index + 1);
+        BN_ASSERT(sprite.tiles() == other_sprite.tiles(), "Sprite tiles not shared");
+
+        // Tiles shared with another sprite are not overwritten:
+        int shared_tiles_id = other_sprite.tiles().id();
+        sprite.set_tiles(_tiles_item(), graphics_index + 2);
+        BN_ASSERT(sprite.tiles() != other_sprite.tiles(), "Sprite tiles still shared");
+        BN_ASSERT(other_sprite.tiles().id() == shared_tiles_id, "Shared tiles moved: ", other_sprite.tiles().id());
+
+        bn::core::update();
+        _check_vram(sprite.tiles().id(), graphics_index + 2);
+        _check_vram(shared_tiles_id, graphics_index + 1);
+    }
+};
+
+#endif
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#ifndef TELEMETRY_TESTS_H
+#define TELEMETRY_TESTS_H
+
+#include "bn_span.h"
+#include "bn_string_view.h"
+#include "bn_telemetry.h"
+#include "tests.h"
+
+class telemetry_tests : public tests
+{
+
+public:
+    telemetry_tests() :
+        tests("telemetry")
+    {
+        BN_ASSERT(bn::telemetry::channels_count() == 3 + _bn::telemetry::engine_sections_count);
+        BN_ASSERT(bn::string_view(bn::telemetry::channel_name(_cpu_channel)) == "cpu_ticks");
+        BN_ASSERT(bn::string_view(bn::telemetry::channel_name(3)) == "eng_update");
+
+        _test_empty();
+        _test_percentiles();
+        _test_ring_buffer();
+
+        bn::telemetry::reset();
+    }
+
+private:
+    static constexpr int _cpu_channel = bn::telemetry::cpu_ticks_channel;
+    static constexpr int _vblank_channel = bn::telemetry::vblank_ticks_channel;
+    static constexpr int _max_samples = BN_CFG_TELEMETRY_MAX_SAMPLES;
+
+    static void _test_empty()
+    {
+        bn::telemetry::reset();
+        BN_ASSERT(bn::telemetry::samples_count() == 0);
+        BN_ASSERT(bn::telemetry::percentile(_cpu_channel, 50) == 0);
+        BN_ASSERT(bn::telemetry::max(_cpu_channel) == 0);
+    }
+
+    static void _test_percentiles()
+    {
+        bn::telemetry::reset();
+
+        // Values are added in reverse order to check that percentiles don't depend on it:
+        for(int value = 10; value >= 1; --value)
+        {
+            _bn::telemetry::add_sample(value, value * 2, 0);
+        }
+
+        BN_ASSERT(bn::telemetry::samples_count() == 10);
+        BN_ASSERT(bn::telemetry::value(_cpu_channel, 0) == 10);
+        BN_ASSERT(bn::telemetry::value(_cpu_channel, 9) == 1);
+        BN_ASSERT(bn::telemetry::value(_vblank_channel, 9) == 2);
+
+        // Nearest rank method:
+        BN_ASSERT(bn::telemetry::percentile(_cpu_channel, 0) == 1);
+        BN_ASSERT(bn::telemetry::percentile(_cpu_channel, 50) == 5);
+        BN_ASSERT(bn::telemetry::percentile(_cpu_channel, 95) == 10);
+        BN_ASSERT(bn::telemetry::percentile(_cpu_channel, 100) == 10);
+        BN_ASSERT(bn::telemetry::percentile(_vblank_channel, 50) == 10);
+        BN_ASSERT(bn::telemetry::max(_cpu_channel) == 10);
+
+        // Computing percentiles doesn't modify the stored samples:
+        BN_ASSERT(bn::telemetry::value(_cpu_channel, 0) == 10);
+
+        int buckets[3];
+        bn::telemetry::histogram(_cpu_channel, 4, buckets);
+        BN_ASSERT(buckets[0] == 3);
+        BN_ASSERT(buckets[1] == 4);
+        BN_ASSERT(buckets[2] == 3);
+    }
+
+    static void _test_ring_buffer()
+    {
+        bn::telemetry::reset();
+
+        int samples = _max_samples + 6;
+
+        for(int value = 0; value < samples; ++value)
+        {
+            _bn::telemetry::add_sample(value, 0, 0);
+        }
+
+        // Only the last samples are kept:
+        BN_ASSERT(bn::telemetry::samples_count() == _max_samples);
+        BN_ASSERT(bn::telemetry::value(_cpu_channel, 0) == samples - _max_samples);
+        BN_ASSERT(bn::telemetry::value(_cpu_channel, _max_samples - 1) == samples - 1);
+        BN_ASSERT(bn::telemetry::max(_cpu_channel) == samples - 1);
+        BN_ASSERT(bn::telemetry::percentile(_cpu_channel, 0) == samples - _max_samples);
+    }
+};
+
+#endif
@@ -8,6 +8,7 @@
 #include "bn_sprite_ptr.h"
 #include "bn_bg_palettes.h"
 #include "bn_config_assert.h"
+#include "bn_config_telemetry.h"
 #include "bn_sprite_text_generator.h"
 
 #include "common_variable_8x16_sprite_font.h"
@@ -22,11 +23,24 @@
 #include "format_tests.h"
 #include "memory_tests.h"
 #include "sram_tests.h"
+#include "palette_effects_tests.h"
+#include "regular_bg_text_generator_tests.h"
+#include "sprite_text_generator_tests.h"
+#include "frame_arena_tests.h"
+#include "telemetry_tests.h"
+#include "sprite_tiles_compaction_tests.h"
+#include "sprite_tiles_streaming_tests.h"
+#include "palette_animation_tests.h"
+#include "bg_blocks_compaction_tests.h"
 
 #if ! BN_CFG_ASSERT_ENABLED
     static_assert(false, "Enable asserts in bn_config_assert.h to run tests");
 #endif
 
+#if ! BN_CFG_TELEMETRY_ENABLED
+    static_assert(false, "Enable telemetry in the Makefile to run tests");
+#endif
+
 int main()
 {
     bn::core::init();
@@ -48,6 +62,15 @@ int main()
     optional_tests();
     any_tests();
     format_tests();
+    palette_effects_tests();
+    regular_bg_text_generator_tests();
+    sprite_text_generator_tests();
+    frame_arena_tests();
+    telemetry_tests();
+    sprite_tiles_compaction_tests();
+    sprite_tiles_streaming_tests();
+    palette_animation_tests();
+    bg_blocks_compaction_tests();
     memory_tests memory_tests(used_stack_iwram);
     sram_tests sram_tests;
 
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_core.h"
+#include "bn_hbes.h"
+#include "bn_hdma.h"
+#include "bn_array.h"
+#include "bn_colors.h"
+#include "bn_display.h"
+#include "bn_config_hbes.h"
+#include "bn_sprite_text_generator.h"
+#include "bn_bg_palettes_transparent_color_hbe_ptr.h"
+
+#include "../../butano/hw/include/bn_hw_tonc.h"
+
+#include "common_info.h"
+#include "common_variable_8x16_sprite_font.h"
+
+#if BN_CFG_HBES_MAX_HDMA_ITEMS < 1
+    static_assert(false, "Enable H-Blank effects HDMA channels in the Makefile to run this test");
+#endif
+
+namespace
+{
+    constexpr int lines[] = { 1, 37, 80, 81, 122, 159 };
+
+    [[nodiscard]] bool low_priority_hdma_enabled()
+    {
+        return REG_DMA3CNT & DMA_ENABLE;
+    }
+
+    [[nodiscard]] bn::color hw_bg_color(int line, int color_index)
+    {
+        while(REG_VCOUNT != line)
+        {
+        }
+
+        return bn::color(reinterpret_cast<volatile uint16_t*>(MEM_PAL_BG)[color_index]);
+    }
+
+    void check_transparent_colors(const bn::span<const bn::color>& colors)
+    {
+        for(int frame = 0; frame < 4; ++frame)
+        {
+            bn::core::update();
+
+            for(int line : lines)
+            {
+                bn::color color = hw_bg_color(line, 0);
+                BN_ASSERT(color == colors[line], "Invalid transparent color: ", line, " - ", color.data(), " - ",
+                          colors[line].data());
+            }
+        }
+    }
+
+    void check_hdma_color(bn::color expected_color)
+    {
+        for(int line : lines)
+        {
+            bn::color color = hw_bg_color(line, 1);
+            BN_ASSERT(color == expected_color, "Invalid HDMA color: ", line, " - ", color.data(), " - ",
+                      expected_color.data());
+        }
+    }
+}
+
+int main()
+{
+    bn::core::init();
+
+    bn::array<bn::color, bn::display::height()> transparent_colors;
+
+    for(int index = 0; index < bn::display::height(); ++index)
+    {
+        int value = index % 32;
+        transparent_colors[index] = bn::color(value, 0, 31 - value);
+    }
+
+    bn::bg_palettes_transparent_color_hbe_ptr transparent_color_hbe =
+            bn::bg_palettes_transparent_color_hbe_ptr::create(transparent_colors);
+
+    // The effect is committed with the free low priority HDMA channel:
+    check_transparent_colors(transparent_colors);
+    BN_ASSERT(low_priority_hdma_enabled(), "Low priority HDMA not enabled");
+    BN_ASSERT(! bn::hbes::estimated_hblank_cycles(), "Effect committed with H-Blank interrupts");
+    BN_ASSERT(! bn::hdma::running(), "H-Blank effects HDMA reported as running");
+
+    bn::array<uint16_t, bn::display::height()> hdma_colors;
+    hdma_colors.fill(bn::colors::orange.data());
+
+    // bn::hdma takes the channel back, so the effect is committed with H-Blank interrupts again:
+    auto hdma_destination = reinterpret_cast<uint16_t*>(MEM_PAL_BG) + 1;
+    bn::hdma::start(hdma_colors, *hdma_destination);
+    check_transparent_colors(transparent_colors);
+    check_hdma_color(bn::colors::orange);
+    BN_ASSERT(bn::hdma::running(), "HDMA not running");
+    BN_ASSERT(bn::hbes::estimated_hblank_cycles(), "Effect not committed with H-Blank interrupts");
+
+    // The effect gets the channel again when it's released:
+    bn::hdma::stop();
+    check_transparent_colors(transparent_colors);
+    BN_ASSERT(low_priority_hdma_enabled(), "Low priority HDMA not enabled again");
+    BN_ASSERT(! bn::hbes::estimated_hblank_cycles(), "Effect committed with H-Blank interrupts again");
+
+    bn::sprite_text_generator text_generator(common::variable_8x16_sprite_font);
+
+    constexpr bn::string_view info_text_lines[] = {
+        "A transparent color effect is",
+        "committed with HDMA until",
+        "bn::hdma takes its channel",
+        "",
+        "HDMA H-Blank effects test passed",
+    };
+
+    common::info info("HDMA H-Blank effects test", info_text_lines, text_generator);
+    info.set_show_always(true);
+
+    while(true)
+    {
+        bn::core::update();
+    }
+}
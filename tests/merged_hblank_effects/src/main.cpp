@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_core.h"
+#include "bn_hbes.h"
+#include "bn_array.h"
+#include "bn_vector.h"
+#include "bn_display.h"
+#include "bn_config_hbes.h"
+#include "bn_bg_palette_item.h"
+#include "bn_sprite_text_generator.h"
+#include "bn_bg_palette_color_hbe_ptr.h"
+
+#include "../../butano/hw/include/bn_hw_palettes.h"
+#include "../../butano/hw/include/bn_hw_hblank_effects.h"
+
+#include "common_info.h"
+#include "common_variable_8x16_sprite_font.h"
+
+#if BN_CFG_HBES_MAX_ITEMS < 14
+    static_assert(false, "Increase the maximum number of H-Blank effects in the Makefile to run this test");
+#endif
+
+namespace
+{
+    // 14 effects don't fit in an H-Blank, so adjacent palette colors are merged into 32-bit entries:
+    constexpr int colors_count = 14;
+
+    static_assert(bn::hw::hblank_effects::cycles(colors_count, 0, false) > bn::hw::hblank_effects::max_cycles());
+
+    bn::array<bn::color, bn::display::height()> hbe_colors[colors_count];
+
+    void read_hw_colors(int line, int first_color_index, bn::color* colors)
+    {
+        while(REG_VCOUNT != line)
+        {
+        }
+
+        volatile uint16_t* color_registers = bn::hw::palettes::bg_color_register(first_color_index);
+
+        for(int index = 0; index < colors_count; ++index)
+        {
+            colors[index] = bn::color(color_registers[index]);
+        }
+    }
+
+    void check_colors(int first_color_index)
+    {
+        constexpr int lines[] = { 0, 1, 37, 80, 81, 122, 159 };
+
+        for(int frame = 0; frame < 4; ++frame)
+        {
+            bn::core::update();
+
+            BN_ASSERT(bn::hbes::estimated_hblank_cycles() <= bn::hw::hblank_effects::max_cycles(),
+                      "Entries not merged: ", bn::hbes::estimated_hblank_cycles());
+
+            for(int line : lines)
+            {
+                bn::color colors[colors_count];
+                read_hw_colors(line, first_color_index, colors);
+
+                for(int index = 0; index < colors_count; ++index)
+                {
+                    bn::color expected_color = hbe_colors[index][line];
+                    BN_ASSERT(colors[index] == expected_color, "Invalid color: ", line, " - ", index, " - ",
+                              colors[index].data(), " - ", expected_color.data());
+                }
+            }
+        }
+    }
+}
+
+int main()
+{
+    bn::core::init();
+
+    for(int index = 0; index < colors_count; ++index)
+    {
+        for(int line = 0; line < bn::display::height(); ++line)
+        {
+            hbe_colors[index][line] = bn::color((line + index) % 32, (line * 2) % 32, index);
+        }
+    }
+
+    bn::color palette_colors[16];
+    bn::bg_palette_item palette_item(palette_colors, bn::bpp_mode::BPP_4);
+    bn::bg_palette_ptr palette = bn::bg_palette_ptr::create(palette_item);
+    int first_color_index = palette.id() * 16;
+
+    bn::vector<bn::bg_palette_color_hbe_ptr, colors_count> color_hbes;
+
+    for(int index = 0; index < colors_count; ++index)
+    {
+        color_hbes.push_back(bn::bg_palette_color_hbe_ptr::create(palette, index, hbe_colors[index]));
+    }
+
+    check_colors(first_color_index);
+
+    // Merged tables must be updated when the effects values change:
+    for(int index = 0; index < colors_count; ++index)
+    {
+        for(int line = 0; line < bn::display::height(); ++line)
+        {
+            hbe_colors[index][line] = bn::color(index, (line + index) % 32, (line * 3) % 32);
+        }
+
+        color_hbes[index].reload_colors_ref();
+    }
+
+    check_colors(first_color_index);
+
+    bn::sprite_text_generator text_generator(common::variable_8x16_sprite_font);
+
+    constexpr bn::string_view info_text_lines[] = {
+        "14 BG palette color effects",
+        "are committed in one H-Blank",
+        "merging adjacent colors",
+        "",
+        "Merged H-Blank effects test passed",
+    };
+
+    common::info info("Merged H-Blank effects test", info_text_lines, text_generator);
+    info.set_show_always(true);
+
+    while(true)
+    {
+        bn::core::update();
+    }
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_core.h"
+#include "bn_math.h"
+#include "bn_array.h"
+#include "bn_format.h"
+#include "bn_display.h"
+#include "bn_config_core.h"
+#include "bn_sprite_palettes.h"
+#include "bn_sprite_text_generator.h"
+#include "bn_bg_palettes_transparent_color_hbe_ptr.h"
+
+#include "../../butano/hw/include/bn_hw_display.h"
+
+#include "common_info.h"
+#include "common_variable_8x16_sprite_font.h"
+
+#if ! BN_CFG_CORE_PIPELINED_COMMIT
+    static_assert(false, "Enable pipelined commit in the Makefile to run this test");
+#endif
+
+namespace
+{
+    int vblank_callbacks_count = 0;
+
+    void vblank_callback()
+    {
+        ++vblank_callbacks_count;
+    }
+
+    void update(int updates)
+    {
+        for(int index = 0; index < updates; ++index)
+        {
+            bn::core::update();
+        }
+    }
+
+    // Registers written directly to hardware (core::sleep, display and BGs stop paths)
+    // must not be undone by the next staged commit:
+    void direct_writes_test()
+    {
+        // Transparency blending mode is committed by default:
+        update(4);
+        BN_ASSERT(REG_BLDCNT, "Blending register not committed");
+
+        bn::hw::display::stop();
+        update(4);
+        BN_ASSERT(! REG_BLDCNT, "Blending register restored: ", REG_BLDCNT);
+
+        bn::hw::display::sleep();
+        update(4);
+        BN_ASSERT(REG_DISPCNT & DCNT_BLANK, "Display woken up: ", REG_DISPCNT);
+
+        bn::hw::display::wake_up();
+        update(4);
+        BN_ASSERT(! (REG_DISPCNT & DCNT_BLANK), "Display asleep: ", REG_DISPCNT);
+    }
+}
+
+int main()
+{
+    bn::core::init();
+    direct_writes_test();
+    bn::core::set_vblank_callback(vblank_callback);
+
+    bn::sprite_text_generator text_generator(common::variable_8x16_sprite_font);
+
+    constexpr bn::string_view info_text_lines[] = {
+        "Sprites, palettes and H-Blank",
+        "effects are updated each frame",
+        "and committed in the next",
+        "V-Blank interrupt",
+        "",
+        "Direct register writes test passed",
+    };
+
+    common::info info("Pipelined commit test", info_text_lines, text_generator);
+    info.set_show_always(true);
+
+    bn::array<bn::color, bn::display::height()> transparent_colors;
+
+    for(int index = 0; index < bn::display::height(); ++index)
+    {
+        int value = (index * 32) / bn::display::height();
+        transparent_colors[index] = bn::color(0, value / 2, value);
+    }
+
+    bn::bg_palettes_transparent_color_hbe_ptr transparent_color_hbe =
+            bn::bg_palettes_transparent_color_hbe_ptr::create(transparent_colors);
+
+    bn::vector<bn::sprite_ptr, 8> moving_sprites;
+    text_generator.set_center_alignment();
+    text_generator.generate(0, 0, "Moving text", moving_sprites);
+
+    bn::vector<bn::sprite_ptr, 8> cpu_sprites;
+    bn::fixed max_cpu_usage;
+    int updates_count = 0;
+    int frame_counter = 0;
+    int angle = 0;
+
+    while(true)
+    {
+        angle = (angle + 4) % 360;
+
+        bn::fixed y = bn::degrees_lut_sin(angle) * 24;
+
+        for(bn::sprite_ptr& moving_sprite : moving_sprites)
+        {
+            moving_sprite.set_y(y);
+        }
+
+        bn::sprite_palettes::set_brightness((bn::degrees_lut_sin(angle) + 1) / 8);
+
+        max_cpu_usage = bn::max(max_cpu_usage, bn::core::last_cpu_usage());
+        ++frame_counter;
+
+        if(frame_counter == 60)
+        {
+            bn::fixed max_cpu_usage_pct = max_cpu_usage * 100;
+            int max_cpu_usage_pct_int = max_cpu_usage_pct.shift_integer();
+            int max_cpu_usage_pct_dec = ((max_cpu_usage_pct - max_cpu_usage_pct_int) * 100).shift_integer();
+            cpu_sprites.clear();
+            text_generator.set_right_alignment();
+            text_generator.generate(
+                112, 64, bn::format<16>("CPU: {}.{}%", max_cpu_usage_pct_int, max_cpu_usage_pct_dec),
+                cpu_sprites);
+            text_generator.set_center_alignment();
+            max_cpu_usage = 0;
+            frame_counter = 0;
+        }
+
+        bn::core::update();
+        ++updates_count;
+
+        // The V-Blank callback is called once per update, even when it's not called during V-Blank:
+        BN_ASSERT(vblank_callbacks_count == updates_count,
+                  "Invalid V-Blank callbacks count: ", vblank_callbacks_count, " - ", updates_count);
+    }
+}
@@ -7,6 +7,7 @@
 #include "bn_core.h"
 #include "bn_limits.h"
 #include "bn_random.h"
+#include "bn_algorithm.h"
 #include "bn_profiler.h"
 #include "bn_unique_ptr.h"
 #include "bn_seed_random.h"
@@ -14,11 +15,14 @@
 
 #include "../../butano/hw/include/bn_hw_dma.h"
 #include "../../butano/hw/include/bn_hw_memory.h"
+#include "../../butano/hw/include/bn_hw_palettes.h"
 #include "../../butano/hw/include/bn_hw_decompress.h"
 
 #include "bn_regular_bg_items_butano_huge_rl.h"
+#include "bn_regular_bg_items_butano_huge_lz4.h"
 #include "bn_regular_bg_items_butano_huge_huff.h"
 #include "bn_regular_bg_items_butano_huge_lz77.h"
+#include "bn_regular_bg_items_butano_huge_rans.h"
 
 namespace
 {
@@ -306,6 +310,23 @@ public:
     }
 };
 
+class local_allocator
+{
+
+public:
+    static inline bn::best_fit_allocator* allocator = nullptr;
+
+    [[nodiscard]] static void* alloc(unsigned bytes)
+    {
+        return allocator->alloc(int(bytes));
+    }
+
+    static void free(void* ptr)
+    {
+        allocator->free(ptr);
+    }
+};
+
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wswitch-default"
 
@@ -453,6 +474,67 @@ void coroutine_test(int& integer)
 }
 
 
+template<class allocator>
+int alloc_test_impl()
+{
+    constexpr int slots_count = 128;
+
+    void* slots[slots_count] = {};
+    bn::random random;
+    int allocations = 0;
+
+    for(int i = 0; i < its; ++i)
+    {
+        void*& slot = slots[random.get_int(slots_count)];
+
+        if(slot)
+        {
+            allocator::free(slot);
+            slot = nullptr;
+        }
+        else
+        {
+            int bytes = random.get_int(4) ? random.get_int(4, 128) : random.get_int(256, 1024);
+            slot = allocator::alloc(unsigned(bytes));
+            allocations += slot != nullptr;
+        }
+    }
+
+    for(void* slot : slots)
+    {
+        allocator::free(slot);
+    }
+
+    return allocations;
+}
+
+void alloc_test(int& integer)
+{
+    constexpr int buffer_size = 64 * 1024;
+
+    bn::unique_ptr<bn::array<uint8_t, buffer_size>> buffer_ptr(new bn::array<uint8_t, buffer_size>());
+    bn::best_fit_allocator allocator(buffer_ptr->data(), buffer_size);
+    local_allocator::allocator = &allocator;
+
+    BN_PROFILER_START("alloc_local");
+
+    int local_allocations = alloc_test_impl<local_allocator>();
+
+    BN_PROFILER_STOP();
+
+    BN_PROFILER_START("alloc_ewram");
+
+    int ewram_allocations = alloc_test_impl<ewram_allocator>();
+
+    BN_PROFILER_STOP();
+
+    BN_ASSERT(local_allocations == ewram_allocations, "Invalid allocations: ",
+              local_allocations, " - ", ewram_allocations);
+
+    integer += local_allocations;
+}
+
+
 constexpr int copy_words = bn::regular_bg_items::butano_huge_huff.tiles_item().tiles_ref().size_bytes() / 4;
 constexpr int copy_words_data[copy_words] = {};
 
@@ -551,11 +633,141 @@ void huff_decomp_test()
     bn::unique_ptr<bn::array<uint8_t, 64 * 1024>> buffer_ptr(new bn::array<uint8_t, 64 * 1024>());
     uint8_t* buffer = buffer_ptr->data();
 
-    BN_PROFILER_START("huff");
+    BN_PROFILER_START("huff_regular");
 
     bn::hw::decompress::huff(tiles, buffer);
 
     BN_PROFILER_STOP();
+
+    if(check_bios)
+    {
+        BN_PROFILER_START("huff_bios");
+
+        bn::hw::decompress::huff_bios(tiles, buffer);
+
+        BN_PROFILER_STOP();
+    }
+}
+
+void lz4_decomp_test()
+{
+    const bn::tile* tiles = bn::regular_bg_items::butano_huge_lz4.tiles_item().tiles_ref().data();
+    bn::unique_ptr<bn::array<uint8_t, 64 * 1024>> buffer_ptr(new bn::array<uint8_t, 64 * 1024>());
+    uint8_t* buffer = buffer_ptr->data();
+
+    BN_PROFILER_START("lz4_regular");
+
+    bn::hw::decompress::lz4(tiles, buffer);
+
+    BN_PROFILER_STOP();
+}
+
+void rans_decomp_test()
+{
+    const bn::tile* tiles = bn::regular_bg_items::butano_huge_rans.tiles_item().tiles_ref().data();
+    bn::unique_ptr<bn::array<uint8_t, 64 * 1024>> buffer_ptr(new bn::array<uint8_t, 64 * 1024>());
+    uint8_t* buffer = buffer_ptr->data();
+
+    BN_PROFILER_START("rans_regular");
+
+    bn::hw::decompress::rans(tiles, buffer);
+
+    BN_PROFILER_STOP();
+}
+
+void decomp_round_trip_test()
+{
+    const bn::regular_bg_tiles_item& lz77_tiles_item = bn::regular_bg_items::butano_huge_lz77.tiles_item();
+    const bn::tile* lz77_tiles = lz77_tiles_item.tiles_ref().data();
+    const bn::tile* lz4_tiles = bn::regular_bg_items::butano_huge_lz4.tiles_item().tiles_ref().data();
+    const bn::tile* rans_tiles = bn::regular_bg_items::butano_huge_rans.tiles_item().tiles_ref().data();
+    int bytes = lz77_tiles_item.tiles_ref().size_bytes();
+    bn::unique_ptr<bn::array<uint8_t, 64 * 1024>> expected_ptr(new bn::array<uint8_t, 64 * 1024>());
+    bn::unique_ptr<bn::array<uint8_t, 64 * 1024>> buffer_ptr(new bn::array<uint8_t, 64 * 1024>());
+    uint8_t* expected = expected_ptr->data();
+    uint8_t* buffer = buffer_ptr->data();
+
+    // LZ4 and rANS tiles are compressed by butano_graphics_tool.py, so they're checked against BIOS LZ77 output:
+    bn::hw::decompress::lz77(lz77_tiles, expected);
+
+    bn::hw::decompress::lz4(lz4_tiles, buffer);
+    BN_ASSERT(bn::equal(expected, expected + bytes, buffer), "LZ4 round trip failed");
+
+    bn::hw::decompress::rans(rans_tiles, buffer);
+    BN_ASSERT(bn::equal(expected, expected + bytes, buffer), "rANS round trip failed");
+}
+
+void palette_effects_test()
+{
+    constexpr int colors_count = bn::hw::palettes::colors() * 2;
+    bn::unique_ptr<bn::array<bn::color, colors_count>> colors_ptr(new bn::array<bn::color, colors_count>());
+    bn::color* colors = colors_ptr->data();
+    bn::random random;
+
+    for(int index = 0; index < colors_count; ++index)
+    {
+        colors[index] = bn::color(random.get_int(32), random.get_int(32), random.get_int(32));
+    }
+
+    BN_PROFILER_START("pal_bci_per_color");
+
+    for(int i = 0; i < its_sqrt; ++i)
+    {
+        int value = (i % 32) + 1;
+        bn::hw::palettes::brightness(colors, value, colors_count, colors);
+        bn::hw::palettes::contrast(colors, value, colors_count, colors);
+        bn::hw::palettes::intensity(colors, value, colors_count, colors);
+    }
+
+    BN_PROFILER_STOP();
+
+    BN_PROFILER_START("pal_bci_lut");
+
+    for(int i = 0; i < its_sqrt; ++i)
+    {
+        int value = (i % 32) + 1;
+        unsigned lut[bn::hw::palettes::lut_size()];
+        bn::hw::palettes::build_lut(value, value, value, false, lut);
+        bn::hw::palettes::aligned_lut_effect(colors, lut, colors_count, colors);
+    }
+
+    BN_PROFILER_STOP();
+
+    BN_PROFILER_START("pal_grayscale_regular");
+
+    for(int i = 0; i < its_sqrt; ++i)
+    {
+        bn::hw::palettes::grayscale(colors, 32, colors_count, colors);
+    }
+
+    BN_PROFILER_STOP();
+
+    BN_PROFILER_START("pal_grayscale_aligned");
+
+    for(int i = 0; i < its_sqrt; ++i)
+    {
+        bn::hw::palettes::aligned_grayscale(colors, 32, colors_count, colors);
+    }
+
+    BN_PROFILER_STOP();
+
+    BN_PROFILER_START("pal_hue_shift_same");
+
+    for(int i = 0; i < its_sqrt; ++i)
+    {
+        bn::hw::palettes::hue_shift(colors, 16, colors_count, colors);
+    }
+
+    BN_PROFILER_STOP();
+
+    BN_PROFILER_START("pal_hue_shift_changing");
+
+    for(int i = 0; i < its_sqrt; ++i)
+    {
+        bn::hw::palettes::hue_shift(colors, (i % 32) + 1, colors_count, colors);
+    }
+
+    BN_PROFILER_STOP();
 }
 
 }
@@ -571,10 +783,15 @@ int main()
     lut_sin_test(integer);
     atan2_test(integer);
     coroutine_test(integer);
+    alloc_test(integer);
     copy_words_test();
     rl_decomp_test();
     lz77_decomp_test();
     huff_decomp_test();
+    lz4_decomp_test();
+    rans_decomp_test();
+    decomp_round_trip_test();
+    palette_effects_test();
 
     if(integer)
     {
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2020-2026 Gustavo Valiente gustavo.valiente@protonmail.com
+ * zlib License, see LICENSE file.
+ */
+
+#include "bn_core.h"
+#include "bn_array.h"
+#include "bn_colors.h"
+#include "bn_display.h"
+#include "bn_config_hbes.h"
+#include "bn_sprite_text_generator.h"
+#include "bn_bg_palettes_transparent_color_hbe_ptr.h"
+
+#include "../../butano/hw/include/bn_hw_tonc.h"
+
+#include "common_info.h"
+#include "common_variable_8x16_sprite_font.h"
+
+#if ! BN_CFG_HBES_MAX_SPARSE_LINES
+    static_assert(false, "Enable sparse H-Blank effects schedules in the Makefile to run this test");
+#endif
+
+namespace
+{
+    constexpr int bands_count = 4;
+    constexpr int band_height = bn::display::height() / bands_count;
+
+    constexpr bn::color band_colors[bands_count] = {
+        bn::colors::red, bn::colors::green, bn::colors::blue, bn::colors::yellow
+    };
+
+    [[nodiscard]] bool sparse_schedule_enabled()
+    {
+        return REG_IE & IRQ_VCOUNT;
+    }
+
+    [[nodiscard]] bn::color hw_transparent_color(int line)
+    {
+        while(REG_VCOUNT != line)
+        {
+        }
+
+        return bn::color(*reinterpret_cast<volatile uint16_t*>(MEM_PAL_BG));
+    }
+
+    // The middle line of each band is read while it's being drawn:
+    void check_colors(const bn::span<const bn::color>& colors)
+    {
+        for(int frame = 0; frame < 4; ++frame)
+        {
+            bn::core::update();
+
+            for(int band = 0; band < bands_count; ++band)
+            {
+                int line = (band * band_height) + (band_height / 2);
+                bn::color color = hw_transparent_color(line);
+                BN_ASSERT(color == colors[line], "Invalid color: ", line, " - ", color.data(), " - ",
+                          colors[line].data());
+            }
+        }
+    }
+}
+
+int main()
+{
+    bn::core::init();
+
+    bn::array<bn::color, bn::display::height()> transparent_colors;
+
+    for(int index = 0; index < bn::display::height(); ++index)
+    {
+        transparent_colors[index] = band_colors[index / band_height];
+    }
+
+    bn::bg_palettes_transparent_color_hbe_ptr transparent_color_hbe =
+            bn::bg_palettes_transparent_color_hbe_ptr::create(transparent_colors);
+
+    // Values change in a few lines only, so they are committed with a sparse schedule:
+    check_colors(transparent_colors);
+    BN_ASSERT(sparse_schedule_enabled(), "Sparse schedule not enabled");
+
+    for(int index = 0; index < bn::display::height(); ++index)
+    {
+        int value = index % 32;
+        transparent_colors[index] = bn::color(value, 0, 31 - value);
+    }
+
+    // Values change in too many lines, so they are committed in every H-Blank:
+    transparent_color_hbe.reload_colors_ref();
+    check_colors(transparent_colors);
+    BN_ASSERT(! sparse_schedule_enabled(), "Sparse schedule enabled");
+
+    for(int index = 0; index < bn::display::height(); ++index)
+    {
+        transparent_colors[index] = band_colors[index / band_height];
+    }
+
+    transparent_color_hbe.reload_colors_ref();
+    check_colors(transparent_colors);
+    BN_ASSERT(sparse_schedule_enabled(), "Sparse schedule not enabled again");
+
+    bn::sprite_text_generator text_generator(common::variable_8x16_sprite_font);
+
+    constexpr bn::string_view info_text_lines[] = {
+        "Transparent color bands are",
+        "committed with V-Count and",
+        "one-shot H-Blank interrupts",
+        "",
+        "Sparse H-Blank effects test passed",
+    };
+
+    common::info info("Sparse H-Blank effects test", info_text_lines, text_generator);
+    info.set_show_always(true);
+
+    while(true)
+    {
+        bn::core::update();
+    }
+}